@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+// Little helpers for the plugin's own binary files (database exports, Logger recordings): values are written as they
+// are in memory, strings as a uint32 length followed by the characters, and a file or block starts with a 4 byte magic.
+namespace S2Plugin
+{
+    template <typename T> void writeValue(std::ofstream& fp, T value)
+    {
+        fp.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void writeString(std::ofstream& fp, const std::string& s)
+    {
+        writeValue<uint32_t>(fp, static_cast<uint32_t>(s.size()));
+        fp.write(s.data(), s.size());
+    }
+
+    template <typename T> bool readValue(std::ifstream& fp, T& value)
+    {
+        return static_cast<bool>(fp.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    // strings longer than 64K are taken as a sign of a corrupt file
+    inline bool readString(std::ifstream& fp, std::string& s)
+    {
+        uint32_t length = 0;
+        if (!readValue(fp, length) || length > 0xFFFF)
+        {
+            return false;
+        }
+        s.resize(length);
+        return static_cast<bool>(fp.read(s.data(), length));
+    }
+
+    inline bool readMagic(std::ifstream& fp, const char (&expected)[4])
+    {
+        char magic[4];
+        return fp.read(magic, sizeof(magic)) && std::memcmp(magic, expected, sizeof(magic)) == 0;
+    }
+} // namespace S2Plugin
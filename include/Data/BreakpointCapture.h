@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QObject>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct CaptureRegion
+    {
+        std::string name;
+        size_t address;
+        size_t size;
+    };
+
+    struct CaptureSnapshot
+    {
+        uint64_t hit;    // the number of the breakpoint hit this was taken at
+        uint32_t frame;  // the game frame (State.time_startup), 0 if unknown
+        uint32_t microseconds; // time spent reading the regions
+        std::vector<uint8_t> data; // the regions, back to back
+    };
+
+    // Captures a set of memory regions every time the game executes a chosen address, instead of polling. The
+    // breakpoint is set up to never pause the debugger: x64dbg runs the plugin's capture command on a hit (while
+    // the game is halted) and resumes right after it, so no value is missed between polls and nothing is read
+    // when the code doesn't run.
+    // Every hit costs a debug exception round trip plus the reads, so both the hit rate and the time spent reading
+    // are bounded per second; once either goes over, captures stop and overBudget() is set, the view then disarms.
+    class BreakpointCapture : public QObject
+    {
+        Q_OBJECT
+      public:
+        explicit BreakpointCapture(QObject* parent = nullptr);
+        ~BreakpointCapture();
+
+        void setRegions(const std::vector<CaptureRegion>& regions);
+        const std::vector<CaptureRegion>& regions() const noexcept;
+        // hits beyond maxHitsPerSecond, or after maxCaptureTimePerSecond was spent reading, trip the budget
+        void setBudget(uint32_t maxHitsPerSecond, std::chrono::milliseconds maxCaptureTimePerSecond);
+        // frameCounterAddress may be 0, captureCondition is an x64dbg expression (e.g. rcx==0x1234), empty to
+        // capture on every hit
+        bool arm(size_t address, bool hardware, const std::string& captureCondition, size_t frameCounterAddress, std::string& error);
+        void disarm();
+        bool isArmed() const noexcept;
+        bool overBudget() const noexcept;
+
+        // moves the snapshots captured since the last call into snapshots
+        void takeSnapshots(std::vector<CaptureSnapshot>& snapshots);
+
+        uint64_t hitCount() const;
+        uint64_t captureCount() const;
+        uint64_t droppedCount() const; // captured, but not taken in time
+        uint32_t maxCaptureMicroseconds() const;
+        uint32_t averageCaptureMicroseconds() const;
+        uint32_t hitsLastSecond() const;
+
+        // called by x64dbg on the debug thread, for the command set on the breakpoint
+        static bool captureCommand(int argc, char** argv);
+        static constexpr const char* msCommandName = "S2Capture";
+        static constexpr size_t msMaxPendingSnapshots = 10000;
+
+      signals:
+        void snapshotsCaptured();
+
+      private slots:
+        void deliverSnapshots();
+
+      private:
+        // the capture the command is for; held while a hit is captured, so a capture can't go away halfway
+        static std::mutex msArmedMutex;
+        static BreakpointCapture* msArmed;
+
+        std::vector<CaptureRegion> mRegions;
+        size_t mAddress = 0;
+        bool mHardware = false;
+        size_t mFrameCounterAddress = 0;
+        uint32_t mMaxHitsPerSecond = 1000;
+        std::chrono::microseconds mMaxCaptureTimePerSecond{50000};
+
+        // touched by the debug thread, under mMutex; the statistics getters lock it as well
+        mutable std::mutex mMutex;
+        std::vector<CaptureSnapshot> mPending;
+        uint64_t mHits = 0;
+        uint64_t mCaptures = 0;
+        uint64_t mDropped = 0;
+        uint64_t mTotalCaptureMicroseconds = 0;
+        uint32_t mMaxCaptureMicroseconds = 0;
+        std::chrono::steady_clock::time_point mWindowStart;
+        uint32_t mWindowHits = 0;
+        uint32_t mLastWindowHits = 0;
+        std::chrono::microseconds mWindowCaptureTime{0};
+        std::atomic<bool> mOverBudget{false};
+        std::atomic<bool> mDeliveryPending{false};
+
+        void capture();
+        bool execute(const std::string& command, std::string& error);
+    };
+} // namespace S2Plugin
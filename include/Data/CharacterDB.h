@@ -19,6 +19,7 @@ namespace S2Plugin
         uint8_t charactersCount() const noexcept;
 
         std::unordered_map<std::string, size_t>& offsetsForIndex(uint8_t characterIndex);
+        DatabaseTableLayout tableLayout() const noexcept;
         const std::unordered_map<uint8_t, QString>& characterNames() const noexcept;
         QStringList characterNamesStringList() const noexcept;
 
@@ -26,6 +27,7 @@ namespace S2Plugin
 
       private:
         size_t mCharactersPtr = 0;
+        static constexpr size_t msCharacterSize = 0x2C;
         std::unordered_map<uint8_t, std::unordered_map<std::string, size_t>> mMemoryOffsets; // map of character id -> ( fieldname -> offset ) of field value in memory
         std::unordered_map<uint8_t, QString> mCharacterNames;
         QStringList mCharacterNamesStringList;
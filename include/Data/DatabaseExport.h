@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Export files hold one database table (EntityDB, ParticleDB, ...) as columns: a header describing the columns,
+// followed by every column as one contiguous array of fixed size values (one per entry). There are no dependencies on
+// Qt or x64dbg in here, so the offline diff tool can use it as well.
+namespace S2Plugin
+{
+    enum class ExportColumnKind : uint8_t
+    {
+        Signed,
+        Unsigned,
+        Float,
+        Bool,
+        Hex, // pointers and flags
+    };
+
+    struct ExportColumn
+    {
+        std::string name; // e.g. EntityDB.width
+        ExportColumnKind kind;
+        uint32_t offset; // in the database entry
+        uint8_t size;
+    };
+
+    // Writes an export while the table is being read, a chunk of entries at a time, so the size of the table doesn't
+    // matter. The column regions are laid out up front, each chunk is scattered into them and (optionally) appended to
+    // a CSV file as rows.
+    class DatabaseExportWriter
+    {
+      public:
+        // csvPath may be empty
+        bool open(const std::string& path, const std::string& csvPath, const std::string& tableName, size_t entryCount, size_t entrySize, const std::vector<ExportColumn>& columns);
+        // count entries of entrySize bytes, back to back, starting at entry firstEntry of the table
+        bool writeEntries(size_t firstEntry, const uint8_t* entries, size_t count);
+        bool close();
+        const std::string& error() const noexcept;
+
+      private:
+        std::ofstream mFile;
+        std::ofstream mCSV;
+        std::string mError;
+        std::vector<ExportColumn> mColumns;
+        std::vector<uint64_t> mColumnStart; // file offset of each column
+        std::vector<uint8_t> mColumnChunk;
+        size_t mEntryCount = 0;
+        size_t mEntrySize = 0;
+
+        bool fail(const std::string& error);
+    };
+
+    // An export read back in full, for comparing
+    struct DatabaseExport
+    {
+        std::string tableName;
+        uint64_t entryCount = 0;
+        uint64_t entrySize = 0;
+        std::vector<ExportColumn> columns;
+        std::vector<std::vector<uint8_t>> columnData;
+
+        bool load(const std::string& path, std::string& error);
+        uint64_t rawValue(size_t column, size_t entry) const;
+        std::string formatValue(size_t column, size_t entry) const;
+    };
+
+    std::string formatExportValue(const ExportColumn& column, uint64_t raw);
+
+    // Compares two exports of the same table column by column (matched on name) and reports the entries that changed,
+    // with their old and new values, plus added/removed columns and entries. At most maxChangedEntries entries are listed.
+    std::vector<std::string> diffDatabaseExports(const DatabaseExport& before, const DatabaseExport& after, size_t maxChangedEntries = 1000);
+} // namespace S2Plugin
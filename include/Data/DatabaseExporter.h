@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Data/DatabaseExport.h"
+#include "Data/MemoryMappedData.h"
+#include <string>
+
+namespace S2Plugin
+{
+    struct Configuration;
+    enum class MemoryFieldType;
+
+    // Streams a database table out of the game into an export file: every scalar field of the entry type (as laid out
+    // in Spelunky2.json) becomes a column. The table is read in chunks of msChunkEntries entries, one read per chunk.
+    class DatabaseExporter : public MemoryMappedData
+    {
+      public:
+        explicit DatabaseExporter(Configuration* config);
+
+        // csvPath may be empty
+        bool exportTable(const std::string& tableName, MemoryFieldType entryType, const DatabaseTableLayout& layout, const std::string& path, const std::string& csvPath, std::string& error);
+
+        static ExportColumnKind exportColumnKind(MemoryFieldType type) noexcept;
+
+        static constexpr size_t msChunkEntries = 64;
+
+      private:
+        std::vector<uint8_t> mBuffer;
+    };
+} // namespace S2Plugin
@@ -18,7 +18,7 @@ namespace S2Plugin
     class Entity : public MemoryMappedData
     {
       public:
-        Entity(size_t offset, TreeViewMemoryFields* tree, WidgetMemoryView* memoryView, WidgetMemoryView* comparisonMemoryView, EntityDB* entityDB, Configuration* config);
+        Entity(size_t offset, TreeViewMemoryFields* tree, WidgetMemoryView* memoryView, WidgetMemoryView* comparisonMemoryView, EntityDB* entityDB, State* state, Configuration* config);
 
         void refreshOffsets();
         void refreshValues();
@@ -19,12 +19,29 @@ namespace S2Plugin
         EntityList* entityList() const noexcept;
 
         std::unordered_map<std::string, size_t>& offsetsForIndex(uint32_t entityDBIndex);
+        // the entries are laid out back to back, readEntries gets all of them (highestID + 1) in a single read
+        size_t entrySize() const noexcept;
+        bool readEntries(std::vector<uint8_t>& buffer);
+        size_t offsetInEntry(const std::string& fieldName) const;
+        DatabaseTableLayout tableLayout() const noexcept;
+        // type id and search mask of the EntityDB entry an entity points to (the qword at entity + 8), cached per entry
+        uint32_t typeIDForEntityDBPointer(size_t entityDBPtr);
+        uint32_t searchMaskForEntityDBPointer(size_t entityDBPtr);
 
         void reset();
 
       private:
         size_t mEntityDBPtr = 0;
+        size_t mEntrySize = 0;
         std::unique_ptr<EntityList> mEntityList;
         std::vector<std::unordered_map<std::string, size_t>> mMemoryOffsets; // list of fieldname -> offset of field value in memory
+
+        struct CachedEntry
+        {
+            uint32_t typeID;
+            uint32_t searchMask;
+        };
+        std::unordered_map<size_t, CachedEntry> mCachedEntries; // keyed on EntityDB entry pointer
+        const CachedEntry& cachedEntry(size_t entityDBPtr);
     };
 } // namespace S2Plugin
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct EntityDB;
+    enum class MemoryFieldType;
+
+    // One field of every EntityDB entry as a column. The EntityDB is read in one go and kept, so picking another
+    // field only extracts that field from the copy (a fixed size, strided loop) and groups the entries on its value.
+    class EntityDBComparison
+    {
+      public:
+        explicit EntityDBComparison(EntityDB* entityDB);
+
+        // re-read the EntityDB on the next setField, e.g. after a value was edited
+        void invalidate();
+        // offset relative to the start of an entry; flagIndex >= 0 picks a single bit out of a flags field
+        void setField(size_t offset, size_t size, MemoryFieldType type, int8_t flagIndex = -1);
+        void clear();
+
+        MemoryFieldType type() const noexcept;
+        bool isFlag() const noexcept;
+
+        // one row per valid entity ID
+        size_t rowCount() const noexcept;
+        uint32_t idAt(size_t row) const;
+        uint64_t rawValueAt(size_t row) const;
+        // the rows with the same value, ordered by value
+        const std::vector<std::pair<uint64_t, std::vector<uint32_t>>>& groups() const noexcept;
+
+        std::string formatValue(uint64_t raw) const;
+        double sortValue(uint64_t raw) const;
+
+      private:
+        EntityDB* mEntityDB;
+        std::vector<uint8_t> mEntries;
+        bool mEntriesValid = false;
+
+        MemoryFieldType mType;
+        size_t mSize = 0;
+        bool mIsFlag = false;
+
+        std::vector<uint32_t> mIDs;
+        std::vector<uint64_t> mValues; // indexed on entity ID, not on row
+        std::vector<std::pair<uint64_t, std::vector<uint32_t>>> mGroups;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Data/MemoryMappedData.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct Configuration;
+    struct EntityDB;
+    struct State;
+
+    enum class EntityGridLayer
+    {
+        Front,
+        Back,
+        Both
+    };
+
+    // Column oriented snapshot of a set of entities: every refresh reads the row set (a layer, one of its mask
+    // lists or a list of UIDs) and then does a single read per entity, covering the header and all columns.
+    class EntityGrid : public MemoryMappedData
+    {
+      public:
+        EntityGrid(Configuration* config, State* state, EntityDB* entityDB);
+
+        const std::vector<EntityScalarField>& columns() const noexcept;
+        void addColumn(const EntityScalarField& column);
+        void removeColumn(size_t index);
+
+        void setSource(EntityGridLayer layer, uint32_t mask, const std::vector<uint32_t>& uids);
+
+        // returns true when the rows are the same entities in the same order as before the refresh
+        bool refresh();
+
+        size_t rowCount() const noexcept;
+        size_t entityAt(size_t row) const;
+        uint32_t uidAt(size_t row) const;
+        uint32_t typeIDAt(size_t row) const;
+        std::string nameAt(size_t row) const;
+        uint64_t rawValue(size_t row, size_t column) const;
+
+      private:
+        State* mState;
+        EntityDB* mEntityDB;
+
+        EntityGridLayer mLayer = EntityGridLayer::Front;
+        uint32_t mMask = 0; // 0 = every entity of the layer
+        std::vector<uint32_t> mUIDs;
+        std::vector<EntityScalarField> mColumns;
+
+        std::vector<size_t> mEntities;
+        std::vector<uint32_t> mEntityUIDs;
+        std::vector<uint32_t> mEntityTypeIDs;
+        std::vector<std::vector<uint64_t>> mColumnValues; // [column][row]
+
+        std::vector<size_t> acquireEntities() const;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    enum class HeatmapLayerKind
+    {
+        All,
+        TypeID,
+        Mask, // all bits of the mask set in the entity's search mask
+    };
+
+    struct HeatmapLayer
+    {
+        HeatmapLayerKind kind;
+        uint32_t value;
+    };
+
+    // Counts, per tile, how often an entity was there over a recording window, one grid of counters per layer. The
+    // entities are acquired and binned on a worker thread once per game frame: the entity list is read in one go,
+    // the entities are sorted on address and read in spans covering many entities each (they're allocated from
+    // pools), so a frame with thousands of entities costs tens of reads instead of thousands. If a span can't be read,
+    // e.g. because it crosses a page that isn't mapped, its entities are read one by one instead.
+    class EntityHeatmap
+    {
+      public:
+        EntityHeatmap() = default;
+        ~EntityHeatmap();
+
+        // layerPointerAddress is where the pointer to the level layer lives (the State's layer0 or layer1 field)
+        void start(size_t layerPointerAddress, const std::vector<HeatmapLayer>& layers);
+        void stop();
+        bool isRunning() const noexcept;
+        void clear();
+        // wakes the worker for one accumulation; if it's still busy with the previous frame, the frame is missed
+        void frameAdvanced();
+
+        // the cells of a layer that changed since the last call, as (cell index, count), and the highest count
+        // of the layer; cell index = (y * msWidth) + x with y going up
+        uint32_t takeChangedCells(size_t layer, std::vector<std::pair<uint32_t, uint32_t>>& cells);
+        // makes the next takeChangedCells return every cell with a count, for drawing a layer from scratch
+        void markAllChanged(size_t layer);
+
+        uint64_t accumulatedFrameCount() const;
+        uint64_t missedFrameCount() const;
+        std::chrono::microseconds lastAccumulationDuration() const;
+        uint32_t lastReadCount() const;
+        size_t lastEntityCount() const;
+        // spans of the last frame that had to be read entity by entity, and entities that couldn't be read at all
+        uint32_t lastFailedSpanCount() const;
+        uint32_t lastUnreadableEntityCount() const;
+
+        static constexpr int32_t msWidth = 96;
+        static constexpr int32_t msHeight = 128;
+        static constexpr size_t msMaxEntities = 10000;
+        static constexpr size_t msMaxSpanGap = 0x1000;  // entities closer together than this are read in one span
+        static constexpr size_t msMaxSpanSize = 0x40000; // but spans don't grow beyond this
+        static constexpr size_t msHeaderSize = 0x50;
+
+      private:
+        struct Grid
+        {
+            HeatmapLayer layer;
+            std::vector<uint32_t> counts;
+            std::vector<uint8_t> changed;
+            std::vector<uint32_t> changedCells;
+            uint32_t maxCount = 0;
+        };
+        struct AcquiredEntity
+        {
+            size_t entity;
+            size_t entityDBPointer;
+            size_t overlay;
+            float x;
+            float y;
+        };
+        struct EntityDBEntry
+        {
+            uint32_t typeID;
+            uint32_t searchMask;
+        };
+
+        std::thread mWorker;
+        mutable std::mutex mMutex; // guards everything below
+        std::condition_variable mWakeUp;
+        bool mRunning = false;
+        bool mFramePending = false;
+        size_t mLayerPointerAddress = 0;
+        std::vector<Grid> mGrids;
+        uint64_t mAccumulatedFrames = 0;
+        uint64_t mMissedFrames = 0;
+        std::chrono::microseconds mLastAccumulationDuration{0};
+        uint32_t mLastReadCount = 0;
+        size_t mLastEntityCount = 0;
+        uint32_t mLastFailedSpanCount = 0;
+        uint32_t mLastUnreadableEntityCount = 0;
+
+        // only touched by the worker
+        uint32_t mFailedSpans = 0;
+        uint32_t mUnreadableEntities = 0;
+        std::vector<size_t> mEntityPointers;
+        std::vector<uint8_t> mSpan;
+        std::vector<AcquiredEntity> mAcquired;
+        std::unordered_map<size_t, size_t> mAcquiredIndex; // entity -> index in mAcquired
+        std::unordered_map<size_t, EntityDBEntry> mEntityDBEntries;
+        std::vector<std::pair<uint32_t, EntityDBEntry>> mBinned; // cell, entity's type and mask
+
+        void markCountedCellsChanged(Grid& grid);
+        void run();
+        void accumulate();
+        uint32_t acquire();
+        void addAcquired(size_t entity, const uint8_t* header);
+        EntityDBEntry entityDBEntry(size_t entityDBPointer);
+    };
+} // namespace S2Plugin
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "Data/ExpressionScanner.h"
+#include "Data/MemoryMappedData.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct Configuration;
+    struct EntityDB;
+    class State;
+
+    // Filters entities on an expression over their fields, e.g. Movable.health < 3 && distance < 10 && layer == 0
+    //
+    // Operands: numbers (decimal or hex starting with 0x), entity fields as <class>.<field> (resolved against the class
+    // layouts, entities that aren't of that class never match), uid, type, mask, layer, x, y, distance (in tiles, to
+    // player 1), is(<class>) and name("<part of the entity name>").
+    // Operators, from loosest to tightest: || && ! (< <= > >= == !=) (+ -) (* /) & and unary -
+    //
+    // The expression is compiled once into a flat list of stack instructions, which then runs over a snapshot of
+    // the entities that is taken with a single read per entity, covering every field the expression uses.
+    class EntityQuery : public MemoryMappedData
+    {
+      public:
+        EntityQuery(Configuration* config, EntityDB* entityDB);
+
+        // returns false, with the reason in error(), if the expression doesn't compile; an empty expression matches
+        // everything, one that failed to compile matches nothing (a typo shouldn't look like an unfiltered list)
+        bool compile(const std::string& expression);
+        const std::string& error() const noexcept;
+        // true if the expression is empty, i.e. evaluating would match every entity
+        bool empty() const noexcept;
+
+        // matches[i] is set to 1 when entities[i] (taken from layer layers[i]) satisfies the expression
+        void evaluate(const std::vector<size_t>& entities, const std::vector<uint8_t>& layers, State* state, std::vector<uint8_t>& matches);
+
+      private:
+        enum class Opcode : uint8_t
+        {
+            Constant,
+            Field,
+            UID,
+            Type,
+            Mask,
+            Layer,
+            X,
+            Y,
+            Distance,
+            TypeIn,
+            Negate,
+            Not,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            BitAnd,
+            Less,
+            LessEqual,
+            Greater,
+            GreaterEqual,
+            Equal,
+            NotEqual,
+            And,
+            Or
+        };
+        enum class FieldKind : uint8_t
+        {
+            Signed,
+            Unsigned,
+            Float
+        };
+        struct Instruction
+        {
+            Opcode opcode;
+            FieldKind kind = FieldKind::Unsigned;
+            uint8_t size = 0;
+            uint32_t offset = 0;
+            uint32_t typeSet = 0; // Field: the class the field belongs to, TypeIn: the set to test against
+            double constant = 0;
+        };
+
+        EntityDB* mEntityDB;
+        std::vector<Instruction> mProgram;
+        std::vector<std::vector<uint8_t>> mTypeSets; // indexed on entity type id
+        size_t mSnapshotSize = 0x50;
+        size_t mMaxStackDepth = 0;
+        bool mUsesPosition = false;
+        std::string mError;
+
+        // compilation state
+        ExpressionScanner mScanner;
+        size_t mStackDepth = 0;
+        std::vector<std::string> mClassOfType;
+        std::unordered_map<std::string, uint32_t> mClassTypeSets;
+        std::unordered_map<std::string, std::vector<EntityScalarField>> mClassFields;
+
+        void parseOr();
+        void parseAnd();
+        void parseNot();
+        void parseComparison();
+        void parseSum();
+        void parseProduct();
+        void parseBitAnd();
+        void parseUnary();
+        void parsePrimary();
+
+        bool accept(const char* token);
+        void expect(const char* token);
+        std::string parseIdentifier();
+        std::string parseString();
+        void emitInstruction(const Instruction& instruction);
+        uint32_t typeSetForClass(const std::string& className);
+        uint32_t typeSetForName(const std::string& namePart);
+    };
+} // namespace S2Plugin
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct EntityDB;
+    class State;
+
+    struct SpatialEntity
+    {
+        size_t entity;
+        uint32_t uid;
+        uint32_t typeID;
+        uint32_t searchMask;
+        float x; // absolute, i.e. with the overlay chain resolved
+        float y;
+    };
+
+    // Uniform grid over the level, one cell per tile, holding the entities of one snapshot. The grid always covers the
+    // largest level (msLevelMaxWidth by msLevelMaxHeight tiles), so a garbage position can't stretch it; entities
+    // outside of it go into a separate overflow list that queries scan as well. The cells are stored as one array
+    // sorted on cell (a counting sort), so a rebuild is two passes over the entities and no allocations once the
+    // buffers have grown to the size of a full level.
+    class EntitySpatialIndex
+    {
+      public:
+        // takes the entity headers from the state's per-frame cache and resolves overlays the same way the
+        // entity windows do, then rebuilds the grid
+        void build(const std::vector<size_t>& entities, State* state, EntityDB* entityDB);
+        void rebuild(const std::vector<SpatialEntity>& entities);
+
+        // the entities inside the level, and those outside of it (or with a position that isn't a number)
+        const std::vector<SpatialEntity>& entities() const noexcept;
+        const std::vector<SpatialEntity>& overflow() const noexcept;
+        void queryRect(float left, float bottom, float right, float top, std::vector<const SpatialEntity*>& result) const;
+        void queryRadius(float x, float y, float radius, std::vector<const SpatialEntity*>& result) const;
+        // nullptr if there's no entity within maxDistance
+        const SpatialEntity* nearest(float x, float y, float maxDistance) const;
+
+        std::chrono::microseconds lastRebuildDuration() const noexcept;
+
+        // the largest level, in tiles; the level view draws the same area
+        static constexpr float msLevelMaxHeight = 125.0;
+        static constexpr float msLevelMaxWidth = 3. + 3. + (8 * 10);
+
+      private:
+        std::vector<SpatialEntity> mEntities; // sorted on cell
+        std::vector<uint32_t> mCellStart;     // mEntities[mCellStart[c]] up to mEntities[mCellStart[c + 1]] are in cell c
+        std::vector<uint32_t> mCellOfEntity;
+        std::vector<SpatialEntity> mOverflow;
+        std::vector<SpatialEntity> mAcquired;
+        std::chrono::microseconds mLastRebuildDuration{0};
+
+        static bool insideGrid(float x, float y) noexcept;
+        static int32_t cellX(float x) noexcept;
+        static int32_t cellY(float y) noexcept;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Data/MemoryMappedData.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct Configuration;
+    struct EntityDB;
+    class State;
+
+    struct WatchedField
+    {
+        uint32_t uid;
+        EntityScalarField field;
+        bool alive = false;       // false if the entity couldn't be found at the last refresh
+        bool classMatches = true; // false if the entity at the uid isn't (or no longer is) of the field's class
+        std::deque<double> history;
+    };
+
+    // A set of (entity UID, field) pairs that are refreshed together. All fields of one entity are read in as few reads as
+    // possible (overlapping or nearby fields share a read), and a refresh stops once its time budget is used up; the next
+    // refresh picks up with the entities that were skipped, so every entity gets its turn.
+    class EntityWatch : public MemoryMappedData
+    {
+      public:
+        EntityWatch(Configuration* config, State* state, EntityDB* entityDB);
+
+        // the entity has to exist and be of the class the field belongs to (or derive from it), otherwise this
+        // returns false with the reason in error
+        bool addField(uint32_t uid, const EntityScalarField& field, std::string& error);
+        void removeField(size_t index);
+        size_t fieldCount() const noexcept;
+        const WatchedField& fieldAt(size_t index) const;
+        std::string entityNameAt(size_t index) const;
+
+        void refresh(std::chrono::microseconds budget);
+
+        // statistics of the last refresh
+        size_t lastRefreshEntityCount() const noexcept;
+        size_t lastRefreshReadCount() const noexcept;
+        std::chrono::microseconds lastRefreshDuration() const noexcept;
+
+        static constexpr size_t msHistoryLength = 100;
+
+      private:
+        struct ReadSpan
+        {
+            size_t offset;
+            size_t size;
+        };
+        struct WatchedEntity
+        {
+            uint32_t uid;
+            size_t entity = 0;
+            uint32_t typeID = 0;
+            std::vector<size_t> fields; // indices into mFields
+            std::vector<ReadSpan> spans;
+        };
+
+        State* mState;
+        EntityDB* mEntityDB;
+        std::vector<WatchedField> mFields;
+        std::vector<WatchedEntity> mEntities;
+        size_t mNextEntity = 0;
+        std::vector<uint8_t> mBuffer;
+        std::unordered_map<uint32_t, std::vector<std::string>> mClassHierarchyOfType;
+
+        size_t mLastRefreshEntityCount = 0;
+        size_t mLastRefreshReadCount = 0;
+        std::chrono::microseconds mLastRefreshDuration{0};
+
+        // fields that are less than this apart are read together, rather than in two reads
+        static constexpr size_t msMaxSpanGap = 64;
+
+        void updateReadPlan();
+        bool entityIsOfClass(uint32_t typeID, const std::string& className);
+    };
+} // namespace S2Plugin
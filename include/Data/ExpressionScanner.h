@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace S2Plugin
+{
+    // The tokens shared by the expression languages (EntityQuery, LoggerExpression): whitespace, fixed tokens, numbers
+    // and names, over a copy of the source. It doesn't report errors itself, each parser does that in its own way.
+    class ExpressionScanner
+    {
+      public:
+        explicit ExpressionScanner(const std::string& source = std::string());
+
+        void skipWhitespace();
+        // at the end of the source, after skipping whitespace
+        bool atEnd();
+        // the next character after skipping whitespace, 0 at the end
+        char peek();
+        // whether token comes next, after skipping whitespace; accept() also consumes it
+        bool peekToken(const char* token);
+        bool accept(const char* token);
+        // decimal, floating point or hexadecimal starting with 0x; false (nothing consumed) if there's no valid number
+        bool number(double& value);
+        // letters and digits, plus any of extraCharacters; empty if there's no name here
+        std::string name(const char* extraCharacters = "");
+        // the text up to close, which is consumed as well; false (nothing consumed) if close never comes
+        bool until(char close, std::string& text);
+
+        const std::string& source() const noexcept;
+        size_t position() const noexcept;
+
+      private:
+        std::string mSource;
+        size_t mPosition = 0;
+    };
+} // namespace S2Plugin
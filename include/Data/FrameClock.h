@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QObject>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace S2Plugin
+{
+    struct State;
+
+    // Polls the game's frame counter (State.time_startup) on a worker thread and signals every new game frame, so
+    // captures happen once per frame instead of on a wall clock timer that drifts against the game. The signal is
+    // delivered on the thread the clock lives on (the UI thread). If that thread is still busy with the previous frame,
+    // the frames in between are coalesced into the next delivery and counted as missed, rather than queueing up stale
+    // frames.
+    // The worker only runs while there are subscribers.
+    class FrameClock : public QObject
+    {
+        Q_OBJECT
+      public:
+        explicit FrameClock(State* state, QObject* parent = nullptr);
+        ~FrameClock();
+
+        // returns false if the State couldn't be loaded, the clock doesn't run in that case
+        bool subscribe();
+        void unsubscribe();
+        bool isRunning() const noexcept;
+        void reset();
+
+        // the frame counter as last seen by the worker
+        uint32_t latestFrame() const noexcept;
+        uint64_t deliveredFrameCount() const noexcept;
+        uint64_t missedFrameCount() const noexcept;
+
+        static constexpr std::chrono::microseconds msPollInterval{1000};
+
+      signals:
+        void frameAdvanced(uint32_t frame);
+
+      private slots:
+        void deliverFrame();
+
+      private:
+        State* mState;
+        size_t mSubscribers = 0;
+
+        std::thread mWorker;
+        std::atomic<bool> mRunning{false};
+        std::atomic<bool> mDeliveryPending{false};
+        std::atomic<uint32_t> mLatestFrame{0};
+
+        bool mDeliveredAny = false;
+        uint32_t mLastDeliveredFrame = 0;
+        uint64_t mDeliveredFrames = 0;
+        uint64_t mMissedFrames = 0;
+
+        void start();
+        void stop();
+        void poll(size_t frameCounterAddress);
+    };
+} // namespace S2Plugin
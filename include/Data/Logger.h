@@ -1,33 +1,81 @@
 #pragma once
 
+#include "Data/LoggerSampleColumn.h"
 #include <QColor>
 #include <QString>
 #include <QTimer>
-#include <any>
+#include <chrono>
+#include <list>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace S2Plugin
 {
     struct ItemModelLoggerFields;
+    struct FrameClock;
+    struct LoggerSampler;
+    class LoggerRecording;
+    class LoggerFieldReader;
+    struct LoggerSession;
+    class State;
     enum class MemoryFieldType;
 
+    enum class LoggerFieldKind : uint8_t
+    {
+        Value,
+        FlagBit,     // one bit of the flags at memoryOffset
+        PointerPath, // memoryOffset holds a pointer, followed through offsets each sample
+        UIDPath,     // memoryOffset holds an entity UID, the entity it points at is followed through offsets each sample
+        Expression,  // computed from the other fields, nothing is read for it
+    };
+
     struct LoggerField
     {
         size_t memoryOffset;
         std::string name;
-        MemoryFieldType type;
+        MemoryFieldType type; // of the value that's logged, or for FlagBit of the flags it's taken from
         QColor color;
         std::string uuid;
+        LoggerFieldKind kind = LoggerFieldKind::Value;
+        uint8_t bit = 0;
+        // for the paths, every offset but the last leads to another pointer, the last one to the value
+        std::vector<size_t> pathOffsets;
+        std::string expression;
+
+        // what the samples are stored as
+        MemoryFieldType columnType() const;
+    };
+
+    enum class LoggerTriggerCondition
+    {
+        RisesAbove,
+        FallsBelow,
+        Changes,
+        Equals, // becomes equal to the value, e.g. a state
+    };
+
+    // With a trigger, the Logger starts armed and only keeps the samples around the moments the condition is met on
+    // one of the fields: the last preTriggerSamples before it, and postTriggerDuration milliseconds after it.
+    struct LoggerTrigger
+    {
+        size_t fieldIndex = 0;
+        LoggerTriggerCondition condition = LoggerTriggerCondition::Changes;
+        double value = 0; // the threshold or state, Changes doesn't use it
+        size_t preTriggerSamples = 0;
+        uint32_t postTriggerDuration = 0; // milliseconds
+        bool rearm = false;               // capture every time until the duration ends, instead of only the first
+
+        // whether the field going from previous to current meets the condition
+        bool fires(double previous, double current) const;
     };
 
     class Logger : public QObject
     {
         Q_OBJECT
       public:
-        explicit Logger(QObject* parent = nullptr);
+        Logger(State* state, FrameClock* frameClock, QObject* parent = nullptr);
+        ~Logger();
 
         void setTableModel(ItemModelLoggerFields* tableModel);
 
@@ -38,26 +86,153 @@ namespace S2Plugin
         void removeFieldAt(size_t fieldIndex);
         void updateFieldColor(size_t fieldIndex, const QColor& newColor);
 
-        const std::vector<std::any>& samplesForField(const std::string& fieldUUID) const;
+        // the samples of a field, in the same order as the fields
+        const LoggerSampleColumn& samplesForField(size_t fieldIndex) const;
         size_t sampleCount() const noexcept;
-        std::pair<int64_t, int64_t> sampleBounds(const LoggerField& field) const;
+        // the game frame a sample was taken in, shared by all fields, 0 if the sample isn't resident
+        uint32_t sampleFrame(size_t index) const;
+        // when a sample was actually taken, in microseconds since the start, 0 if the sample isn't resident
+        uint64_t sampleTime(size_t index) const;
+        std::pair<int64_t, int64_t> sampleBounds(size_t fieldIndex) const;
+
+        // samples every samplePeriod milliseconds on a sampler thread; with a recordingPath the samples are written
+        // to that file in chunks as they come in, instead of all being kept in memory
+        bool start(size_t samplePeriod, size_t duration, const std::string& recordingPath = std::string());
+        // one sample per game frame instead of every samplePeriod milliseconds, fails if there's no frame counter to follow
+        bool startOnFrames(size_t duration, const std::string& recordingPath = std::string());
+        // fields that are at most gap bytes apart are read together, applies to the next start
+        void setSpanGap(size_t gap);
+        // applies to the next start, until cleared
+        void setTrigger(const LoggerTrigger& trigger);
+        void clearTrigger();
+        // the sample each capture's trigger fired on
+        const std::vector<size_t>& triggerSamples() const noexcept;
+
+        // replaces the fields and samples by those of a recording file, the game doesn't need to be running
+        bool openRecording(const std::string& path);
 
-        void start(size_t samplePeriod, size_t duration);
+        // sessions kept in memory to compare with each other, in the order they were added; keeping the current
+        // session copies it (or reads all of its recording back), so logging can go on
+        bool keepSession(const std::string& name);
+        bool addSessionFromRecording(const std::string& path, const std::string& name);
+        void removeSession(size_t index);
+        size_t sessionCount() const noexcept;
+        const LoggerSession& sessionAt(size_t index) const;
+        // makes the samples [first, last) resident by reading their chunks back from the recording; does nothing when
+        // not recording to a file, or when the range is wider than what's kept in memory (callers fall back to the
+        // block bounds of the columns)
+        void pageIn(size_t first, size_t last);
+        // a single sample, resident or not: one that isn't is read from its chunk of the recording, for rows that are
+        // too far apart to page in together; 0 or an invalid QVariant if it can't be read
+        uint32_t readSampleFrame(size_t index);
+        uint64_t readSampleTime(size_t index);
+        QVariant readSampleValue(size_t fieldIndex, size_t index);
+        // why the last start or recording operation failed
+        const std::string& error() const noexcept;
+        // frames that went by without a sample while sampling per game frame
+        uint64_t missedFrameCount() const noexcept;
+        // sampler ticks that came too late to be taken, and samples the sampler had to throw away because they
+        // weren't picked up in time, while sampling on a period
+        uint64_t overrunCount() const noexcept;
+        uint64_t droppedSampleCount() const noexcept;
+        // the block reads each sample takes for the fields that sit directly in memory
+        size_t readsPerSample() const noexcept;
+        // the samples per second reading the fields would allow, going by how long the reads took, 0 before sampling
+        double maxSampleRate() const noexcept;
 
       signals:
         void samplingEnded();
         void fieldsChanged();
+        void sessionsChanged();
 
       private slots:
-        void sample();
+        void drainSamples();
+        void frameAdvanced(uint32_t frame);
         void durationEnded();
 
       private:
         std::vector<LoggerField> mFields;
         ItemModelLoggerFields* mTableModel = nullptr;
+        State* mState;
+        FrameClock* mFrameClock;
+        bool mFrameClockSubscribed = false;
+        uint64_t mMissedFramesAtStart = 0;
 
-        std::unique_ptr<QTimer> mSampleTimer;
+        std::unique_ptr<LoggerFieldReader> mReader; // for sampling per game frame, the sampler has its own
+        std::unique_ptr<LoggerSampler> mSampler;
+        std::unique_ptr<QTimer> mDrainTimer;
         std::unique_ptr<QTimer> mDurationTimer;
-        std::unordered_map<std::string, std::vector<std::any>> mSamples; // field uuid -> value
+        uint64_t mOverruns = 0;
+        uint64_t mDropped = 0;
+        size_t mSpanGap;
+        uint64_t mReadNanoseconds = 0;
+        uint64_t mReadCount = 0;
+        std::chrono::steady_clock::time_point mStartTime;
+        std::vector<LoggerSampleColumn> mSamples; // one column per field
+        std::vector<uint32_t> mSampleFrames;      // resident, like the columns
+        std::vector<uint64_t> mSampleTimes;
+        size_t mSampleCount = 0;
+        size_t mResidentFirst = 0;
+
+        std::unique_ptr<LoggerRecording> mRecording;
+        bool mRecordingWritten = false; // finished, chunks can be read back
+        size_t mFlushedCount = 0;
+        std::vector<uint8_t> mChunkBuffer;
+        // the chunks read back last, most recent first, so paging the same chunks in again doesn't decompress them again
+        std::list<std::pair<size_t, std::vector<uint8_t>>> mDecodedChunks;
+        size_t mDecodedChunksSize = 0; // bytes
+        std::string mError;
+
+        enum class TriggerState
+        {
+            Off,
+            Armed,
+            Capturing,
+            Done,
+        };
+        LoggerTrigger mTrigger;
+        bool mTriggerEnabled = false;
+        TriggerState mTriggerState = TriggerState::Off;
+        bool mHasPreviousTriggerValue = false;
+        double mPreviousTriggerValue = 0;
+        uint64_t mCaptureEnd = 0;         // the sample time the current capture ends at
+        std::vector<uint8_t> mPreTrigger; // a ring of the last preTriggerSamples records: frame, time and values
+        size_t mPreTriggerNext = 0;
+        size_t mPreTriggerCount = 0;
+        std::vector<size_t> mTriggerSamples;
+
+        std::vector<std::unique_ptr<LoggerSession>> mSessions;
+
+        // where each field's value is in a record of values, laid out like the sampler does
+        std::vector<size_t> mValueOffsets;
+        size_t mValuesSize = 0;
+        std::vector<uint8_t> mValueBuffer;
+
+        void clearSamples();
+        bool beginSession(const std::string& recordingPath);
+        void startDuration(size_t duration);
+        void captureSample(uint32_t frame);
+        void takeSamplerSamples();
+        // every sample taken passes here, the trigger decides whether it's kept
+        void takeSample(uint32_t frame, uint64_t time, const uint8_t* values);
+        void appendSample(uint32_t frame, uint64_t time, const uint8_t* values);
+        void flushChunks(bool final);
+        void evictBefore(size_t index);
+        bool loadChunks(size_t firstChunk, size_t lastChunk);
+        // into mChunkBuffer, checked against the fields
+        bool readChunk(size_t chunkIndex);
+        size_t chunkDataSize(size_t sampleCount) const;
+        // through the decoded chunks, nullptr if the chunk can't be read; only valid until the next call
+        const std::vector<uint8_t>* decodedChunk(size_t chunkIndex);
+        // the decoded chunk that holds a sample that isn't resident, and where the sample is in it
+        const uint8_t* decodedChunkOfSample(size_t index, size_t& offset, size_t& count);
+
+        static constexpr int msDrainInterval = 50; // milliseconds
+        // samples per chunk of a recording, a multiple of the block size of the columns
+        static constexpr size_t msChunkSize = 8192;
+        // the most chunks read back into memory at once
+        static constexpr size_t msResidentChunks = 8;
+        // the most decoded chunk data kept around, at least the last chunk is always kept
+        static constexpr size_t msDecodedChunksSize = 32 * 1024 * 1024;
     };
 } // namespace S2Plugin
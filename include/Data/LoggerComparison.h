@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Data/Logger.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct LoggerSession;
+
+    enum class LoggerAlignment
+    {
+        FirstSample, // frame 0 is the frame each session started in
+        Trigger,     // frame 0 is the frame a trigger condition is first met in each session
+    };
+
+    // How a session compares to the reference session, over the frames both have a value for
+    struct LoggerComparisonMetrics
+    {
+        size_t frameCount = 0;
+        double meanAbsoluteDifference = 0;
+        double maxAbsoluteDifference = 0;
+        double rmsDifference = 0;
+        double correlation = 0; // Pearson, NaN when either side doesn't vary
+    };
+
+    // Lines up one field across several sessions by game frame, so runs can be overlaid and measured against each
+    // other. Every session's samples are resampled to one value per aligned frame: the last sample taken at or before
+    // that frame, so sessions taken at different periods (or per frame) still line up frame by frame. The first
+    // session is the reference the metrics of the others are computed against.
+    class LoggerComparison
+    {
+      public:
+        // for Trigger alignment, trigger is evaluated on the field called triggerFieldName in each session, its
+        // fieldIndex isn't used; sessions in which it never fires fall back to their first sample
+        void update(const std::vector<const LoggerSession*>& sessions, const std::string& fieldName, LoggerAlignment alignment, const LoggerTrigger& trigger,
+                    const std::string& triggerFieldName);
+        void clear();
+
+        size_t sessionCount() const noexcept;
+        // the aligned frame of the first value of every series, can be negative with Trigger alignment
+        int64_t firstFrame() const noexcept;
+        size_t frameCount() const noexcept;
+        // one value per frame from firstFrame() on, NaN where the session has no value (or not the field at all)
+        const std::vector<double>& series(size_t sessionIndex) const;
+        // the game frame a session's aligned frame 0 is at
+        int64_t origin(size_t sessionIndex) const;
+        bool triggerFound(size_t sessionIndex) const;
+        bool hasField(size_t sessionIndex) const;
+        const LoggerComparisonMetrics& metrics(size_t sessionIndex) const;
+        // the lowest and highest value of all series
+        std::pair<double, double> bounds() const noexcept;
+
+        // a day and a half at 60 frames per second, longer comparisons are cut off
+        static constexpr size_t msMaxFrameCount = size_t(1) << 23;
+
+      private:
+        struct ComparedSession
+        {
+            int64_t origin = 0;
+            bool triggerFound = false;
+            bool hasField = false;
+            std::vector<double> series;
+            LoggerComparisonMetrics metrics;
+        };
+        std::vector<ComparedSession> mSessions;
+        int64_t mFirstFrame = 0;
+        size_t mFrameCount = 0;
+        double mLowest = 0;
+        double mHighest = 0;
+
+        void resample(const LoggerSession& session, size_t fieldIndex, ComparedSession& compared);
+        static LoggerComparisonMetrics measure(const std::vector<double>& reference, const std::vector<double>& series);
+    };
+} // namespace S2Plugin
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace S2Plugin
+{
+    // An arithmetic expression over other logged fields, e.g. hypot({velocityx}, {velocityy}), compiled once into a
+    // small stack program so evaluating it per sample is a loop over a handful of instructions.
+    // Fields are referred to by name in braces; numbers can be decimal, hexadecimal (0x) or floating point; the
+    // operators are + - * / % and unary -, the functions abs, sqrt, floor, min, max, hypot and atan2.
+    class LoggerExpression
+    {
+      public:
+        // fieldNames[x] is what {name} refers to as field x, fields that can't be referred to have an empty name
+        bool compile(const std::string& text, const std::vector<std::string>& fieldNames);
+        // fieldValues holds the value of every field, by index
+        double evaluate(const double* fieldValues) const;
+        const std::string& error() const noexcept;
+
+      private:
+        enum class Op : uint8_t
+        {
+            Constant,
+            Field,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Modulo,
+            Negate,
+            Abs,
+            Sqrt,
+            Floor,
+            Min,
+            Max,
+            Hypot,
+            Atan2,
+        };
+        struct Instruction
+        {
+            Op op;
+            double constant = 0;
+            size_t field = 0;
+        };
+
+        std::vector<Instruction> mProgram;
+        mutable std::vector<double> mStack;
+        std::string mError;
+
+        // the parser's state, it only lives for the duration of compile(), field names are resolved to indices
+        struct Compilation;
+
+        bool parseSum(Compilation& compilation);
+        bool parseProduct(Compilation& compilation);
+        bool parseUnary(Compilation& compilation);
+        bool parsePrimary(Compilation& compilation);
+        bool parseCall(Compilation& compilation, const std::string& name);
+        bool fail(const Compilation& compilation, const std::string& error);
+    };
+} // namespace S2Plugin
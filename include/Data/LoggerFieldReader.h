@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Data/LoggerExpression.h"
+#include "Data/LoggerSampleColumn.h"
+#include "Data/State.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct LoggerField;
+    enum class LoggerFieldKind : uint8_t;
+
+    // Reads one sample of every logged field into a record: the values back to back in field order, each at the
+    // width of its column. Everything that sits directly in memory is read first: fields no further apart than the
+    // span gap share a span, and every span is a single read. Then the bits are picked out, the pointer and UID paths
+    // followed and the expressions evaluated over the values just read.
+    // Only reads memory, so the sampler thread keeps a copy of its own.
+    class LoggerFieldReader
+    {
+      public:
+        // layerAddresses: where the pointers to both layers are kept, for finding the entity of a UID
+        bool initialize(const std::vector<LoggerField>& fields, size_t layer0Address, size_t layer1Address, size_t maxSpanGap = msDefaultSpanGap);
+        const std::string& error() const noexcept;
+
+        size_t valuesSize() const noexcept;
+        size_t valueOffset(size_t fieldIndex) const;
+        // the reads of the spans, each sample; following a path takes more
+        size_t spanCount() const noexcept;
+        // values has room for valuesSize() bytes
+        void read(uint8_t* values);
+
+        // reading a few bytes that aren't needed is cheaper than another read
+        static constexpr size_t msDefaultSpanGap = 64;
+
+      private:
+        struct PlannedField
+        {
+            LoggerFieldKind kind;
+            size_t memoryOffset;
+            size_t readSize;     // of what sits at memoryOffset: the value, the flags, a pointer or a UID
+            size_t bufferOffset; // where that is in mSpanBuffer
+            size_t valueSize;
+            size_t valueOffset;
+            uint8_t bit;
+            std::vector<size_t> pathOffsets;
+            LoggerExpression expression;
+            // the entity the UID was last found at
+            uint32_t cachedUID = 0;
+            size_t cachedEntity = 0;
+        };
+
+        std::vector<PlannedField> mFields;
+        std::vector<LoggerSampleColumn> mColumns; // empty, only to read values back as numbers for the expressions
+        std::vector<double> mFieldValues;
+        bool mHasExpressions = false;
+        size_t mValuesSize = 0;
+        size_t mLayerAddresses[2] = {0, 0};
+        std::string mError;
+
+        struct ReadSpan
+        {
+            size_t offset;
+            size_t size;
+            size_t bufferOffset;
+        };
+        std::vector<ReadSpan> mSpans;
+        std::vector<uint8_t> mSpanBuffer; // the spans back to back
+        LayerEntities mLayerEntities; // for looking up UIDs
+
+        void planSpans(size_t maxSpanGap);
+        void readPath(const PlannedField& field, size_t address, uint8_t* value);
+        size_t entityForUID(PlannedField& field, uint32_t uid);
+    };
+} // namespace S2Plugin
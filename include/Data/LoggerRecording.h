@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Recording files hold a Logger session on disk: a header describing the fields, followed by chunks of a fixed number
+// of samples. A chunk holds the frames, the times and then the values of every field as one column each, compressed
+// as a whole with LZ4 (the one that comes with the x64dbg plugin SDK). An index of the chunks closes the file; a
+// recording that was never closed (the debugger went away while recording) is indexed by walking the chunk headers
+// instead.
+namespace S2Plugin
+{
+    struct LoggerField;
+
+    struct LoggerRecordingChunk
+    {
+        uint64_t fileOffset; // of the compressed data
+        uint64_t firstSample;
+        uint32_t sampleCount;
+        uint32_t uncompressedSize;
+        uint32_t compressedSize;
+    };
+
+    class LoggerRecording
+    {
+      public:
+        bool create(const std::string& path, const std::vector<LoggerField>& fields);
+        // data holds sampleCount frames (uint32), sampleCount times (uint64) and then sampleCount values per field
+        bool writeChunk(uint64_t firstSample, uint32_t sampleCount, const std::vector<uint8_t>& data);
+        // writes the index and closes the file, open() it again to read it back
+        bool finish();
+
+        bool open(const std::string& path);
+        const std::vector<LoggerField>& fields() const noexcept;
+        const std::vector<LoggerRecordingChunk>& chunks() const noexcept;
+        uint64_t sampleCount() const noexcept;
+        // decompresses a chunk into the layout writeChunk() took
+        bool readChunk(size_t chunkIndex, std::vector<uint8_t>& data);
+
+        const std::string& path() const noexcept;
+        const std::string& error() const noexcept;
+
+      private:
+        std::ofstream mOut;
+        std::ifstream mIn;
+        std::string mPath;
+        std::string mError;
+        std::vector<LoggerField> mFields;
+        std::vector<LoggerRecordingChunk> mChunks;
+        std::vector<char> mCompressed;
+
+        bool readIndex(uint64_t dataStart);
+        bool fail(const std::string& error);
+    };
+} // namespace S2Plugin
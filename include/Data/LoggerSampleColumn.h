@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Data/MinMaxTree.h"
+#include <QVariant>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace S2Plugin
+{
+    enum class MemoryFieldType;
+
+    // Running aggregates of a column, kept up to date with every sample (Welford's method for the variance)
+    struct LoggerSampleStatistics
+    {
+        uint64_t count = 0;
+        double min = 0;
+        double max = 0;
+        double mean = 0;
+        double m2 = 0; // sum of squared differences from the mean
+
+        double variance() const noexcept
+        {
+            return count > 1 ? m2 / (count - 1) : 0;
+        }
+    };
+
+    // The samples of one logged field, back to back at the field's native width. Readers visit() the typed vector
+    // once and loop over it, instead of converting sample by sample.
+    // When recording to a file, only a window of the samples stays in memory (the resident samples, starting at
+    // residentFirst()); the statistics and the block tree always cover every sample.
+    class LoggerSampleColumn
+    {
+      public:
+        using Storage = std::variant<std::vector<int8_t>, std::vector<uint8_t>, std::vector<int16_t>, std::vector<uint16_t>, std::vector<int32_t>,
+                                     std::vector<uint32_t>, std::vector<int64_t>, std::vector<uint64_t>, std::vector<float>>;
+
+        LoggerSampleColumn() = default;
+        explicit LoggerSampleColumn(MemoryFieldType type);
+
+        // data holds at least valueSize() bytes, in the game's layout; appending expects the resident samples to run
+        // up to the end
+        void appendRaw(const void* data);
+        double valueFromRaw(const void* data) const;
+        void reserve(size_t count);
+        void clear();
+
+        // drops the samples before index from memory, they are still part of the aggregates
+        void evictBefore(size_t index);
+        // drops all samples from memory, the samples restored next start at first
+        void resetResident(size_t first);
+        // appends count samples read back from a recording to the resident ones, without aggregating them again
+        void restoreRaw(const void* data, size_t count);
+        // copies count resident samples starting at first to out, in the game's layout
+        void copyRaw(size_t first, size_t count, void* out) const;
+        size_t residentFirst() const noexcept;
+        bool isResident(size_t first, size_t last) const noexcept;
+
+        // every sample, resident or not
+        size_t size() const noexcept;
+        size_t valueSize() const noexcept;
+        // for display: qlonglong, qulonglong or float, an invalid QVariant if the sample isn't resident
+        QVariant valueAt(size_t index) const;
+        // the same for a sample in the game's layout, e.g. in a chunk read back from a recording
+        QVariant displayFromRaw(const void* data) const;
+        // the lowest and highest sample, floats rounded outwards
+        std::pair<int64_t, int64_t> bounds() const;
+        // the lowest and highest of the samples [first, last), in O(log n); partial blocks that aren't resident are
+        // answered with the bounds of the whole block
+        std::pair<double, double> rangeBounds(size_t first, size_t last) const;
+        const LoggerSampleStatistics& statistics() const noexcept;
+        // the lowest and highest sample of each of `slices` equal slices of [first, last), for drawing a window of
+        // the recording one pixel column per slice; slices wider than a couple of blocks are snapped to whole blocks,
+        // so they're answered from the tree alone
+        void decimate(size_t first, size_t last, size_t slices, std::vector<std::pair<double, double>>& out) const;
+
+        // the resident samples, the first one is sample residentFirst()
+        template <typename F> decltype(auto) visit(F&& f) const
+        {
+            return std::visit(std::forward<F>(f), mStorage);
+        }
+
+        // the segment tree is over blocks of this many samples, partial blocks at the edges of a range are scanned
+        static constexpr size_t msBlockSize = 64;
+
+      private:
+        Storage mStorage;
+        size_t mResidentFirst = 0;
+        LoggerSampleStatistics mStatistics;
+        MinMaxTree mBlockBounds;
+
+        void aggregate(double value);
+    };
+} // namespace S2Plugin
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Data/LoggerFieldReader.h"
+#include "Data/SampleRing.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct FrameClock;
+
+    // Samples a set of fields on its own thread at a fixed period, so the period holds regardless of what the UI thread
+    // is doing. Each tick reads the fields (see LoggerFieldReader) into a record and pushes that onto a ring the UI
+    // thread drains at its own pace.
+    // Ticks are scheduled against the start time, not the previous tick: a late tick doesn't push the later ones back,
+    // and ticks that were missed entirely are skipped and counted as overruns rather than taken in a burst.
+    class LoggerSampler
+    {
+      public:
+        struct RecordHeader
+        {
+            uint64_t microseconds; // since the start, when the sample was actually taken
+            uint32_t frame;        // the game frame, 0 without a frame clock
+            uint32_t reserved;
+        };
+
+        // frameClock may be nullptr
+        LoggerSampler(const LoggerFieldReader& reader, std::chrono::microseconds period, std::chrono::milliseconds duration, const FrameClock* frameClock);
+        ~LoggerSampler();
+
+        void start();
+        void stop();
+        // the duration went by
+        bool finished() const noexcept;
+
+        // UI thread only; calls f(const RecordHeader&, const uint8_t* values) for every new sample, the values are
+        // laid out as LoggerFieldReader::read() does
+        template <typename F> size_t drain(F&& f)
+        {
+            return mRing.drain(
+                [&f](const uint8_t* record)
+                {
+                    RecordHeader header;
+                    std::memcpy(&header, record, sizeof(RecordHeader));
+                    f(header, record + sizeof(RecordHeader));
+                });
+        }
+
+        uint64_t sampleCount() const noexcept;
+        uint64_t overrunCount() const noexcept;
+        uint64_t droppedCount() const noexcept; // the ring was full, the UI thread didn't keep up
+        uint64_t readNanoseconds() const noexcept; // spent reading the fields, over all samples
+
+        static constexpr size_t msRingCapacity = 16384;
+
+      private:
+        LoggerFieldReader mReader;
+        std::chrono::microseconds mPeriod;
+        std::chrono::milliseconds mDuration;
+        const FrameClock* mFrameClock;
+        SampleRing mRing;
+
+        std::thread mWorker;
+        std::atomic<bool> mRunning{false};
+        std::atomic<bool> mFinished{false};
+        std::atomic<uint64_t> mSamples{0};
+        std::atomic<uint64_t> mOverruns{0};
+        std::atomic<uint64_t> mDropped{0};
+        std::atomic<uint64_t> mReadNanoseconds{0};
+
+        void run();
+    };
+} // namespace S2Plugin
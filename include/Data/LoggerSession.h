@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Data/Logger.h"
+#include "Data/LoggerSampleColumn.h"
+#include <QColor>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace S2Plugin
+{
+    // A finished Logger session kept around to compare with others: its fields with every sample in memory, and the
+    // game frames the samples were taken in
+    struct LoggerSession
+    {
+        std::string name;
+        QColor color;
+        std::vector<LoggerField> fields;
+        std::vector<LoggerSampleColumn> columns; // one per field, all samples resident
+        std::vector<uint32_t> frames;
+
+        size_t sampleCount() const noexcept;
+        // the field called fieldName, -1 if the session doesn't have it
+        int64_t fieldIndex(const std::string& fieldName) const;
+        // the game frame a sample was taken in; sessions that were taken without a frame counter count samples instead
+        int64_t frameOf(size_t sample) const;
+
+        // reads every chunk of a recording file back into memory
+        bool loadRecording(const std::string& path, std::string& error);
+    };
+} // namespace S2Plugin
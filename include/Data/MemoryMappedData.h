@@ -3,11 +3,29 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace S2Plugin
 {
     struct Configuration;
     struct MemoryField;
+    enum class MemoryFieldType;
+
+    struct EntityScalarField
+    {
+        std::string name; // e.g. Movable.health
+        MemoryFieldType type;
+        size_t offset; // relative to the start of the entity (or database entry)
+        size_t size;
+    };
+
+    // where the entries of one of the game's databases (EntityDB, ParticleDB, ...) live; the entries are back to back
+    struct DatabaseTableLayout
+    {
+        size_t address = 0;
+        size_t entryCount = 0;
+        size_t entrySize = 0;
+    };
 
     class MemoryMappedData
     {
@@ -19,6 +37,15 @@ namespace S2Plugin
 
         size_t sizeOf(const std::string& typeName);
 
+        // fixed size numeric fields (1, 2, 4 or 8 bytes) that can be compared and sorted by raw value
+        static bool isScalarType(MemoryFieldType type) noexcept;
+
+        // the scalar fields of an entity class and all of its parent classes, named after the class that defines them;
+        // inline structs are flattened, pointers aren't followed
+        std::vector<EntityScalarField> entityScalarFields(const std::string& entityClass);
+        // the same for any list of fields, with offsets counted from the given offset onward
+        void collectScalarFields(const std::vector<MemoryField>& fields, const std::string& prefix, size_t& offset, std::vector<EntityScalarField>& scalarFields);
+
       protected:
         Configuration* mConfiguration;
     };
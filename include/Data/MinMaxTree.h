@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    // A segment tree of the minimum and maximum over a growing row of leaves, answering the min/max of any range of
+    // leaves in O(log n). Leaves are only ever added or widened at the end, the tree doubles its capacity as needed.
+    class MinMaxTree
+    {
+      public:
+        // merges value into a leaf, leaf is at most size()
+        void merge(size_t leaf, double value);
+        void clear();
+        size_t size() const noexcept;
+        // the lowest and highest value of the leaves [first, last), first < last <= size()
+        std::pair<double, double> query(size_t first, size_t last) const;
+
+      private:
+        size_t mCapacity = 0;
+        size_t mSize = 0;
+        std::vector<double> mMin; // node x has children 2x and 2x + 1, the leaves start at mCapacity
+        std::vector<double> mMax;
+
+        void grow();
+    };
+} // namespace S2Plugin
@@ -19,11 +19,13 @@ namespace S2Plugin
         ParticleEmittersList* particleEmittersList() const noexcept;
 
         std::unordered_map<std::string, size_t>& offsetsForIndex(uint32_t particleDBIndex);
+        DatabaseTableLayout tableLayout() const noexcept;
 
         void reset();
 
       private:
         size_t mParticleDBPtr = 0;
+        static constexpr size_t msEntrySize = 0xA0;
         std::unique_ptr<ParticleEmittersList> mParticleEmittersList;
         std::unordered_map<uint16_t, std::unordered_map<std::string, size_t>> mMemoryOffsets; // map of particleDBID -> ( fieldname -> offset ) of field value in memory
     };
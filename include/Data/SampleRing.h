@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace S2Plugin
+{
+    // A fixed size ring of fixed size records, for exactly one producer thread and one consumer thread. Neither side
+    // ever waits for the other: the producer drops a record when the ring is full, the consumer takes whatever is
+    // there when it gets around to it.
+    class SampleRing
+    {
+      public:
+        // capacity is rounded up to a power of two
+        SampleRing(size_t recordSize, size_t capacity) : mRecordSize(recordSize)
+        {
+            size_t rounded = 1;
+            while (rounded < capacity)
+            {
+                rounded <<= 1;
+            }
+            mMask = rounded - 1;
+            mBuffer.resize(rounded * recordSize);
+        }
+
+        // producer only, false if the ring is full
+        bool push(const uint8_t* record)
+        {
+            auto head = mHead.load(std::memory_order_relaxed);
+            if (head - mTail.load(std::memory_order_acquire) > mMask)
+            {
+                return false;
+            }
+            std::memcpy(mBuffer.data() + ((head & mMask) * mRecordSize), record, mRecordSize);
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // consumer only, calls f(const uint8_t* record) for every record pushed since the last drain, oldest first
+        template <typename F> size_t drain(F&& f)
+        {
+            auto tail = mTail.load(std::memory_order_relaxed);
+            auto head = mHead.load(std::memory_order_acquire);
+            for (auto x = tail; x != head; ++x)
+            {
+                f(mBuffer.data() + ((x & mMask) * mRecordSize));
+            }
+            mTail.store(head, std::memory_order_release);
+            return head - tail;
+        }
+
+        size_t recordSize() const noexcept
+        {
+            return mRecordSize;
+        }
+
+        size_t capacity() const noexcept
+        {
+            return mMask + 1;
+        }
+
+      private:
+        std::vector<uint8_t> mBuffer;
+        size_t mRecordSize;
+        size_t mMask;
+        // on separate cache lines, so the two threads don't keep invalidating each other's
+        alignas(64) std::atomic<size_t> mHead{0}; // next record to write, only written by the producer
+        alignas(64) std::atomic<size_t> mTail{0}; // next record to read, only written by the consumer
+    };
+} // namespace S2Plugin
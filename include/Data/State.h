@@ -4,10 +4,42 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace S2Plugin
 {
     struct Configuration;
+    struct EntityDB;
+
+    // the first 0x50 bytes of an entity, decoded
+    struct EntityHeader
+    {
+        size_t vtable = 0;
+        size_t entityDBPointer = 0;
+        size_t overlay = 0;
+        uint32_t typeID = 0;
+        uint32_t searchMask = 0;
+        uint32_t uid = 0;
+        uint8_t layer = 0xFF; // 0xFF if the entity isn't in the entity list of either layer
+        float x = 0;          // relative to the overlay, if any
+        float y = 0;
+    };
+
+    struct EntityUIDLocation
+    {
+        size_t entity = 0;
+        size_t pointerOffset = 0; // the slot in the layer's entity list that points to the entity
+        uint8_t layer = 0;
+    };
+
+    // the entity list of a layer and the uid list that runs parallel to it
+    struct LayerEntities
+    {
+        size_t entityList = 0; // where the entity pointers are
+        std::vector<size_t> entities;
+        std::vector<uint32_t> uids;
+    };
 
     class State : public MemoryMappedData
     {
@@ -24,6 +56,31 @@ namespace S2Plugin
         size_t offsetForField(const std::string& fieldName) const;
 
         size_t findNextEntity(size_t entityOffset);
+        // time_startup, which goes up by one every game frame
+        size_t frameCounterAddress() const;
+
+        // UID lookups go through an index built from bulk reads of both layers' entity and uid arrays. The index is
+        // rebuilt once per game frame (time_startup), so all lookups during a refresh share a single build.
+        // Outside of a refresh pass every lookup checks time_startup; inside one it's read once, when the pass begins.
+        EntityUIDLocation locateEntityByUID(uint32_t uid);
+        uint64_t uidLookupCount() const noexcept;
+        uint64_t uidLookupHitCount() const noexcept;
+        uint64_t uidIndexBuildCount() const noexcept;
+        // both lists of the layer at layer (the value of layer0 or layer1), in one read each; false with empty lists
+        // if there's no layer or it can't be read. Doesn't touch any State, so it's safe from the sampler thread too.
+        static bool readLayerEntities(size_t layer, LayerEntities& out);
+
+        // Entity headers are read (one read of 0x50 bytes) and decoded once per game frame, after that they come from the cache
+        EntityHeader entityHeader(size_t entity, EntityDB* entityDB);
+        std::pair<float, float> entityAbsolutePosition(size_t entity, EntityDB* entityDB);
+
+        // Drops the uid index and the decoded headers. The frame doesn't advance while the game is paused, so this is
+        // needed whenever the plugin itself wrote to memory.
+        void invalidateFrameCache();
+        // A refresh pass starts from an empty cache (a refresh is explicit, so it has to show what changed while paused)
+        // and reads time_startup only once. Passes may nest, only the outermost one counts.
+        void beginRefreshPass();
+        void endRefreshPass();
 
         void reset();
 
@@ -31,5 +88,32 @@ namespace S2Plugin
         size_t mStatePtr = 0;
         uint32_t mHeapOffset = 0;
         std::unordered_map<std::string, size_t> mMemoryOffsets; // fieldname -> offset of field value in memory
+
+        uint32_t mFrame = 0;
+        bool mFrameValid = false;
+        uint32_t mRefreshPassDepth = 0;
+
+        std::unordered_map<uint32_t, EntityUIDLocation> mUIDIndex;
+        bool mUIDIndexValid = false;
+        std::unordered_map<size_t, EntityHeader> mEntityHeaders;
+        uint64_t mUIDLookups = 0;
+        uint64_t mUIDLookupHits = 0;
+        uint64_t mUIDIndexBuilds = 0;
+
+        void updateUIDIndex();
+        void refreshFrame();
+    };
+
+    // Keeps a refresh pass open for as long as it lives
+    class StateRefreshPass
+    {
+      public:
+        explicit StateRefreshPass(State* state);
+        ~StateRefreshPass();
+        StateRefreshPass(const StateRefreshPass&) = delete;
+        StateRefreshPass& operator=(const StateRefreshPass&) = delete;
+
+      private:
+        State* mState;
     };
 } // namespace S2Plugin
@@ -20,10 +20,13 @@ namespace S2Plugin
         std::string nameForID(uint32_t id) const; // id != index !!
         const QStringList& namesStringList() const noexcept;
         size_t count();
+        DatabaseTableLayout tableLayout() const noexcept;
         void reset();
 
       private:
         size_t mTextureDBPtr = 0;
+        size_t mEntryCount = 0;
+        size_t mEntrySize = 0;
         std::unordered_map<uint32_t, std::unordered_map<std::string, size_t>> mMemoryOffsets; // texture id -> (fieldname -> offset of field value in memory)
         std::unordered_map<uint32_t, std::string> mTextureNames;                              // id -> name
         QStringList mTextureNamesStringList;
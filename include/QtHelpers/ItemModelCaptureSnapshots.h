@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Data/BreakpointCapture.h"
+#include <QAbstractItemModel>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace S2Plugin
+{
+    static const uint8_t gsColCaptureHit = 0;
+    static const uint8_t gsColCaptureFrame = 1;
+    static const uint8_t gsColCaptureMicroseconds = 2;
+    static const uint8_t gsColCaptureFirstRegion = 3;
+
+    // the most recent msMaxSnapshots snapshots of a breakpoint capture, one column per region (as hex)
+    class ItemModelCaptureSnapshots : public QAbstractItemModel
+    {
+        Q_OBJECT
+
+      public:
+        explicit ItemModelCaptureSnapshots(QObject* parent = nullptr);
+
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        // clears the snapshots
+        void setRegions(const std::vector<CaptureRegion>& regions);
+        void append(std::vector<CaptureSnapshot>& snapshots);
+
+        static constexpr size_t msMaxSnapshots = 1000;
+        static constexpr size_t msMaxShownBytes = 32; // per region, the tooltip has all of them
+
+      private:
+        std::vector<CaptureRegion> mRegions;
+        std::vector<size_t> mRegionOffsets; // in the snapshot data
+        std::deque<CaptureSnapshot> mSnapshots;
+    };
+} // namespace S2Plugin
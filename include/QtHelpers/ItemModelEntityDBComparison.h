@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    struct EntityDB;
+    struct EntityDBComparison;
+
+    static const uint8_t gsColEntityDBComparisonID = 0;
+    static const uint8_t gsColEntityDBComparisonName = 1;
+    static const uint8_t gsColEntityDBComparisonValue = 2;
+
+    // Shows an EntityDBComparison either as a flat table (ID, name, value) or grouped: one top level row per distinct
+    // value, with the entities that have that value as its children
+    class ItemModelEntityDBComparison : public QAbstractItemModel
+    {
+        Q_OBJECT
+
+      public:
+        ItemModelEntityDBComparison(EntityDB* entityDB, EntityDBComparison* comparison, bool grouped, QObject* parent = nullptr);
+
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        // 0 for the group rows
+        uint32_t entityIDForIndex(const QModelIndex& index) const;
+        void reset();
+
+      private:
+        EntityDB* mEntityDB;
+        EntityDBComparison* mComparison;
+        bool mGrouped;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QSortFilterProxyModel>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    struct EntityGrid;
+
+    static const uint8_t gsColEntityGridUID = 0;
+    static const uint8_t gsColEntityGridName = 1;
+    static const uint8_t gsColEntityGridFirstField = 2;
+
+    class ItemModelEntityGrid : public QAbstractItemModel
+    {
+        Q_OBJECT
+
+      public:
+        ItemModelEntityGrid(EntityGrid* grid, QObject* parent = nullptr);
+
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        // call after EntityGrid::refresh, sameRows is its return value
+        void refreshed(bool sameRows);
+        void reset();
+
+      private:
+        EntityGrid* mEntityGrid;
+    };
+
+    class SortFilterProxyModelEntityGrid : public QSortFilterProxyModel
+    {
+        Q_OBJECT
+
+      public:
+        SortFilterProxyModelEntityGrid(QObject* parent = nullptr);
+
+        bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
+        // numeric columns accept <, <=, >, >=, == and != followed by a number, a bare number means ==
+        // anything else is matched as a case insensitive substring of the displayed value
+        void setFilter(int column, const QString& f);
+
+      private:
+        int mFilterColumn = gsColEntityGridName;
+        QString mFilterString = "";
+        QString mFilterOperator = "";
+        double mFilterValue = 0.;
+        bool mFilterIsNumeric = false;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    struct EntityWatch;
+
+    static const uint8_t gsColEntityWatchUID = 0;
+    static const uint8_t gsColEntityWatchName = 1;
+    static const uint8_t gsColEntityWatchField = 2;
+    static const uint8_t gsColEntityWatchValue = 3;
+    static const uint8_t gsColEntityWatchHistory = 4;
+
+    class ItemModelEntityWatch : public QAbstractItemModel
+    {
+        Q_OBJECT
+
+      public:
+        ItemModelEntityWatch(EntityWatch* watch, QObject* parent = nullptr);
+
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        // call after EntityWatch::refresh
+        void refreshed();
+        void reset();
+
+      private:
+        EntityWatch* mEntityWatch;
+    };
+} // namespace S2Plugin
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    class Logger;
+    class LoggerComparison;
+
+    static constexpr uint8_t gsLogCompColSession = 0;
+    static constexpr uint8_t gsLogCompColSamples = 1;
+    static constexpr uint8_t gsLogCompColAlignedAt = 2;
+    static constexpr uint8_t gsLogCompColFrames = 3;
+    static constexpr uint8_t gsLogCompColMeanDifference = 4;
+    static constexpr uint8_t gsLogCompColMaxDifference = 5;
+    static constexpr uint8_t gsLogCompColRMSDifference = 6;
+    static constexpr uint8_t gsLogCompColCorrelation = 7;
+
+    // One row per kept session, with how the compared field of each measures up against the first session
+    class ItemModelLoggerComparison : public QAbstractItemModel
+    {
+        Q_OBJECT
+      public:
+        ItemModelLoggerComparison(Logger* logger, LoggerComparison* comparison, QObject* parent = nullptr);
+
+        void reset();
+
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+
+      private:
+        Logger* mLogger;
+        LoggerComparison* mComparison;
+    };
+} // namespace S2Plugin
@@ -1,11 +1,27 @@
 #pragma once
 
 #include <QAbstractItemModel>
+#include <cstdint>
+#include <vector>
 
 namespace S2Plugin
 {
     class Logger;
 
+    static constexpr uint8_t gsLogSampleColIndex = 0;
+    static constexpr uint8_t gsLogSampleColFrame = 1;
+    static constexpr uint8_t gsLogSampleColTime = 2;
+    static constexpr uint8_t gsLogSampleColFirstField = 3;
+
+    enum class LoggerSamplesDecimation
+    {
+        All,
+        EveryNth,
+        Changes, // only the samples where any of the fields differs from the sample before
+    };
+
+    // Rows are handed to the view a chunk at a time through canFetchMore/fetchMore, and every cell is read straight
+    // from the typed sample columns, so the length of the recording only matters for how far there is to scroll.
     class ItemModelLoggerSamples : public QAbstractItemModel
     {
         Q_OBJECT
@@ -13,6 +29,9 @@ namespace S2Plugin
         ItemModelLoggerSamples(Logger* logger, QObject* parent = nullptr);
 
         void reset();
+        void setDecimation(LoggerSamplesDecimation decimation, size_t stride);
+        // makes the samples of the rows [firstRow, lastRow] resident in one go, before they're painted
+        void pageInRows(size_t firstRow, size_t lastRow);
 
         Qt::ItemFlags flags(const QModelIndex& index) const override;
         QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
@@ -21,8 +40,25 @@ namespace S2Plugin
         QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
         QModelIndex parent(const QModelIndex& index) const override;
         QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+        bool canFetchMore(const QModelIndex& parent) const override;
+        void fetchMore(const QModelIndex& parent) override;
 
       private:
         Logger* mLogger;
+        LoggerSamplesDecimation mDecimation = LoggerSamplesDecimation::All;
+        size_t mStride = 1;
+        size_t mRowCount = 0;
+        size_t mScanned = 0;                // samples looked at for rows so far
+        std::vector<size_t> mChangedSamples; // the sample of every row, in Changes mode
+
+        size_t sampleForRow(size_t row) const;
+        // appends the samples in [first, last) that differ from the one before them
+        void scanChanges(size_t first, size_t last, std::vector<size_t>& changed);
+
+        static constexpr size_t msFetchSize = 65536; // rows
+        // samples compared per page-in, well within what the Logger keeps in memory of a recording
+        static constexpr size_t msScanSize = 4096;
+        // a fetch in Changes mode stops after looking at this many samples, even if it found fewer rows
+        static constexpr size_t msMaxFetchScan = 1 << 22;
     };
 } // namespace S2Plugin
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <cstdint>
+
+namespace S2Plugin
+{
+    class Logger;
+
+    static constexpr uint8_t gsLogStatColField = 0;
+    static constexpr uint8_t gsLogStatColCount = 1;
+    static constexpr uint8_t gsLogStatColMin = 2;
+    static constexpr uint8_t gsLogStatColMax = 3;
+    static constexpr uint8_t gsLogStatColMean = 4;
+    static constexpr uint8_t gsLogStatColStdDev = 5;
+
+    // One row per logged field, read from the aggregates the sample columns keep, so it costs nothing to show
+    class ItemModelLoggerStatistics : public QAbstractItemModel
+    {
+        Q_OBJECT
+      public:
+        ItemModelLoggerStatistics(Logger* logger, QObject* parent = nullptr);
+
+        void reset();
+
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex parent(const QModelIndex& index) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+
+      private:
+        Logger* mLogger;
+    };
+} // namespace S2Plugin
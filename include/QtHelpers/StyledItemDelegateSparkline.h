@@ -0,0 +1,13 @@
+#pragma once
+
+#include <QStyledItemDelegate>
+
+namespace S2Plugin
+{
+    // paints a QVector<double> (the display role of the cell) as a line, scaled to the minimum and maximum of the values
+    class StyledItemDelegateSparkline : public QStyledItemDelegate
+    {
+      protected:
+        void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
+    };
+} // namespace S2Plugin
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QContextMenuEvent>
 #include <QDragEnterEvent>
 #include <QDragMoveEvent>
 #include <QDropEvent>
@@ -11,6 +12,7 @@
 namespace S2Plugin
 {
     class Logger;
+    struct LoggerField;
     class StyledItemDelegateColorPicker;
 
     static constexpr uint8_t gsLogFieldColColor = 0;
@@ -30,6 +32,9 @@ namespace S2Plugin
         void dropEvent(QDropEvent* event) override;
         void keyPressEvent(QKeyEvent* event) override;
         void paintEvent(QPaintEvent* event) override;
+        // adds fields derived from the one clicked: a bit of its flags, a path through its pointer or entity UID, or
+        // an expression over all fields
+        void contextMenuEvent(QContextMenuEvent* event) override;
 
       private slots:
         void cellClicked(const QModelIndex& index);
@@ -37,5 +42,10 @@ namespace S2Plugin
       private:
         std::unique_ptr<StyledItemDelegateColorPicker> mColorPickerDelegate;
         Logger* mLogger;
+
+        void addBitField(size_t fieldIndex);
+        void addPathField(size_t fieldIndex);
+        void addExpressionField();
+        void addField(LoggerField& field);
     };
 } // namespace S2Plugin
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QPaintEvent>
+#include <QTableView>
+
+namespace S2Plugin
+{
+    // The Samples table: before painting, the rows in view are paged in from the recording in one go, instead of
+    // every cell asking for its own sample.
+    class TableViewLoggerSamples : public QTableView
+    {
+        Q_OBJECT
+      public:
+        explicit TableViewLoggerSamples(QWidget* parent = nullptr);
+
+      protected:
+        void paintEvent(QPaintEvent* event) override;
+    };
+} // namespace S2Plugin
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <QPersistentModelIndex>
 #include <QStandardItemModel>
 #include <QTreeView>
 #include <array>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace S2Plugin
 {
@@ -14,6 +17,14 @@ namespace S2Plugin
     struct MemoryField;
     class StyledItemDelegateHTML;
 
+    struct EntityPointerRow
+    {
+        std::string fieldName;
+        size_t memoryOffset; // where the pointer to the entity lives
+        size_t entityOffset;
+        std::string entityName;
+    };
+
     class TreeViewMemoryFields : public QTreeView
     {
         Q_OBJECT
@@ -22,6 +33,11 @@ namespace S2Plugin
         void setMemoryMappedData(MemoryMappedData* mmd);
 
         QStandardItem* addMemoryField(const MemoryField& field, const std::string& fieldNameOverride, QStandardItem* parent = nullptr);
+        // Inserts a top level EntityPointer row for every entry at the given row in one insert, with the values already
+        // filled in. Meant for long entity lists, where addMemoryField + updateValueForField per entity is too slow.
+        void insertEntityPointerRows(int row, const std::vector<EntityPointerRow>& rows);
+        void updateEntityPointerRow(int row, const EntityPointerRow& entityRow);
+        void removeTopLevelRows(int row, int count);
         void clear();
         void updateTableHeader(bool restoreColumnWidths = true);
         void setEnableChangeHighlighting(bool b) noexcept;
@@ -31,6 +47,12 @@ namespace S2Plugin
         void updateValueForField(const MemoryField& field, const std::string& fieldNameOverride, std::unordered_map<std::string, size_t>& offsets, size_t memoryOffsetDeltaReference = 0,
                                  QStandardItem* parent = nullptr, bool disableChangeHighlightingForField = false);
 
+        // Wrap a refresh (a series of updateValueForField calls) in beginBatchUpdate/endBatchUpdate to suppress
+        // the per-cell model signals; the changed rows are announced with one dataChanged per contiguous range
+        // at the end, and the view repaints once. Calls may be nested, only the outermost pair takes effect.
+        void beginBatchUpdate();
+        void endBatchUpdate();
+
       protected:
         void dragEnterEvent(QDragEnterEvent* event) override;
         void dragMoveEvent(QDragMoveEvent* event) override;
@@ -46,11 +68,23 @@ namespace S2Plugin
         void cellClicked(const QModelIndex& index);
 
       private:
+        struct BatchedRowChanges
+        {
+            QPersistentModelIndex parentIndex;
+            std::set<int> rows;
+        };
+
+        void recordBatchedRowChange(QStandardItem* item);
+        static QList<QStandardItem*> createRowItems(const MemoryField& field, const std::string& fieldNameUID);
+        void setEntityPointerRowData(int row, const EntityPointerRow& entityRow);
+
         ViewToolbar* mToolbar;
         MemoryMappedData* mMemoryMappedData;
         QStandardItemModel* mModel;
         std::unique_ptr<StyledItemDelegateHTML> mHTMLDelegate;
         std::array<uint32_t, 9> mSavedColumnWidths = {0};
         bool mEnableChangeHighlighting = true;
+        uint32_t mBatchUpdateDepth = 0;
+        std::unordered_map<QStandardItem*, BatchedRowChanges> mBatchedRowChanges; // keyed on parent item, nullptr = top level
     };
 } // namespace S2Plugin
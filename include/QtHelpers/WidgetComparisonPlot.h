@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QWidget>
+#include <utility>
+#include <vector>
+
+namespace S2Plugin
+{
+    class Logger;
+    class LoggerComparison;
+
+    // Overlays the compared field of every kept session, in the session's color, over the aligned frames. Each
+    // session is reduced to the lowest and highest value per pixel column once per comparison or resize, so hovering
+    // only repaints.
+    class WidgetComparisonPlot : public QWidget
+    {
+        Q_OBJECT
+      public:
+        WidgetComparisonPlot(Logger* logger, LoggerComparison* comparison, QWidget* parent = nullptr);
+
+        QSize minimumSizeHint() const override;
+        QSize sizeHint() const override;
+
+        // the comparison was updated
+        void comparisonChanged();
+
+      protected:
+        void paintEvent(QPaintEvent* event) override;
+        void mouseMoveEvent(QMouseEvent* event) override;
+        void leaveEvent(QEvent* event) override;
+
+      private:
+        Logger* mLogger;
+        LoggerComparison* mComparison;
+        QPoint mCurrentMousePos = QPoint();
+
+        // per session, the lowest and highest value of each pixel column, NaN where there's none
+        std::vector<std::vector<std::pair<double, double>>> mColumns;
+        int mColumnsWidth = -1;
+
+        int plotWidth() const;
+        void decimate();
+    };
+} // namespace S2Plugin
@@ -2,12 +2,19 @@
 
 #include <QMouseEvent>
 #include <QPaintEvent>
+#include <QWheelEvent>
 #include <QWidget>
+#include <utility>
+#include <vector>
 
 namespace S2Plugin
 {
     class Logger;
 
+    // Plots the logged fields over a window of the recording. Each field is reduced to the lowest and highest sample
+    // per pixel column (from the min/max trees the sample columns keep) and drawn as one polyline, so the cost of a
+    // repaint depends on the width of the widget, not on the length of the recording.
+    // The mouse wheel zooms around the cursor, dragging pans.
     class WidgetSamplesPlot : public QWidget
     {
         Q_OBJECT
@@ -17,13 +24,33 @@ namespace S2Plugin
         QSize minimumSizeHint() const override;
         QSize sizeHint() const override;
 
+        // shows the whole recording again
+        void resetView();
+
       protected:
         void paintEvent(QPaintEvent* event) override;
         void mouseMoveEvent(QMouseEvent* event) override;
+        void mousePressEvent(QMouseEvent* event) override;
+        void mouseReleaseEvent(QMouseEvent* event) override;
+        void wheelEvent(QWheelEvent* event) override;
         void leaveEvent(QEvent* event) override;
 
       private:
         Logger* mLogger;
         QPoint mCurrentMousePos = QPoint();
+
+        bool mFitToWidth = true;
+        double mViewFirst = 0;       // the sample at the left edge of the plot
+        double mSamplesPerPixel = 1; // the zoom level
+        bool mDragging = false;
+        int mDragStartX = 0;
+        double mDragStartViewFirst = 0;
+        std::vector<std::pair<double, double>> mDecimated;
+
+        static constexpr double msMinSamplesPerPixel = 1. / 16.;
+
+        int plotWidth() const;
+        void clampView();
+        int64_t sampleIndexAt(int x) const;
     };
 } // namespace S2Plugin
@@ -1,17 +1,24 @@
 #pragma once
 
+#include "Data/EntitySpatialIndex.h"
+#include <QImage>
 #include <QWidget>
 #include <cstdint>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace S2Plugin
 {
+    struct ViewToolbar;
+    struct EntityHeatmap;
+
     class WidgetSpelunkyLevel : public QWidget
     {
         Q_OBJECT
 
       public:
-        explicit WidgetSpelunkyLevel(QWidget* parent = nullptr);
+        explicit WidgetSpelunkyLevel(ViewToolbar* toolbar, QWidget* parent = nullptr);
 
         QSize minimumSizeHint() const override;
         QSize sizeHint() const override;
@@ -23,23 +30,49 @@ namespace S2Plugin
         void clearPaintedEntities();
         void clearPaintedEntityUID(uint32_t entityUID);
 
+        // overlays a layer of an accumulated heatmap (nullptr to remove it); updateHeatmap() pulls in the cells
+        // that changed since the last call and only repaints those pixels of the overlay image
+        void setHeatmap(EntityHeatmap* heatmap, size_t layer);
+        void updateHeatmap();
+
+        const EntitySpatialIndex& spatialIndex() const noexcept;
+        // 0 when nothing is selected
+        uint32_t selectedEntityUID() const noexcept;
+
+      signals:
+        void entitySelected(size_t entityOffset);
+        void entityActivated(size_t entityOffset);
+
       protected:
         void paintEvent(QPaintEvent* event) override;
+        void mousePressEvent(QMouseEvent* event) override;
+        void mouseDoubleClickEvent(QMouseEvent* event) override;
 
       private:
-        size_t mEntitiesOffset;
-        uint32_t mEntitiesCount;
+        ViewToolbar* mToolbar;
+        EntitySpatialIndex mSpatialIndex;
+        uint32_t mSelectedEntityUID = 0;
 
         std::unordered_map<uint32_t, QColor> mEntityMasksToPaint;
         std::unordered_map<uint32_t, QColor> mEntityIDsToPaint;
         std::unordered_map<uint32_t, QColor> mEntityUIDsToPaint;
-        std::pair<float, float> getEntityCoordinates(size_t entityOffset) const;
 
-        static constexpr float msLevelMaxHeight = 125.0;
-        static constexpr float msLevelMaxWidth = 3. + 3. + (8 * 10);
+        EntityHeatmap* mHeatmap = nullptr;
+        size_t mHeatmapLayer = 0;
+        QImage mHeatmapImage;
+        std::vector<uint32_t> mHeatmapCounts;
+        std::vector<std::pair<uint32_t, uint32_t>> mHeatmapChangedCells;
+        uint32_t mHeatmapScale = 0; // the power of two the colours are scaled to
+
+        static constexpr float msLevelMaxHeight = EntitySpatialIndex::msLevelMaxHeight;
+        static constexpr float msLevelMaxWidth = EntitySpatialIndex::msLevelMaxWidth;
         static constexpr uint8_t msMarginVer = 1;
         static constexpr uint8_t msMarginHor = 1;
         static constexpr float msScaleFactor = 5.;
+        static constexpr float msPickRadius = 1.5; // in tiles
+
+        const SpatialEntity* entityAt(const QPoint& pos) const;
+        QRgb heatmapColor(uint32_t count) const;
     };
 
 } // namespace S2Plugin
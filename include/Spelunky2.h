@@ -9,6 +9,7 @@
 namespace S2Plugin
 {
     class EntityDB;
+    class State;
 
     constexpr uint8_t gsColField = 0;
     constexpr uint8_t gsColValue = 1;
@@ -42,6 +43,7 @@ namespace S2Plugin
     static const char* gsJSONDragDropMemoryField_UID = "uid";
     static const char* gsJSONDragDropMemoryField_Offset = "offset";
     static const char* gsJSONDragDropMemoryField_Type = "type";
+    static const char* gsJSONDragDropMemoryField_Flag = "flag"; // 1-based index of a flag, the offset and type are of its flags
 
     // new types need to be added to
     // - the MemoryFieldType enum
@@ -340,8 +342,8 @@ namespace S2Plugin
       public:
         size_t spelunky2AfterBundle();
         size_t spelunky2AfterBundleSize();
-        std::string getEntityName(size_t offset, EntityDB* entityDB) const;
-        uint32_t getEntityTypeID(size_t offset) const;
+        std::string getEntityName(size_t offset, EntityDB* entityDB, State* state) const;
+        uint32_t getEntityTypeID(size_t offset, EntityDB* entityDB, State* state) const;
 
         void displayError(const char* fmt, ...);
         void findSpelunky2InMemory();
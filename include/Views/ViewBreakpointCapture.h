@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTableView>
+#include <QVBoxLayout>
+#include <memory>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct ViewToolbar;
+    struct BreakpointCapture;
+    struct CaptureSnapshot;
+    class ItemModelCaptureSnapshots;
+
+    class ViewBreakpointCapture : public QWidget
+    {
+        Q_OBJECT
+      public:
+        ViewBreakpointCapture(ViewToolbar* toolbar, QWidget* parent = nullptr);
+
+      protected:
+        void closeEvent(QCloseEvent* event) override;
+        QSize sizeHint() const override;
+        QSize minimumSizeHint() const override;
+
+      private slots:
+        void toggleArmed();
+        void snapshotsCaptured();
+
+      private:
+        ViewToolbar* mToolbar;
+        std::unique_ptr<BreakpointCapture> mCapture;
+        std::vector<CaptureSnapshot> mReceived;
+
+        QVBoxLayout* mMainLayout;
+        QComboBox* mTargetComboBox;
+        QLineEdit* mTargetLineEdit;
+        QCheckBox* mHardwareCheckBox;
+        QPushButton* mArmButton;
+        QPlainTextEdit* mRegionsEdit;
+        QLineEdit* mMaxHitsLineEdit;
+        QLineEdit* mMaxCaptureTimeLineEdit;
+        QLabel* mStatusLabel;
+        QTableView* mSnapshotsTableView;
+        ItemModelCaptureSnapshots* mModel;
+
+        void initializeUI();
+        void updateStatus();
+        bool parseRegions(std::string& error);
+    };
+} // namespace S2Plugin
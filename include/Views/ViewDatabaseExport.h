@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QCheckBox>
+#include <QLineEdit>
+#include <QPlainTextEdit>
+#include <QVBoxLayout>
+#include <memory>
+
+namespace S2Plugin
+{
+    struct ViewToolbar;
+    struct DatabaseExporter;
+
+    class ViewDatabaseExport : public QWidget
+    {
+        Q_OBJECT
+      public:
+        ViewDatabaseExport(ViewToolbar* toolbar, QWidget* parent = nullptr);
+
+      protected:
+        void closeEvent(QCloseEvent* event) override;
+        QSize sizeHint() const override;
+        QSize minimumSizeHint() const override;
+
+      private slots:
+        void browseFolder();
+        void browseBefore();
+        void browseAfter();
+        void exportDatabases();
+        void compareExports();
+
+      private:
+        ViewToolbar* mToolbar;
+        std::unique_ptr<DatabaseExporter> mExporter;
+
+        QVBoxLayout* mMainLayout;
+        QCheckBox* mEntityDBCheckBox;
+        QCheckBox* mParticleDBCheckBox;
+        QCheckBox* mTextureDBCheckBox;
+        QCheckBox* mCharacterDBCheckBox;
+        QCheckBox* mCSVCheckBox;
+        QLineEdit* mFolderLineEdit;
+        QLineEdit* mBeforeLineEdit;
+        QLineEdit* mAfterLineEdit;
+        QPlainTextEdit* mOutput;
+
+        void initializeUI();
+        QString browseExport();
+    };
+} // namespace S2Plugin
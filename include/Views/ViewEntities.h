@@ -1,16 +1,25 @@
 #pragma once
 
 #include <QCheckBox>
+#include <QLabel>
 #include <QLineEdit>
+#include <QPlainTextEdit>
 #include <QPushButton>
 #include <QString>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace S2Plugin
 {
     struct ViewToolbar;
     struct TreeViewMemoryFields;
+    struct EntityQuery;
 
     enum class MASK : uint32_t
     {
@@ -43,6 +52,10 @@ namespace S2Plugin
 
       private slots:
         void refreshEntities();
+        void toggleAutoRefresh(int newState);
+        void autoRefreshIntervalChanged(const QString& text);
+        void toggleEventLog(int newState);
+        void queryChanged();
 
       private:
         struct EntitySelectSlot
@@ -51,6 +64,15 @@ namespace S2Plugin
             const MASK mask;
             const QString name;
         };
+        struct ListedEntity
+        {
+            uint32_t uid;
+            size_t pointerOffset; // where the pointer to the entity lives in the entity list
+            size_t entity;
+            std::string name;
+        };
+        using EntityListKey = std::pair<uint8_t, uint32_t>; // layer, mask (0 for the uid lookup)
+
         QVBoxLayout* mMainLayout;
         TreeViewMemoryFields* mMainTreeView;
 
@@ -76,10 +98,27 @@ namespace S2Plugin
         };
 
         QLineEdit* mFilterLineEdit;
+        QLineEdit* mQueryLineEdit;
+        QLabel* mQueryErrorLabel;
+        std::unique_ptr<EntityQuery> mQuery;
+        std::string mQueryText;
+        QPushButton* mRefreshButton;
+        QCheckBox* mAutoRefreshCheckBox;
+        QLineEdit* mAutoRefreshIntervalLineEdit;
+        std::unique_ptr<QTimer> mAutoRefreshTimer;
+        QCheckBox* mEventLogCheckBox;
+        QPlainTextEdit* mEventLog;
+        QLabel* mUIDIndexLabel;
+
+        // both sorted on uid; the previous lists are kept for the spawn/despawn log, the listed entities match the rows of the tree
+        std::map<EntityListKey, std::vector<ListedEntity>> mPreviousEntityLists;
+        std::vector<ListedEntity> mListedEntities;
+        bool mColumnsInitialized = false;
 
         ViewToolbar* mToolbar;
 
         void initializeTreeView();
         void initializeRefreshAndFilter();
+        void logEntityListChanges(const std::map<EntityListKey, std::vector<ListedEntity>>& entityLists);
     };
 } // namespace S2Plugin
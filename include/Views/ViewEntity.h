@@ -2,6 +2,7 @@
 
 #include <QCheckBox>
 #include <QComboBox>
+#include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QScrollArea>
@@ -21,6 +22,7 @@ namespace S2Plugin
     struct WidgetMemoryView;
     struct CPPSyntaxHighlighter;
     struct WidgetSpelunkyLevel;
+    struct EntityHeatmap;
 
     class ViewEntity : public QWidget
     {
@@ -43,6 +45,11 @@ namespace S2Plugin
         void label();
         void entityOffsetDropped(size_t entityOffset);
         void tabChanged(int index);
+        void levelEntitySelected(size_t entityOffset);
+        void toggleHeatmap(bool checked);
+        void heatmapLayerChanged(int index);
+        void clearHeatmap();
+        void heatmapFrameAdvanced(uint32_t frame);
 
       private:
         QVBoxLayout* mMainLayout;
@@ -71,6 +78,11 @@ namespace S2Plugin
 
         // TAB LEVEL
         WidgetSpelunkyLevel* mSpelunkyLevel;
+        QLabel* mLevelSelectionLabel;
+        QCheckBox* mHeatmapCheckBox;
+        QComboBox* mHeatmapLayerComboBox;
+        QLabel* mHeatmapStatusLabel;
+        std::unique_ptr<EntityHeatmap> mHeatmap;
 
         // TAB CPP
         QTextEdit* mCPPTextEdit;
@@ -3,10 +3,10 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QCompleter>
+#include <QSortFilterProxyModel>
 #include <QStandardItemModel>
-#include <QTableWidget>
+#include <QTableView>
 #include <QTreeView>
-#include <QTreeWidget>
 #include <QVBoxLayout>
 #include <QWidget>
 #include <memory>
@@ -18,6 +18,8 @@ namespace S2Plugin
     struct StyledItemDelegateHTML;
     struct TreeViewMemoryFields;
     struct MemoryField;
+    struct EntityDBComparison;
+    class ItemModelEntityDBComparison;
 
     class ViewEntityDB : public QWidget
     {
@@ -39,8 +41,8 @@ namespace S2Plugin
         void fieldExpanded(const QModelIndex& index);
         void comparisonFieldChosen(const QString& fieldName);
         void compareGroupByCheckBoxClicked(int state);
-        void comparisonCellClicked(int row, int column);
-        void groupedComparisonItemClicked(QTreeWidgetItem* item, int column);
+        void comparisonCellClicked(const QModelIndex& index);
+        void groupedComparisonItemClicked(const QModelIndex& index);
 
       private:
         ViewToolbar* mToolbar;
@@ -59,14 +61,15 @@ namespace S2Plugin
 
         // COMPARE
         QComboBox* mCompareFieldComboBox;
-        QTableWidget* mCompareTableWidget;
-        QTreeWidget* mCompareTreeWidget;
+        std::unique_ptr<EntityDBComparison> mComparison;
+        QTableView* mCompareTableView;
+        ItemModelEntityDBComparison* mCompareTableModel;
+        QSortFilterProxyModel* mCompareTableProxy;
+        QTreeView* mCompareTreeView;
+        ItemModelEntityDBComparison* mCompareTreeModel;
 
         void initializeUI();
         void updateFieldValues();
         void populateComparisonCombobox(const std::string& prefix, const std::vector<S2Plugin::MemoryField>& fields);
-        void populateComparisonTableWidget();
-        void populateComparisonTreeWidget();
-        std::pair<QString, QVariant> valueForField(const std::string& prefix, const MemoryField& field, size_t entityDBIndex);
     };
 } // namespace S2Plugin
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableView>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <memory>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct ViewToolbar;
+    struct EntityGrid;
+    struct EntityScalarField;
+    class ItemModelEntityGrid;
+    class SortFilterProxyModelEntityGrid;
+
+    class ViewEntityGrid : public QWidget
+    {
+        Q_OBJECT
+      public:
+        ViewEntityGrid(ViewToolbar* toolbar, QWidget* parent = nullptr);
+
+      protected:
+        void closeEvent(QCloseEvent* event) override;
+        QSize sizeHint() const override;
+        QSize minimumSizeHint() const override;
+
+      private slots:
+        void refreshGrid();
+        void sourceChanged();
+        void entityClassChanged(const QString& text);
+        void addColumn();
+        void removeColumn();
+        void filterChanged();
+        void cellClicked(const QModelIndex& index);
+        void toggleAutoRefresh(int newState);
+        void autoRefreshIntervalChanged(const QString& text);
+
+      private:
+        ViewToolbar* mToolbar;
+        std::unique_ptr<EntityGrid> mEntityGrid;
+        std::vector<EntityScalarField> mAvailableColumns;
+
+        QVBoxLayout* mMainLayout;
+        QComboBox* mLayerComboBox;
+        QComboBox* mMaskComboBox;
+        QLineEdit* mUIDsLineEdit;
+        QComboBox* mEntityClassComboBox;
+        QComboBox* mFieldComboBox;
+        QComboBox* mFilterColumnComboBox;
+        QLineEdit* mFilterLineEdit;
+        QPushButton* mRefreshButton;
+        QCheckBox* mAutoRefreshCheckBox;
+        QLineEdit* mAutoRefreshIntervalLineEdit;
+        std::unique_ptr<QTimer> mAutoRefreshTimer;
+
+        QTableView* mMainTableView;
+        ItemModelEntityGrid* mModel;
+        SortFilterProxyModelEntityGrid* mModelProxy;
+
+        void initializeUI();
+        void updateFilterColumns();
+    };
+} // namespace S2Plugin
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTableView>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <memory>
+#include <vector>
+
+namespace S2Plugin
+{
+    struct ViewToolbar;
+    struct EntityWatch;
+    struct EntityScalarField;
+    class ItemModelEntityWatch;
+    class StyledItemDelegateSparkline;
+
+    class ViewEntityWatch : public QWidget
+    {
+        Q_OBJECT
+      public:
+        ViewEntityWatch(ViewToolbar* toolbar, QWidget* parent = nullptr);
+
+      protected:
+        void closeEvent(QCloseEvent* event) override;
+        QSize sizeHint() const override;
+        QSize minimumSizeHint() const override;
+
+      private slots:
+        void refreshWatch();
+        void entityClassChanged(const QString& text);
+        void addField();
+        void removeField();
+        void cellClicked(const QModelIndex& index);
+        void toggleAutoRefresh(int newState);
+        void togglePerFrameRefresh(bool checked);
+        void autoRefreshIntervalChanged(const QString& text);
+
+      private:
+        ViewToolbar* mToolbar;
+        std::unique_ptr<EntityWatch> mEntityWatch;
+        std::vector<EntityScalarField> mAvailableFields;
+
+        QVBoxLayout* mMainLayout;
+        QLineEdit* mUIDsLineEdit;
+        QComboBox* mEntityClassComboBox;
+        QComboBox* mFieldComboBox;
+        QPushButton* mRefreshButton;
+        QCheckBox* mPerFrameCheckBox;
+        QCheckBox* mAutoRefreshCheckBox;
+        QLineEdit* mAutoRefreshIntervalLineEdit;
+        std::unique_ptr<QTimer> mAutoRefreshTimer;
+        QLineEdit* mRefreshBudgetLineEdit;
+        QLabel* mStatisticsLabel;
+
+        QTableView* mMainTableView;
+        ItemModelEntityWatch* mModel;
+        std::unique_ptr<StyledItemDelegateSparkline> mSparklineDelegate;
+
+        void initializeUI();
+    };
+} // namespace S2Plugin
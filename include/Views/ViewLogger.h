@@ -1,5 +1,8 @@
 #pragma once
 
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QScrollArea>
@@ -11,18 +14,25 @@
 namespace S2Plugin
 {
     class Logger;
+    class LoggerComparison;
+    struct LoggerTrigger;
+    struct ViewToolbar;
     struct TableViewLogger;
+    struct TableViewLoggerSamples;
     struct ItemModelLoggerFields;
     struct WidgetSampling;
     struct ItemModelLoggerSamples;
     struct WidgetSamplesPlot;
+    struct ItemModelLoggerStatistics;
+    struct ItemModelLoggerComparison;
+    struct WidgetComparisonPlot;
 
     class ViewLogger : public QWidget
     {
         Q_OBJECT
 
       public:
-        explicit ViewLogger(QWidget* parent = nullptr);
+        explicit ViewLogger(ViewToolbar* toolbar, QWidget* parent = nullptr);
 
       protected:
         void closeEvent(QCloseEvent* event) override;
@@ -32,22 +42,48 @@ namespace S2Plugin
       private slots:
         void samplingEnded();
         void fieldsChanged();
+        void perFrameToggled(int newState);
+        void openRecording();
+        void samplesDecimationChanged();
+        void keepSession();
+        void addSessionFromRecording();
+        void removeSession();
+        void sessionsChanged();
+        void updateComparison();
 
       private:
+        ViewToolbar* mToolbar;
         QVBoxLayout* mMainLayout;
         std::unique_ptr<Logger> mLogger;
 
         // TOP LAYOUT
         QHBoxLayout* mTopLayout;
         QLineEdit* mSamplePeriodLineEdit;
+        QCheckBox* mPerFrameCheckBox;
+        QLabel* mSamplingStatsLabel;
         QLineEdit* mDurationLineEdit;
+        QLineEdit* mSpanGapLineEdit;
+        QCheckBox* mRecordToFileCheckBox;
         QPushButton* mStartButton;
+        QPushButton* mOpenRecordingButton;
+
+        // TRIGGER LAYOUT
+        QWidget* mTriggerWidget;
+        QCheckBox* mTriggerCheckBox;
+        QComboBox* mTriggerFieldComboBox;
+        QComboBox* mTriggerConditionComboBox;
+        QLineEdit* mTriggerValueLineEdit;
+        QLineEdit* mPreTriggerLineEdit;
+        QLineEdit* mPostTriggerLineEdit;
+        QCheckBox* mRearmCheckBox;
 
         // TABS
         QTabWidget* mMainTabWidget;
         QWidget* mTabFields;
         QWidget* mTabSamples;
         QWidget* mTabPlot;
+        QWidget* mTabStatistics;
+        QWidget* mTabCompare;
 
         // TABLE
         TableViewLogger* mFieldsTableView;
@@ -55,14 +91,31 @@ namespace S2Plugin
         WidgetSampling* mSamplingWidget;
 
         // SAMPLES
-        QTableView* mSamplesTableView;
+        QComboBox* mSamplesDecimationComboBox;
+        QLineEdit* mSamplesStrideLineEdit;
+        TableViewLoggerSamples* mSamplesTableView;
         ItemModelLoggerSamples* mSamplesTableModel;
 
         // PLOT
         QScrollArea* mSamplesPlotScroll;
         WidgetSamplesPlot* mSamplesPlotWidget;
 
+        // STATISTICS
+        QTableView* mStatisticsTableView;
+        ItemModelLoggerStatistics* mStatisticsTableModel;
+
+        // COMPARE
+        std::unique_ptr<LoggerComparison> mComparison;
+        QComboBox* mCompareFieldComboBox;
+        QComboBox* mCompareAlignmentComboBox;
+        WidgetComparisonPlot* mComparisonPlotWidget;
+        QTableView* mComparisonTableView;
+        ItemModelLoggerComparison* mComparisonTableModel;
+
         void initializeUI();
         void startLogging();
+        void showError(const QString& message);
+        void applyTrigger();
+        LoggerTrigger triggerFromUI() const;
     };
 } // namespace S2Plugin
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <QCheckBox>
+#include <QComboBox>
+#include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
+#include <QScrollBar>
 #include <QVBoxLayout>
 #include <memory>
 #include <vector>
@@ -12,12 +15,21 @@ namespace S2Plugin
     struct ViewToolbar;
     struct MemoryField;
     struct TreeViewMemoryFields;
+    enum class MemoryFieldType;
 
+    // Only the element count and stride of the container are known up front, the tree view holds a single page
+    // of elements starting at the scrollbar position. Paging, jumping and refreshing only touch that page.
     class ViewStdVector : public QWidget
     {
         Q_OBJECT
       public:
-        ViewStdVector(ViewToolbar* toolbar, const std::string& vectorType, size_t vectorOffset, QWidget* parent = nullptr);
+        enum class ContainerLayout
+        {
+            StdVector, // std::vector<T>: begin and end pointer
+            Vector,    // the game's own vector: items pointer at +8, uint32_t count at +20
+        };
+
+        ViewStdVector(ViewToolbar* toolbar, const std::string& vectorType, size_t vectorOffset, ContainerLayout layout = ContainerLayout::StdVector, QWidget* parent = nullptr);
 
       protected:
         void closeEvent(QCloseEvent* event) override;
@@ -30,23 +42,55 @@ namespace S2Plugin
         void toggleAutoRefresh(int newState);
         void autoRefreshTimerTrigger();
         void autoRefreshIntervalChanged(const QString& text);
+        void pageScrolled(int position);
+        void jumpToIndex();
+        void applyFilter();
+        void clearFilter();
 
       private:
+        struct FilterField
+        {
+            std::string name;
+            MemoryFieldType type;
+            size_t offset; // relative to the start of the element (or the pointee for pointer elements)
+            size_t size;
+        };
+
         std::string mVectorType;
         size_t mVectorOffset;
-        size_t mVectorBegin;
+        ContainerLayout mContainerLayout;
+        size_t mVectorBegin = 0;
+        size_t mVectorCount = 0;
         size_t mVectorTypeSize;
-        std::vector<MemoryField> mMemoryFields;
+        std::vector<MemoryField> mMemoryFields; // fields of the visible page
+        std::vector<size_t> mMemoryFieldIndices;
+        std::vector<FilterField> mFilterFields;
+        std::vector<size_t> mFilteredIndices;
+        bool mFilterActive = false;
+        size_t mPageStart = 0;
+        static const size_t msPageSize = 100;
 
         QVBoxLayout* mMainLayout;
         TreeViewMemoryFields* mMainTreeView;
+        QScrollBar* mPageScrollBar;
         ViewToolbar* mToolbar;
         QPushButton* mRefreshDataButton;
         QCheckBox* mAutoRefreshCheckBox;
         QLineEdit* mAutoRefreshIntervalLineEdit;
         std::unique_ptr<QTimer> mAutoRefreshTimer;
+        QLineEdit* mJumpToIndexLineEdit;
+        QComboBox* mFilterFieldComboBox;
+        QLineEdit* mFilterValueLineEdit;
+        QLabel* mPageLabel;
 
         void initializeTreeView();
         void initializeRefreshLayout();
+        void initializeNavigationLayout();
+        void initializeFilterFields();
+        void readContainerBounds();
+        void populatePage();
+        MemoryField elementField(size_t index) const;
+        size_t visibleCount() const noexcept;
+        size_t indexAtPosition(size_t position) const;
     };
 } // namespace S2Plugin
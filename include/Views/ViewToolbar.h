@@ -25,6 +25,7 @@ namespace S2Plugin
     struct StringsTable;
     struct Online;
     struct Configuration;
+    struct FrameClock;
 
     class ViewToolbar : public QDockWidget
     {
@@ -47,6 +48,7 @@ namespace S2Plugin
         StringsTable* stringsTable();
         Online* online();
         Configuration* configuration() const noexcept;
+        FrameClock* frameClock() const noexcept;
 
         void resetSpelunky2Data();
 
@@ -58,6 +60,10 @@ namespace S2Plugin
         void showGameManager();
         void showLevelGen();
         void showEntities();
+        void showEntityGrid();
+        void showEntityWatch();
+        void showBreakpointCapture();
+        void showDatabaseExport();
         ViewVirtualTable* showVirtualTableLookup();
         void showStringsTable();
         ViewCharacterDB* showCharacterDB();
@@ -66,6 +72,7 @@ namespace S2Plugin
         void showVirtualFunctions(size_t offset, const std::string& typeName);
         void showOnline();
         void showStdVector(size_t offset, const std::string& typeName);
+        void showVector(size_t offset);
         void showStdMap(size_t offset, const std::string& keytypeName, const std::string& valuetypeName);
         void showJournalPage(size_t offset, const std::string& pageType);
         void showThreads();
@@ -85,6 +92,7 @@ namespace S2Plugin
         StringsTable* mStringsTable;
         Configuration* mConfiguration;
         Online* mOnline;
+        FrameClock* mFrameClock;
 
         QMdiArea* mMDIArea;
         QVBoxLayout* mMainLayout;
@@ -0,0 +1,249 @@
+#include "Data/BreakpointCapture.h"
+#include "pluginmain.h"
+#include <algorithm>
+#include <cstdio>
+
+std::mutex S2Plugin::BreakpointCapture::msArmedMutex;
+S2Plugin::BreakpointCapture* S2Plugin::BreakpointCapture::msArmed = nullptr;
+
+S2Plugin::BreakpointCapture::BreakpointCapture(QObject* parent) : QObject(parent) {}
+
+S2Plugin::BreakpointCapture::~BreakpointCapture()
+{
+    disarm();
+}
+
+void S2Plugin::BreakpointCapture::setRegions(const std::vector<CaptureRegion>& regions)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRegions = regions;
+}
+
+const std::vector<S2Plugin::CaptureRegion>& S2Plugin::BreakpointCapture::regions() const noexcept
+{
+    return mRegions;
+}
+
+void S2Plugin::BreakpointCapture::setBudget(uint32_t maxHitsPerSecond, std::chrono::milliseconds maxCaptureTimePerSecond)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mMaxHitsPerSecond = maxHitsPerSecond;
+    mMaxCaptureTimePerSecond = maxCaptureTimePerSecond;
+}
+
+bool S2Plugin::BreakpointCapture::execute(const std::string& command, std::string& error)
+{
+    if (!DbgCmdExecDirect(command.c_str()))
+    {
+        error = "x64dbg refused: " + command;
+        return false;
+    }
+    return true;
+}
+
+bool S2Plugin::BreakpointCapture::arm(size_t address, bool hardware, const std::string& captureCondition, size_t frameCounterAddress, std::string& error)
+{
+    disarm();
+    if (!DbgIsDebugging())
+    {
+        error = "Not debugging";
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> armedLock(msArmedMutex);
+        if (msArmed != nullptr)
+        {
+            error = "Another capture is armed already";
+            return false;
+        }
+        msArmed = this;
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.clear();
+        mHits = 0;
+        mCaptures = 0;
+        mDropped = 0;
+        mTotalCaptureMicroseconds = 0;
+        mMaxCaptureMicroseconds = 0;
+        mWindowStart = std::chrono::steady_clock::now();
+        mWindowHits = 0;
+        mLastWindowHits = 0;
+        mWindowCaptureTime = std::chrono::microseconds(0);
+        mOverBudget = false;
+        mFrameCounterAddress = frameCounterAddress;
+    }
+    mAddress = address;
+    mHardware = hardware;
+
+    // never break, but always run the capture command (or only when the capture condition holds), silently
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "0x%016llX", static_cast<unsigned long long>(address));
+    std::string addr = buffer;
+    std::string prefix = hardware ? "SetHardwareBreakpoint" : "SetBreakpoint";
+    auto ok = execute(hardware ? "bph " + addr + ", x" : "bp " + addr, error);
+    ok = ok && execute(prefix + "Condition " + addr + ", 0", error);
+    ok = ok && execute(prefix + "Command " + addr + ", \"" + msCommandName + "\"", error);
+    ok = ok && execute(prefix + "CommandCondition " + addr + ", \"" + (captureCondition.empty() ? "1" : captureCondition) + "\"", error);
+    ok = ok && execute(prefix + "Silent " + addr + ", 1", error);
+    if (!ok)
+    {
+        disarm();
+        return false;
+    }
+    return true;
+}
+
+void S2Plugin::BreakpointCapture::disarm()
+{
+    {
+        // waits for a hit that is being captured right now
+        std::lock_guard<std::mutex> armedLock(msArmedMutex);
+        if (msArmed != this)
+        {
+            return;
+        }
+        msArmed = nullptr;
+    }
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "0x%016llX", static_cast<unsigned long long>(mAddress));
+    if (DbgIsDebugging())
+    {
+        DbgCmdExecDirect((std::string(mHardware ? "bphc " : "bc ") + buffer).c_str());
+    }
+}
+
+bool S2Plugin::BreakpointCapture::isArmed() const noexcept
+{
+    std::lock_guard<std::mutex> armedLock(msArmedMutex);
+    return msArmed == this;
+}
+
+bool S2Plugin::BreakpointCapture::overBudget() const noexcept
+{
+    return mOverBudget;
+}
+
+bool S2Plugin::BreakpointCapture::captureCommand(int argc, char** argv)
+{
+    std::lock_guard<std::mutex> armedLock(msArmedMutex);
+    if (msArmed != nullptr)
+    {
+        msArmed->capture();
+    }
+    return true;
+}
+
+void S2Plugin::BreakpointCapture::capture()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mHits;
+    auto start = std::chrono::steady_clock::now();
+    if (start - mWindowStart >= std::chrono::seconds(1))
+    {
+        mLastWindowHits = mWindowHits;
+        mWindowStart = start;
+        mWindowHits = 0;
+        mWindowCaptureTime = std::chrono::microseconds(0);
+    }
+    ++mWindowHits;
+    if (mOverBudget)
+    {
+        return;
+    }
+    if (mWindowHits > mMaxHitsPerSecond || mWindowCaptureTime > mMaxCaptureTimePerSecond)
+    {
+        mOverBudget = true;
+        if (!mDeliveryPending.exchange(true))
+        {
+            QMetaObject::invokeMethod(this, "deliverSnapshots", Qt::QueuedConnection);
+        }
+        return;
+    }
+
+    CaptureSnapshot snapshot;
+    snapshot.hit = mHits;
+    snapshot.frame = 0;
+    if (mFrameCounterAddress != 0)
+    {
+        Script::Memory::Read(mFrameCounterAddress, &snapshot.frame, sizeof(snapshot.frame), nullptr);
+    }
+    size_t totalSize = 0;
+    for (const auto& region : mRegions)
+    {
+        totalSize += region.size;
+    }
+    snapshot.data.resize(totalSize);
+    size_t offset = 0;
+    for (const auto& region : mRegions)
+    {
+        Script::Memory::Read(region.address, snapshot.data.data() + offset, region.size, nullptr);
+        offset += region.size;
+    }
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    snapshot.microseconds = static_cast<uint32_t>(duration.count());
+
+    ++mCaptures;
+    mWindowCaptureTime += duration;
+    mTotalCaptureMicroseconds += snapshot.microseconds;
+    mMaxCaptureMicroseconds = (std::max)(mMaxCaptureMicroseconds, snapshot.microseconds);
+    if (mPending.size() < msMaxPendingSnapshots)
+    {
+        mPending.emplace_back(std::move(snapshot));
+    }
+    else
+    {
+        ++mDropped;
+    }
+    if (!mDeliveryPending.exchange(true))
+    {
+        QMetaObject::invokeMethod(this, "deliverSnapshots", Qt::QueuedConnection);
+    }
+}
+
+void S2Plugin::BreakpointCapture::deliverSnapshots()
+{
+    mDeliveryPending = false;
+    emit snapshotsCaptured();
+}
+
+void S2Plugin::BreakpointCapture::takeSnapshots(std::vector<CaptureSnapshot>& snapshots)
+{
+    snapshots.clear();
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::swap(snapshots, mPending);
+}
+
+uint64_t S2Plugin::BreakpointCapture::hitCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mHits;
+}
+
+uint64_t S2Plugin::BreakpointCapture::captureCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCaptures;
+}
+
+uint64_t S2Plugin::BreakpointCapture::droppedCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mDropped;
+}
+
+uint32_t S2Plugin::BreakpointCapture::maxCaptureMicroseconds() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMaxCaptureMicroseconds;
+}
+
+uint32_t S2Plugin::BreakpointCapture::averageCaptureMicroseconds() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mCaptures == 0 ? 0 : static_cast<uint32_t>(mTotalCaptureMicroseconds / mCaptures);
+}
+
+uint32_t S2Plugin::BreakpointCapture::hitsLastSecond() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastWindowHits;
+}
@@ -26,8 +26,8 @@ bool S2Plugin::CharacterDB::loadCharacters(StringsTable* stringsTable)
     auto instructionOffset = Script::Pattern::FindMem(afterBundle, afterBundleSize, "48 6B C3 2C 48 8D 15 ?? ?? ?? ?? 48");
     mCharactersPtr = instructionOffset + 11 + (duint)Script::Memory::ReadDword(instructionOffset + 7);
 
-    size_t characterSize = 0x2C;
-    for (size_t x = 0; x < 20; ++x)
+    size_t characterSize = msCharacterSize;
+    for (size_t x = 0; x < charactersCount(); ++x)
     {
         size_t startOffset = mCharactersPtr + (x * characterSize);
         size_t offset = startOffset;
@@ -58,6 +58,11 @@ std::unordered_map<std::string, size_t>& S2Plugin::CharacterDB::offsetsForIndex(
     return empty;
 }
 
+S2Plugin::DatabaseTableLayout S2Plugin::CharacterDB::tableLayout() const noexcept
+{
+    return DatabaseTableLayout{mCharactersPtr, charactersCount(), msCharacterSize};
+}
+
 void S2Plugin::CharacterDB::reset()
 {
     mCharactersPtr = 0;
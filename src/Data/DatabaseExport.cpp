@@ -0,0 +1,349 @@
+#include "Data/DatabaseExport.h"
+#include "Data/BinaryFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace
+{
+    constexpr char gsExportMagic[4] = {'S', '2', 'D', 'B'};
+    constexpr uint32_t gsExportVersion = 1;
+
+    uint64_t rawFromBytes(const uint8_t* data, size_t size)
+    {
+        uint64_t raw = 0;
+        std::memcpy(&raw, data, (std::min)(size, sizeof(uint64_t)));
+        return raw;
+    }
+} // namespace
+
+bool S2Plugin::DatabaseExportWriter::open(const std::string& path, const std::string& csvPath, const std::string& tableName, size_t entryCount, size_t entrySize,
+                                          const std::vector<ExportColumn>& columns)
+{
+    mError.clear();
+    mColumns = columns;
+    mEntryCount = entryCount;
+    mEntrySize = entrySize;
+
+    mFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!mFile)
+    {
+        return fail("Could not open " + path + " for writing");
+    }
+    mFile.write(gsExportMagic, sizeof(gsExportMagic));
+    writeValue<uint32_t>(mFile, gsExportVersion);
+    writeString(mFile, tableName);
+    writeValue<uint64_t>(mFile, entryCount);
+    writeValue<uint64_t>(mFile, entrySize);
+    writeValue<uint32_t>(mFile, static_cast<uint32_t>(mColumns.size()));
+    for (const auto& column : mColumns)
+    {
+        writeString(mFile, column.name);
+        writeValue<uint8_t>(mFile, static_cast<uint8_t>(column.kind));
+        writeValue<uint32_t>(mFile, column.offset);
+        writeValue<uint8_t>(mFile, column.size);
+    }
+
+    // lay out the columns back to back after the header and grow the file to its final size, chunks are written into place
+    uint64_t position = static_cast<uint64_t>(mFile.tellp());
+    mColumnStart.clear();
+    for (const auto& column : mColumns)
+    {
+        mColumnStart.emplace_back(position);
+        position += static_cast<uint64_t>(column.size) * entryCount;
+    }
+    if (position > static_cast<uint64_t>(mFile.tellp()))
+    {
+        mFile.seekp(position - 1);
+        mFile.put('\0');
+    }
+    if (!mFile)
+    {
+        return fail("Could not write the header of " + path);
+    }
+
+    if (!csvPath.empty())
+    {
+        mCSV.open(csvPath, std::ios::trunc);
+        if (!mCSV)
+        {
+            return fail("Could not open " + csvPath + " for writing");
+        }
+        mCSV << "entry";
+        for (const auto& column : mColumns)
+        {
+            mCSV << ',' << column.name;
+        }
+        mCSV << '\n';
+    }
+    return true;
+}
+
+bool S2Plugin::DatabaseExportWriter::writeEntries(size_t firstEntry, const uint8_t* entries, size_t count)
+{
+    if (!mFile || firstEntry + count > mEntryCount)
+    {
+        return fail("Entries out of range or the export isn't open");
+    }
+    for (size_t c = 0; c < mColumns.size(); ++c)
+    {
+        const auto& column = mColumns[c];
+        mColumnChunk.resize(count * column.size);
+        auto source = entries + column.offset;
+        for (size_t x = 0; x < count; ++x)
+        {
+            std::memcpy(mColumnChunk.data() + (x * column.size), source + (x * mEntrySize), column.size);
+        }
+        mFile.seekp(mColumnStart[c] + (static_cast<uint64_t>(firstEntry) * column.size));
+        mFile.write(reinterpret_cast<const char*>(mColumnChunk.data()), mColumnChunk.size());
+    }
+    if (!mFile)
+    {
+        return fail("Writing the export failed");
+    }
+
+    if (mCSV.is_open())
+    {
+        for (size_t x = 0; x < count; ++x)
+        {
+            auto entry = entries + (x * mEntrySize);
+            mCSV << firstEntry + x;
+            for (const auto& column : mColumns)
+            {
+                mCSV << ',' << formatExportValue(column, rawFromBytes(entry + column.offset, column.size));
+            }
+            mCSV << '\n';
+        }
+        if (!mCSV)
+        {
+            return fail("Writing the CSV file failed");
+        }
+    }
+    return true;
+}
+
+bool S2Plugin::DatabaseExportWriter::close()
+{
+    auto ok = static_cast<bool>(mFile);
+    mFile.close();
+    if (mCSV.is_open())
+    {
+        ok = ok && static_cast<bool>(mCSV);
+        mCSV.close();
+    }
+    return ok;
+}
+
+const std::string& S2Plugin::DatabaseExportWriter::error() const noexcept
+{
+    return mError;
+}
+
+bool S2Plugin::DatabaseExportWriter::fail(const std::string& error)
+{
+    if (mError.empty())
+    {
+        mError = error;
+    }
+    return false;
+}
+
+bool S2Plugin::DatabaseExport::load(const std::string& path, std::string& error)
+{
+    std::ifstream fp(path, std::ios::binary);
+    if (!fp)
+    {
+        error = "Could not open " + path;
+        return false;
+    }
+    uint32_t version = 0;
+    if (!readMagic(fp, gsExportMagic) || !readValue(fp, version) || version != gsExportVersion)
+    {
+        error = path + " is not a database export";
+        return false;
+    }
+    uint32_t columnCount = 0;
+    if (!readString(fp, tableName) || !readValue(fp, entryCount) || !readValue(fp, entrySize) || !readValue(fp, columnCount))
+    {
+        error = "The header of " + path + " is truncated";
+        return false;
+    }
+    columns.clear();
+    for (uint32_t c = 0; c < columnCount; ++c)
+    {
+        ExportColumn column;
+        uint8_t kind = 0;
+        if (!readString(fp, column.name) || !readValue(fp, kind) || !readValue(fp, column.offset) || !readValue(fp, column.size))
+        {
+            error = "The column descriptions of " + path + " are truncated";
+            return false;
+        }
+        column.kind = static_cast<ExportColumnKind>(kind);
+        columns.emplace_back(std::move(column));
+    }
+    // the entry count comes straight from the file, the columns have to fit in what's left of it before they're allocated
+    auto dataStart = fp.tellg();
+    fp.seekg(0, std::ios::end);
+    uint64_t remaining = static_cast<uint64_t>(fp.tellg() - dataStart);
+    fp.seekg(dataStart);
+    columnData.clear();
+    for (const auto& column : columns)
+    {
+        if (column.size != 0 && entryCount > remaining / column.size)
+        {
+            error = "The data of column " + column.name + " in " + path + " is truncated";
+            return false;
+        }
+        remaining -= entryCount * column.size;
+        auto& data = columnData.emplace_back(static_cast<size_t>(entryCount * column.size));
+        if (!fp.read(reinterpret_cast<char*>(data.data()), data.size()))
+        {
+            error = "The data of column " + column.name + " in " + path + " is truncated";
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t S2Plugin::DatabaseExport::rawValue(size_t column, size_t entry) const
+{
+    auto size = columns.at(column).size;
+    return rawFromBytes(columnData.at(column).data() + (entry * size), size);
+}
+
+std::string S2Plugin::DatabaseExport::formatValue(size_t column, size_t entry) const
+{
+    return formatExportValue(columns.at(column), rawValue(column, entry));
+}
+
+std::string S2Plugin::formatExportValue(const ExportColumn& column, uint64_t raw)
+{
+    char buffer[32];
+    switch (column.kind)
+    {
+        case ExportColumnKind::Signed:
+        {
+            auto shift = 64 - (std::clamp<size_t>(column.size, 1, 8) * 8);
+            snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(static_cast<int64_t>(raw << shift) >> shift));
+            break;
+        }
+        case ExportColumnKind::Float:
+        {
+            if (column.size == sizeof(double))
+            {
+                double d;
+                std::memcpy(&d, &raw, sizeof(double));
+                snprintf(buffer, sizeof(buffer), "%.17g", d);
+            }
+            else
+            {
+                float f;
+                auto bits = static_cast<uint32_t>(raw);
+                std::memcpy(&f, &bits, sizeof(float));
+                snprintf(buffer, sizeof(buffer), "%.9g", f);
+            }
+            break;
+        }
+        case ExportColumnKind::Bool:
+            return raw != 0 ? "True" : "False";
+        case ExportColumnKind::Hex:
+            snprintf(buffer, sizeof(buffer), "0x%0*llX", static_cast<int>(column.size * 2), static_cast<unsigned long long>(raw));
+            break;
+        default:
+            snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(raw));
+            break;
+    }
+    return buffer;
+}
+
+std::vector<std::string> S2Plugin::diffDatabaseExports(const DatabaseExport& before, const DatabaseExport& after, size_t maxChangedEntries)
+{
+    std::vector<std::string> report;
+    if (before.tableName != after.tableName)
+    {
+        report.emplace_back("Table: " + before.tableName + " -> " + after.tableName);
+    }
+    if (before.entryCount != after.entryCount)
+    {
+        report.emplace_back("Entry count: " + std::to_string(before.entryCount) + " -> " + std::to_string(after.entryCount));
+    }
+
+    std::unordered_map<std::string, size_t> afterColumns;
+    for (size_t c = 0; c < after.columns.size(); ++c)
+    {
+        afterColumns[after.columns[c].name] = c;
+    }
+    std::vector<std::pair<size_t, size_t>> matched;
+    for (size_t c = 0; c < before.columns.size(); ++c)
+    {
+        const auto& column = before.columns[c];
+        auto it = afterColumns.find(column.name);
+        if (it == afterColumns.end())
+        {
+            report.emplace_back("Column removed: " + column.name);
+            continue;
+        }
+        const auto& other = after.columns[it->second];
+        if (other.size != column.size)
+        {
+            report.emplace_back("Column resized: " + column.name + " (" + std::to_string(column.size) + " -> " + std::to_string(other.size) + " bytes)");
+        }
+        else
+        {
+            matched.emplace_back(c, it->second);
+        }
+        afterColumns.erase(it);
+    }
+    for (const auto& column : after.columns)
+    {
+        if (afterColumns.count(column.name) > 0)
+        {
+            report.emplace_back("Column added: " + column.name);
+        }
+    }
+
+    // compare column against column; most columns are identical, which a single memcmp settles
+    auto commonEntries = static_cast<size_t>((std::min)(before.entryCount, after.entryCount));
+    std::map<size_t, std::vector<std::string>> changedEntries;
+    for (const auto& [b, a] : matched)
+    {
+        const auto& columnBefore = before.columnData[b];
+        const auto& columnAfter = after.columnData[a];
+        auto size = before.columns[b].size;
+        if (std::memcmp(columnBefore.data(), columnAfter.data(), commonEntries * size) == 0)
+        {
+            continue;
+        }
+        for (size_t x = 0; x < commonEntries; ++x)
+        {
+            if (std::memcmp(columnBefore.data() + (x * size), columnAfter.data() + (x * size), size) != 0)
+            {
+                changedEntries[x].emplace_back("    " + before.columns[b].name + ": " + before.formatValue(b, x) + " -> " + after.formatValue(a, x));
+            }
+        }
+    }
+
+    report.emplace_back(std::to_string(changedEntries.size()) + " of " + std::to_string(commonEntries) + " entries changed");
+    size_t listed = 0;
+    for (const auto& [entry, changes] : changedEntries)
+    {
+        if (listed++ == maxChangedEntries)
+        {
+            report.emplace_back("... and " + std::to_string(changedEntries.size() - maxChangedEntries) + " more entries");
+            break;
+        }
+        report.emplace_back("Entry " + std::to_string(entry) + ":");
+        report.insert(report.end(), changes.begin(), changes.end());
+    }
+    if (after.entryCount > commonEntries)
+    {
+        report.emplace_back("Entries added: " + std::to_string(commonEntries) + " up to " + std::to_string(after.entryCount - 1));
+    }
+    if (before.entryCount > commonEntries)
+    {
+        report.emplace_back("Entries removed: " + std::to_string(commonEntries) + " up to " + std::to_string(before.entryCount - 1));
+    }
+    return report;
+}
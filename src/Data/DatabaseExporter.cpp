@@ -0,0 +1,92 @@
+#include "Data/DatabaseExporter.h"
+#include "Configuration.h"
+#include "Spelunky2.h"
+#include "pluginmain.h"
+#include <algorithm>
+
+S2Plugin::DatabaseExporter::DatabaseExporter(Configuration* config) : MemoryMappedData(config) {}
+
+bool S2Plugin::DatabaseExporter::exportTable(const std::string& tableName, MemoryFieldType entryType, const DatabaseTableLayout& layout, const std::string& path, const std::string& csvPath,
+                                             std::string& error)
+{
+    if (layout.address == 0 || layout.entrySize == 0)
+    {
+        error = tableName + " isn't loaded";
+        return false;
+    }
+
+    std::vector<EntityScalarField> fields;
+    size_t offset = 0;
+    collectScalarFields(mConfiguration->typeFields(entryType), tableName + ".", offset, fields);
+    std::vector<ExportColumn> columns;
+    for (const auto& field : fields)
+    {
+        if (field.offset + field.size <= layout.entrySize)
+        {
+            columns.emplace_back(ExportColumn{field.name, exportColumnKind(field.type), static_cast<uint32_t>(field.offset), static_cast<uint8_t>(field.size)});
+        }
+    }
+
+    DatabaseExportWriter writer;
+    if (!writer.open(path, csvPath, tableName, layout.entryCount, layout.entrySize, columns))
+    {
+        error = writer.error();
+        return false;
+    }
+    for (size_t first = 0; first < layout.entryCount; first += msChunkEntries)
+    {
+        auto count = (std::min)(msChunkEntries, layout.entryCount - first);
+        mBuffer.resize(count * layout.entrySize);
+        if (!Script::Memory::Read(layout.address + (first * layout.entrySize), mBuffer.data(), mBuffer.size(), nullptr))
+        {
+            writer.close();
+            error = "Could not read entries " + std::to_string(first) + " up to " + std::to_string(first + count - 1) + " of " + tableName;
+            return false;
+        }
+        if (!writer.writeEntries(first, mBuffer.data(), count))
+        {
+            writer.close();
+            error = writer.error();
+            return false;
+        }
+    }
+    if (!writer.close())
+    {
+        error = "Could not finish writing " + path;
+        return false;
+    }
+    return true;
+}
+
+S2Plugin::ExportColumnKind S2Plugin::DatabaseExporter::exportColumnKind(MemoryFieldType type) noexcept
+{
+    switch (type)
+    {
+        case MemoryFieldType::Float:
+            return ExportColumnKind::Float;
+        case MemoryFieldType::Bool:
+            return ExportColumnKind::Bool;
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::Word:
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::Qword:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::State16:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::CharacterDBID:
+        case MemoryFieldType::TextureDBID:
+            return ExportColumnKind::Signed;
+        case MemoryFieldType::Flags8:
+        case MemoryFieldType::Flags16:
+        case MemoryFieldType::Flags32:
+        case MemoryFieldType::CodePointer:
+        case MemoryFieldType::DataPointer:
+        case MemoryFieldType::EntityPointer:
+        case MemoryFieldType::EntityDBPointer:
+        case MemoryFieldType::TextureDBPointer:
+        case MemoryFieldType::ParticleDBPointer:
+            return ExportColumnKind::Hex;
+        default:
+            return ExportColumnKind::Unsigned;
+    }
+}
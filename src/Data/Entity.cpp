@@ -11,11 +11,11 @@
 #include <regex>
 #include <string>
 
-S2Plugin::Entity::Entity(size_t offset, TreeViewMemoryFields* tree, WidgetMemoryView* memoryView, WidgetMemoryView* comparisonMemoryView, EntityDB* entityDB, S2Plugin::Configuration* config)
+S2Plugin::Entity::Entity(size_t offset, TreeViewMemoryFields* tree, WidgetMemoryView* memoryView, WidgetMemoryView* comparisonMemoryView, EntityDB* entityDB, State* state,
+                         S2Plugin::Configuration* config)
     : MemoryMappedData(config), mEntityPtr(offset), mTree(tree), mMemoryView(memoryView), mComparisonMemoryView(comparisonMemoryView)
 {
-    auto entityID = config->spelunky2()->getEntityTypeID(offset);
-    mEntityName = config->spelunky2()->getEntityName(offset, entityDB);
+    mEntityName = config->spelunky2()->getEntityName(offset, entityDB, state);
     for (const auto& [regexStr, entityClassType] : mConfiguration->defaultEntityClassTypes())
     {
         auto r = std::regex(regexStr);
@@ -89,6 +89,7 @@ void S2Plugin::Entity::refreshValues()
 
     // now update all the values in the treeview
     auto deltaReference = mMemoryOffsets.at("Entity.__vftable");
+    mTree->beginBatchUpdate();
     for (const auto& c : hierarchy)
     {
         MemoryField headerField;
@@ -97,6 +98,7 @@ void S2Plugin::Entity::refreshValues()
         headerField.jsonName = c;
         mTree->updateValueForField(headerField, c, mMemoryOffsets, deltaReference);
     }
+    mTree->endBatchUpdate();
 }
 
 void S2Plugin::Entity::populateTreeView()
@@ -361,37 +363,7 @@ std::vector<std::string> S2Plugin::Entity::classHierarchy() const
 
 size_t S2Plugin::Entity::findEntityByUID(uint32_t uidToSearch, State* state)
 {
-    auto searchUID = [state](uint32_t uid, size_t layerOffset) -> size_t
-    {
-        auto entityCount = (std::min)(Script::Memory::ReadDword(layerOffset + 28), 10000u);
-        auto entities = Script::Memory::ReadQword(layerOffset + 8);
-
-        for (auto x = 0; x < entityCount; ++x)
-        {
-            auto entityPtr = entities + (x * sizeof(size_t));
-            auto entity = Script::Memory::ReadQword(entityPtr);
-            auto entityUid = Script::Memory::ReadDword(entity + 56);
-            if (entityUid == uid)
-            {
-                return entity;
-            }
-        }
-        return 0;
-    };
-    auto layer = Script::Memory::ReadQword(state->offsetForField("layer0"));
-    auto result = searchUID(uidToSearch, layer);
-    if (result != 0)
-    {
-        return result;
-    }
-
-    layer = Script::Memory::ReadQword(state->offsetForField("layer1"));
-    result = searchUID(uidToSearch, layer);
-    if (result != 0)
-    {
-        return result;
-    }
-    return 0;
+    return state->locateEntityByUID(uidToSearch).entity;
 }
 
 size_t S2Plugin::Entity::totalMemorySize() const noexcept
@@ -20,6 +20,7 @@ bool S2Plugin::EntityDB::loadEntityDB()
     mEntityList = std::make_unique<EntityList>(mConfiguration->spelunky2());
 
     mMemoryOffsets.clear();
+    mCachedEntries.clear();
     auto instructionEntitiesPtr = Script::Pattern::FindMem(afterBundle, mConfiguration->spelunky2()->spelunky2AfterBundleSize(), "A4 84 E4 CA DA BF 4E 83");
     auto entitiesPtr = instructionEntitiesPtr - 33 + 7 + (duint)Script::Memory::ReadDword(instructionEntitiesPtr - 30);
     mEntityDBPtr = Script::Memory::ReadQword(entitiesPtr);
@@ -34,10 +35,39 @@ bool S2Plugin::EntityDB::loadEntityDB()
             offset = setOffsetForField(field, "EntityDB." + field.name, offset, offsets);
         }
         mMemoryOffsets.emplace_back(offsets);
+        if (x == 0)
+        {
+            mEntrySize = offset - mEntityDBPtr;
+        }
     }
     return true;
 }
 
+size_t S2Plugin::EntityDB::entrySize() const noexcept
+{
+    return mEntrySize;
+}
+
+S2Plugin::DatabaseTableLayout S2Plugin::EntityDB::tableLayout() const noexcept
+{
+    return DatabaseTableLayout{mEntityDBPtr, mMemoryOffsets.size(), mEntrySize};
+}
+
+size_t S2Plugin::EntityDB::offsetInEntry(const std::string& fieldName) const
+{
+    return mMemoryOffsets.at(0).at(fieldName) - mEntityDBPtr;
+}
+
+bool S2Plugin::EntityDB::readEntries(std::vector<uint8_t>& buffer)
+{
+    buffer.resize(mEntrySize * mMemoryOffsets.size());
+    if (mEntityDBPtr == 0 || buffer.empty())
+    {
+        return false;
+    }
+    return Script::Memory::Read(mEntityDBPtr, buffer.data(), buffer.size(), nullptr);
+}
+
 S2Plugin::EntityList* S2Plugin::EntityDB::entityList() const noexcept
 {
     return mEntityList.get();
@@ -48,7 +78,31 @@ std::unordered_map<std::string, size_t>& S2Plugin::EntityDB::offsetsForIndex(uin
     return mMemoryOffsets.at(entityDBIndex);
 }
 
+uint32_t S2Plugin::EntityDB::typeIDForEntityDBPointer(size_t entityDBPtr)
+{
+    return entityDBPtr == 0 ? 0 : cachedEntry(entityDBPtr).typeID;
+}
+
+uint32_t S2Plugin::EntityDB::searchMaskForEntityDBPointer(size_t entityDBPtr)
+{
+    return entityDBPtr == 0 ? 0 : cachedEntry(entityDBPtr).searchMask;
+}
+
+const S2Plugin::EntityDB::CachedEntry& S2Plugin::EntityDB::cachedEntry(size_t entityDBPtr)
+{
+    // the entries of the EntityDB don't move while the game runs, so one read per entry is enough
+    auto it = mCachedEntries.find(entityDBPtr);
+    if (it != mCachedEntries.end())
+    {
+        return it->second;
+    }
+    CachedEntry entry{0, 0}; // id at +20, search mask right behind it at +24
+    Script::Memory::Read(entityDBPtr + 20, &entry, sizeof(CachedEntry), nullptr);
+    return mCachedEntries.emplace(entityDBPtr, entry).first->second;
+}
+
 void S2Plugin::EntityDB::reset()
 {
     mEntityDBPtr = 0;
+    mCachedEntries.clear();
 }
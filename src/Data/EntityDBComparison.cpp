@@ -0,0 +1,200 @@
+#include "Data/EntityDBComparison.h"
+#include "Data/EntityDB.h"
+#include "Data/EntityList.h"
+#include "Spelunky2.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+    template <typename T> void extractColumn(const uint8_t* entries, size_t stride, size_t count, uint64_t* out)
+    {
+        // fixed width and no branches, the compiler turns this into a plain strided load/widen loop
+        for (size_t x = 0; x < count; ++x)
+        {
+            T value;
+            std::memcpy(&value, entries + (x * stride), sizeof(T));
+            out[x] = static_cast<uint64_t>(value);
+        }
+    }
+} // namespace
+
+S2Plugin::EntityDBComparison::EntityDBComparison(EntityDB* entityDB) : mEntityDB(entityDB), mType(MemoryFieldType::UnsignedDword) {}
+
+void S2Plugin::EntityDBComparison::invalidate()
+{
+    mEntriesValid = false;
+}
+
+void S2Plugin::EntityDBComparison::setField(size_t offset, size_t size, MemoryFieldType type, int8_t flagIndex)
+{
+    if (!mEntriesValid)
+    {
+        mEntriesValid = mEntityDB->readEntries(mEntries);
+    }
+    mType = type;
+    mSize = size;
+    mIsFlag = flagIndex >= 0;
+
+    auto stride = mEntityDB->entrySize();
+    auto count = stride == 0 ? 0 : mEntries.size() / stride;
+    mValues.assign(count, 0);
+    if (mEntriesValid && offset + size <= stride)
+    {
+        auto base = mEntries.data() + offset;
+        switch (size)
+        {
+            case 1:
+                extractColumn<uint8_t>(base, stride, count, mValues.data());
+                break;
+            case 2:
+                extractColumn<uint16_t>(base, stride, count, mValues.data());
+                break;
+            case 4:
+                extractColumn<uint32_t>(base, stride, count, mValues.data());
+                break;
+            case 8:
+                extractColumn<uint64_t>(base, stride, count, mValues.data());
+                break;
+        }
+        if (mIsFlag)
+        {
+            for (auto& value : mValues)
+            {
+                value = (value >> flagIndex) & 1;
+            }
+        }
+    }
+
+    auto entityList = mEntityDB->entityList();
+    mIDs.clear();
+    for (uint32_t id = 1; id < count; ++id)
+    {
+        if (entityList->isValidID(id))
+        {
+            mIDs.emplace_back(id);
+        }
+    }
+
+    std::unordered_map<uint64_t, size_t> groupIndices;
+    mGroups.clear();
+    for (auto id : mIDs)
+    {
+        auto [it, inserted] = groupIndices.emplace(mValues[id], mGroups.size());
+        if (inserted)
+        {
+            mGroups.emplace_back(mValues[id], std::vector<uint32_t>{});
+        }
+        mGroups[it->second].second.emplace_back(id);
+    }
+    std::sort(mGroups.begin(), mGroups.end(), [this](const auto& a, const auto& b) { return sortValue(a.first) < sortValue(b.first); });
+}
+
+void S2Plugin::EntityDBComparison::clear()
+{
+    mIDs.clear();
+    mValues.clear();
+    mGroups.clear();
+}
+
+S2Plugin::MemoryFieldType S2Plugin::EntityDBComparison::type() const noexcept
+{
+    return mType;
+}
+
+bool S2Plugin::EntityDBComparison::isFlag() const noexcept
+{
+    return mIsFlag;
+}
+
+size_t S2Plugin::EntityDBComparison::rowCount() const noexcept
+{
+    return mIDs.size();
+}
+
+uint32_t S2Plugin::EntityDBComparison::idAt(size_t row) const
+{
+    return mIDs.at(row);
+}
+
+uint64_t S2Plugin::EntityDBComparison::rawValueAt(size_t row) const
+{
+    return mValues.at(mIDs.at(row));
+}
+
+const std::vector<std::pair<uint64_t, std::vector<uint32_t>>>& S2Plugin::EntityDBComparison::groups() const noexcept
+{
+    return mGroups;
+}
+
+double S2Plugin::EntityDBComparison::sortValue(uint64_t raw) const
+{
+    if (mIsFlag)
+    {
+        return static_cast<double>(raw);
+    }
+    switch (mType)
+    {
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::CharacterDBID:
+            return static_cast<int8_t>(raw);
+        case MemoryFieldType::Word:
+        case MemoryFieldType::State16:
+            return static_cast<int16_t>(raw);
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::TextureDBID:
+            return static_cast<int32_t>(raw);
+        case MemoryFieldType::Qword:
+            return static_cast<double>(static_cast<int64_t>(raw));
+        case MemoryFieldType::Float:
+        {
+            float f;
+            auto bits = static_cast<uint32_t>(raw);
+            std::memcpy(&f, &bits, sizeof(float));
+            return f;
+        }
+        default:
+            return static_cast<double>(raw);
+    }
+}
+
+std::string S2Plugin::EntityDBComparison::formatValue(uint64_t raw) const
+{
+    char buffer[32];
+    if (mIsFlag || mType == MemoryFieldType::Bool)
+    {
+        return raw != 0 ? "True" : "False";
+    }
+    switch (mType)
+    {
+        case MemoryFieldType::CodePointer:
+        case MemoryFieldType::DataPointer:
+            snprintf(buffer, sizeof(buffer), "0x%016llX", raw);
+            break;
+        case MemoryFieldType::Float:
+            snprintf(buffer, sizeof(buffer), "%f", sortValue(raw));
+            break;
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::CharacterDBID:
+        case MemoryFieldType::Word:
+        case MemoryFieldType::State16:
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::TextureDBID:
+        case MemoryFieldType::Qword:
+        {
+            auto shift = 64 - (std::clamp<size_t>(mSize, 1, 8) * 8);
+            snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(static_cast<int64_t>(raw << shift) >> shift));
+            break;
+        }
+        default:
+            snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(raw));
+            break;
+    }
+    return buffer;
+}
@@ -0,0 +1,181 @@
+#include "Data/EntityGrid.h"
+#include "Configuration.h"
+#include "Data/EntityDB.h"
+#include "Data/State.h"
+#include "Data/StdMap.h"
+#include "Spelunky2.h"
+#include "pluginmain.h"
+#include <algorithm>
+#include <cstring>
+
+S2Plugin::EntityGrid::EntityGrid(Configuration* config, State* state, EntityDB* entityDB) : MemoryMappedData(config), mState(state), mEntityDB(entityDB) {}
+
+const std::vector<S2Plugin::EntityScalarField>& S2Plugin::EntityGrid::columns() const noexcept
+{
+    return mColumns;
+}
+
+void S2Plugin::EntityGrid::addColumn(const EntityScalarField& column)
+{
+    mColumns.emplace_back(column);
+    mColumnValues.emplace_back(mEntities.size(), 0);
+}
+
+void S2Plugin::EntityGrid::removeColumn(size_t index)
+{
+    if (index < mColumns.size())
+    {
+        mColumns.erase(mColumns.begin() + index);
+        mColumnValues.erase(mColumnValues.begin() + index);
+    }
+}
+
+void S2Plugin::EntityGrid::setSource(EntityGridLayer layer, uint32_t mask, const std::vector<uint32_t>& uids)
+{
+    mLayer = layer;
+    mMask = mask;
+    mUIDs = uids;
+}
+
+std::vector<size_t> S2Plugin::EntityGrid::acquireEntities() const
+{
+    std::vector<size_t> entities;
+    if (!mUIDs.empty())
+    {
+        for (auto uid : mUIDs)
+        {
+            auto entity = mState->locateEntityByUID(uid).entity;
+            if (entity != 0)
+            {
+                entities.emplace_back(entity);
+            }
+        }
+        return entities;
+    }
+
+    std::vector<size_t> layers;
+    if (mLayer == EntityGridLayer::Front || mLayer == EntityGridLayer::Both)
+    {
+        layers.emplace_back(Script::Memory::ReadQword(mState->offsetForField("layer0")));
+    }
+    if (mLayer == EntityGridLayer::Back || mLayer == EntityGridLayer::Both)
+    {
+        layers.emplace_back(Script::Memory::ReadQword(mState->offsetForField("layer1")));
+    }
+
+    auto appendPointerArray = [&entities](size_t arrayOffset, size_t count)
+    {
+        if (arrayOffset == 0 || count == 0)
+        {
+            return;
+        }
+        auto start = entities.size();
+        entities.resize(start + count);
+        if (!Script::Memory::Read(arrayOffset, entities.data() + start, count * sizeof(size_t), nullptr))
+        {
+            entities.resize(start);
+        }
+    };
+
+    for (auto layer : layers)
+    {
+        if (layer == 0)
+        {
+            continue;
+        }
+        if (mMask == 0)
+        {
+            appendPointerArray(Script::Memory::ReadQword(layer + 0x8), Script::Memory::ReadDword(layer + 0x1C));
+        }
+        else
+        {
+            StdMap<uint32_t, size_t> masks{layer + 0x40};
+            auto itr = masks.find(mMask);
+            if (itr != masks.end())
+            {
+                auto entityList = itr.value_ptr();
+                appendPointerArray(Script::Memory::ReadQword(entityList), Script::Memory::ReadDword(entityList + 20));
+            }
+        }
+    }
+    entities.erase(std::remove(entities.begin(), entities.end(), 0), entities.end());
+    return entities;
+}
+
+bool S2Plugin::EntityGrid::refresh()
+{
+    auto entities = acquireEntities();
+    bool sameRows = (entities == mEntities);
+    mEntities = std::move(entities);
+
+    auto rowCount = mEntities.size();
+    mEntityUIDs.resize(rowCount);
+    mEntityTypeIDs.resize(rowCount);
+    for (auto& values : mColumnValues)
+    {
+        values.resize(rowCount);
+    }
+
+    // one read per entity, spanning the header (db pointer at +8, uid at +56) and every column
+    size_t span = 0x40;
+    for (const auto& column : mColumns)
+    {
+        span = (std::max)(span, column.offset + column.size);
+    }
+    std::vector<uint8_t> buffer(span);
+    for (size_t row = 0; row < rowCount; ++row)
+    {
+        if (!Script::Memory::Read(mEntities[row], buffer.data(), span, nullptr))
+        {
+            std::fill(buffer.begin(), buffer.end(), 0);
+        }
+
+        size_t entityDBPtr = 0;
+        std::memcpy(&entityDBPtr, buffer.data() + 8, sizeof(size_t));
+        std::memcpy(&mEntityUIDs[row], buffer.data() + 56, sizeof(uint32_t));
+        mEntityTypeIDs[row] = mEntityDB->typeIDForEntityDBPointer(entityDBPtr);
+
+        for (size_t col = 0; col < mColumns.size(); ++col)
+        {
+            uint64_t value = 0;
+            std::memcpy(&value, buffer.data() + mColumns[col].offset, mColumns[col].size);
+            mColumnValues[col][row] = value;
+        }
+    }
+    return sameRows;
+}
+
+size_t S2Plugin::EntityGrid::rowCount() const noexcept
+{
+    return mEntities.size();
+}
+
+size_t S2Plugin::EntityGrid::entityAt(size_t row) const
+{
+    return mEntities.at(row);
+}
+
+uint32_t S2Plugin::EntityGrid::uidAt(size_t row) const
+{
+    return mEntityUIDs.at(row);
+}
+
+uint32_t S2Plugin::EntityGrid::typeIDAt(size_t row) const
+{
+    return mEntityTypeIDs.at(row);
+}
+
+std::string S2Plugin::EntityGrid::nameAt(size_t row) const
+{
+    auto typeID = mEntityTypeIDs.at(row);
+    if (typeID > 0 && typeID <= mEntityDB->entityList()->highestID())
+    {
+        return mEntityDB->entityList()->nameForID(typeID);
+    }
+    return "UNKNOWN/DEAD ENTITY";
+}
+
+uint64_t S2Plugin::EntityGrid::rawValue(size_t row, size_t column) const
+{
+    return mColumnValues.at(column).at(row);
+}
@@ -0,0 +1,355 @@
+#include "Data/EntityHeatmap.h"
+#include "pluginmain.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+S2Plugin::EntityHeatmap::~EntityHeatmap()
+{
+    stop();
+}
+
+void S2Plugin::EntityHeatmap::start(size_t layerPointerAddress, const std::vector<HeatmapLayer>& layers)
+{
+    stop();
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLayerPointerAddress = layerPointerAddress;
+        mGrids.clear();
+        for (const auto& layer : layers)
+        {
+            auto& grid = mGrids.emplace_back();
+            grid.layer = layer;
+            grid.counts.assign(msWidth * msHeight, 0);
+            grid.changed.assign(msWidth * msHeight, 0);
+        }
+        mAccumulatedFrames = 0;
+        mMissedFrames = 0;
+        mFramePending = false;
+        mRunning = true;
+    }
+    mEntityDBEntries.clear();
+    mWorker = std::thread(&EntityHeatmap::run, this);
+}
+
+void S2Plugin::EntityHeatmap::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRunning = false;
+    }
+    mWakeUp.notify_one();
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+}
+
+bool S2Plugin::EntityHeatmap::isRunning() const noexcept
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRunning;
+}
+
+void S2Plugin::EntityHeatmap::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& grid : mGrids)
+    {
+        // every cell that had a count needs repainting
+        markCountedCellsChanged(grid);
+        std::fill(grid.counts.begin(), grid.counts.end(), 0);
+        grid.maxCount = 0;
+    }
+    mAccumulatedFrames = 0;
+    mMissedFrames = 0;
+}
+
+void S2Plugin::EntityHeatmap::markAllChanged(size_t layer)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (layer < mGrids.size())
+    {
+        markCountedCellsChanged(mGrids[layer]);
+    }
+}
+
+void S2Plugin::EntityHeatmap::markCountedCellsChanged(Grid& grid)
+{
+    for (uint32_t x = 0; x < grid.counts.size(); ++x)
+    {
+        if (grid.counts[x] != 0 && grid.changed[x] == 0)
+        {
+            grid.changed[x] = 1;
+            grid.changedCells.emplace_back(x);
+        }
+    }
+}
+
+void S2Plugin::EntityHeatmap::frameAdvanced()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (!mRunning)
+        {
+            return;
+        }
+        if (mFramePending)
+        {
+            ++mMissedFrames;
+            return;
+        }
+        mFramePending = true;
+    }
+    mWakeUp.notify_one();
+}
+
+uint32_t S2Plugin::EntityHeatmap::takeChangedCells(size_t layer, std::vector<std::pair<uint32_t, uint32_t>>& cells)
+{
+    cells.clear();
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (layer >= mGrids.size())
+    {
+        return 0;
+    }
+    auto& grid = mGrids[layer];
+    cells.reserve(grid.changedCells.size());
+    for (auto cell : grid.changedCells)
+    {
+        cells.emplace_back(cell, grid.counts[cell]);
+        grid.changed[cell] = 0;
+    }
+    grid.changedCells.clear();
+    return grid.maxCount;
+}
+
+uint64_t S2Plugin::EntityHeatmap::accumulatedFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mAccumulatedFrames;
+}
+
+uint64_t S2Plugin::EntityHeatmap::missedFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mMissedFrames;
+}
+
+std::chrono::microseconds S2Plugin::EntityHeatmap::lastAccumulationDuration() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastAccumulationDuration;
+}
+
+uint32_t S2Plugin::EntityHeatmap::lastReadCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastReadCount;
+}
+
+size_t S2Plugin::EntityHeatmap::lastEntityCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastEntityCount;
+}
+
+uint32_t S2Plugin::EntityHeatmap::lastFailedSpanCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastFailedSpanCount;
+}
+
+uint32_t S2Plugin::EntityHeatmap::lastUnreadableEntityCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLastUnreadableEntityCount;
+}
+
+void S2Plugin::EntityHeatmap::run()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeUp.wait(lock, [this] { return !mRunning || mFramePending; });
+            if (!mRunning)
+            {
+                return;
+            }
+        }
+        accumulate();
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFramePending = false;
+    }
+}
+
+void S2Plugin::EntityHeatmap::accumulate()
+{
+    auto start = std::chrono::steady_clock::now();
+    auto reads = acquire();
+
+    // resolve every entity to its absolute tile, outside of the lock
+    mBinned.clear();
+    mBinned.reserve(mAcquired.size());
+    for (const auto& e : mAcquired)
+    {
+        auto x = e.x;
+        auto y = e.y;
+        auto overlay = e.overlay;
+        for (uint8_t depth = 0; overlay != 0 && depth < 16; ++depth) // overlays don't nest deeply, but guard against garbage
+        {
+            auto it = mAcquiredIndex.find(overlay);
+            if (it == mAcquiredIndex.end())
+            {
+                break;
+            }
+            const auto& parent = mAcquired[it->second];
+            x += parent.x;
+            y += parent.y;
+            overlay = parent.overlay;
+        }
+        auto cellX = static_cast<int32_t>(std::floor(x));
+        auto cellY = static_cast<int32_t>(std::floor(y));
+        if (cellX < 0 || cellX >= msWidth || cellY < 0 || cellY >= msHeight)
+        {
+            continue;
+        }
+        mBinned.emplace_back(static_cast<uint32_t>((cellY * msWidth) + cellX), entityDBEntry(e.entityDBPointer));
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto& grid : mGrids)
+    {
+        for (const auto& [cell, entry] : mBinned)
+        {
+            switch (grid.layer.kind)
+            {
+                case HeatmapLayerKind::TypeID:
+                    if (entry.typeID != grid.layer.value)
+                    {
+                        continue;
+                    }
+                    break;
+                case HeatmapLayerKind::Mask:
+                    if ((entry.searchMask & grid.layer.value) != grid.layer.value)
+                    {
+                        continue;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            auto count = ++grid.counts[cell];
+            grid.maxCount = (std::max)(grid.maxCount, count);
+            if (grid.changed[cell] == 0)
+            {
+                grid.changed[cell] = 1;
+                grid.changedCells.emplace_back(cell);
+            }
+        }
+    }
+    ++mAccumulatedFrames;
+    mLastReadCount = reads;
+    mLastEntityCount = mAcquired.size();
+    mLastFailedSpanCount = mFailedSpans;
+    mLastUnreadableEntityCount = mUnreadableEntities;
+    mLastAccumulationDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+uint32_t S2Plugin::EntityHeatmap::acquire()
+{
+    mAcquired.clear();
+    mAcquiredIndex.clear();
+    mFailedSpans = 0;
+    mUnreadableEntities = 0;
+    uint32_t reads = 2;
+    auto layer = Script::Memory::ReadQword(mLayerPointerAddress);
+    if (layer == 0)
+    {
+        return reads;
+    }
+    size_t entityCount = (std::min)(static_cast<size_t>(Script::Memory::ReadDword(layer + 0x1C)), msMaxEntities);
+    mEntityPointers.resize(entityCount);
+    ++reads;
+    if (entityCount == 0 || !Script::Memory::Read(Script::Memory::ReadQword(layer + 0x8), mEntityPointers.data(), entityCount * sizeof(size_t), nullptr))
+    {
+        return reads;
+    }
+    mEntityPointers.erase(std::remove(mEntityPointers.begin(), mEntityPointers.end(), 0), mEntityPointers.end());
+    std::sort(mEntityPointers.begin(), mEntityPointers.end());
+    mEntityPointers.erase(std::unique(mEntityPointers.begin(), mEntityPointers.end()), mEntityPointers.end());
+
+    // entities near each other in memory are read together: one read per span instead of one per entity
+    size_t first = 0;
+    while (first < mEntityPointers.size())
+    {
+        auto spanStart = mEntityPointers[first];
+        auto last = first;
+        while (last + 1 < mEntityPointers.size() && mEntityPointers[last + 1] - mEntityPointers[last] <= msMaxSpanGap &&
+               mEntityPointers[last + 1] + msHeaderSize - spanStart <= msMaxSpanSize)
+        {
+            ++last;
+        }
+        auto spanSize = mEntityPointers[last] + msHeaderSize - spanStart;
+        mSpan.resize(spanSize);
+        ++reads;
+        if (Script::Memory::Read(spanStart, mSpan.data(), spanSize, nullptr))
+        {
+            for (auto x = first; x <= last; ++x)
+            {
+                addAcquired(mEntityPointers[x], mSpan.data() + (mEntityPointers[x] - spanStart));
+            }
+        }
+        else
+        {
+            // part of the span isn't readable (a gap between pools may be unmapped), fall back to the headers alone
+            ++mFailedSpans;
+            for (auto x = first; x <= last; ++x)
+            {
+                ++reads;
+                if (Script::Memory::Read(mEntityPointers[x], mSpan.data(), msHeaderSize, nullptr))
+                {
+                    addAcquired(mEntityPointers[x], mSpan.data());
+                }
+                else
+                {
+                    ++mUnreadableEntities;
+                }
+            }
+        }
+        first = last + 1;
+    }
+    return reads;
+}
+
+void S2Plugin::EntityHeatmap::addAcquired(size_t entity, const uint8_t* header)
+{
+    AcquiredEntity e;
+    e.entity = entity;
+    std::memcpy(&e.entityDBPointer, header + 0x8, sizeof(size_t));
+    std::memcpy(&e.overlay, header + 0x10, sizeof(size_t));
+    std::memcpy(&e.x, header + 0x40, sizeof(float));
+    std::memcpy(&e.y, header + 0x44, sizeof(float));
+    mAcquiredIndex[e.entity] = mAcquired.size();
+    mAcquired.emplace_back(e);
+}
+
+S2Plugin::EntityHeatmap::EntityDBEntry S2Plugin::EntityHeatmap::entityDBEntry(size_t entityDBPointer)
+{
+    // the entity database doesn't change while the game runs, so every entry is read once per recording
+    auto it = mEntityDBEntries.find(entityDBPointer);
+    if (it != mEntityDBEntries.end())
+    {
+        return it->second;
+    }
+    EntityDBEntry entry{0, 0};
+    if (entityDBPointer != 0)
+    {
+        uint32_t values[2] = {0, 0};
+        Script::Memory::Read(entityDBPointer + 20, values, sizeof(values), nullptr);
+        entry.typeID = values[0];
+        entry.searchMask = values[1];
+    }
+    mEntityDBEntries[entityDBPointer] = entry;
+    return entry;
+}
@@ -0,0 +1,630 @@
+#include "Data/EntityQuery.h"
+#include "Configuration.h"
+#include "Data/EntityDB.h"
+#include "Data/State.h"
+#include "Spelunky2.h"
+#include "pluginmain.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <regex>
+#include <stdexcept>
+#include <tuple>
+
+S2Plugin::EntityQuery::EntityQuery(Configuration* config, EntityDB* entityDB) : MemoryMappedData(config), mEntityDB(entityDB) {}
+
+bool S2Plugin::EntityQuery::compile(const std::string& expression)
+{
+    mProgram.clear();
+    mTypeSets.clear();
+    mClassTypeSets.clear();
+    mSnapshotSize = 0x50;
+    mMaxStackDepth = 0;
+    mUsesPosition = false;
+    mError.clear();
+
+    mScanner = ExpressionScanner(expression);
+    mStackDepth = 0;
+    if (mScanner.atEnd())
+    {
+        return true;
+    }
+
+    try
+    {
+        parseOr();
+        if (!mScanner.atEnd())
+        {
+            throw std::runtime_error("unexpected '" + std::string(1, mScanner.peek()) + "'");
+        }
+    }
+    catch (const std::exception& e)
+    {
+        mProgram.clear();
+        mError = std::string(e.what()) + " at position " + std::to_string(mScanner.position() + 1);
+        return false;
+    }
+    return true;
+}
+
+const std::string& S2Plugin::EntityQuery::error() const noexcept
+{
+    return mError;
+}
+
+bool S2Plugin::EntityQuery::empty() const noexcept
+{
+    return mProgram.empty() && mError.empty();
+}
+
+void S2Plugin::EntityQuery::evaluate(const std::vector<size_t>& entities, const std::vector<uint8_t>& layers, State* state, std::vector<uint8_t>& matches)
+{
+    matches.assign(entities.size(), empty() ? 1 : 0);
+    if (mProgram.empty() || entities.empty())
+    {
+        return;
+    }
+
+    // take the snapshot first: one read per entity into one contiguous buffer
+    std::vector<uint8_t> snapshot(entities.size() * mSnapshotSize);
+    std::vector<uint8_t> valid(entities.size(), 0);
+    for (size_t x = 0; x < entities.size(); ++x)
+    {
+        if (entities[x] != 0)
+        {
+            valid[x] = Script::Memory::Read(entities[x], snapshot.data() + (x * mSnapshotSize), mSnapshotSize, nullptr) ? 1 : 0;
+        }
+    }
+
+    float playerX = 0;
+    float playerY = 0;
+    if (mUsesPosition)
+    {
+        auto player = Script::Memory::ReadQword(state->offsetForField("items.player1"));
+        if (player != 0)
+        {
+            std::tie(playerX, playerY) = state->entityAbsolutePosition(player, mEntityDB);
+        }
+    }
+
+    std::vector<double> stack(mMaxStackDepth + 1);
+    for (size_t x = 0; x < entities.size(); ++x)
+    {
+        if (valid[x] == 0)
+        {
+            continue;
+        }
+        const uint8_t* entity = snapshot.data() + (x * mSnapshotSize);
+        size_t entityDBPtr;
+        uint32_t uid;
+        std::memcpy(&entityDBPtr, entity + 0x8, sizeof(size_t));
+        std::memcpy(&uid, entity + 0x38, sizeof(uint32_t));
+        auto typeID = mEntityDB->typeIDForEntityDBPointer(entityDBPtr);
+
+        float entityX = 0;
+        float entityY = 0;
+        if (mUsesPosition)
+        {
+            size_t overlay;
+            std::memcpy(&overlay, entity + 0x10, sizeof(size_t));
+            if (overlay == 0)
+            {
+                std::memcpy(&entityX, entity + 0x40, sizeof(float));
+                std::memcpy(&entityY, entity + 0x44, sizeof(float));
+            }
+            else
+            {
+                std::tie(entityX, entityY) = state->entityAbsolutePosition(entities[x], mEntityDB);
+            }
+        }
+
+        size_t sp = 0;
+        bool rejected = false;
+        for (const auto& instruction : mProgram)
+        {
+            switch (instruction.opcode)
+            {
+                case Opcode::Constant:
+                    stack[sp++] = instruction.constant;
+                    break;
+                case Opcode::Field:
+                {
+                    const auto& typeSet = mTypeSets[instruction.typeSet];
+                    if (typeID >= typeSet.size() || typeSet[typeID] == 0)
+                    {
+                        rejected = true; // the entity doesn't have this field
+                        break;
+                    }
+                    uint64_t raw = 0;
+                    std::memcpy(&raw, entity + instruction.offset, instruction.size);
+                    double value;
+                    if (instruction.kind == FieldKind::Float)
+                    {
+                        float f;
+                        std::memcpy(&f, &raw, sizeof(float));
+                        value = f;
+                    }
+                    else if (instruction.kind == FieldKind::Signed)
+                    {
+                        auto shift = 64 - (instruction.size * 8);
+                        value = static_cast<double>(static_cast<int64_t>(raw << shift) >> shift);
+                    }
+                    else
+                    {
+                        value = static_cast<double>(raw);
+                    }
+                    stack[sp++] = value;
+                    break;
+                }
+                case Opcode::UID:
+                    stack[sp++] = uid;
+                    break;
+                case Opcode::Type:
+                    stack[sp++] = typeID;
+                    break;
+                case Opcode::Mask:
+                    stack[sp++] = mEntityDB->searchMaskForEntityDBPointer(entityDBPtr);
+                    break;
+                case Opcode::Layer:
+                    stack[sp++] = layers[x];
+                    break;
+                case Opcode::X:
+                    stack[sp++] = entityX;
+                    break;
+                case Opcode::Y:
+                    stack[sp++] = entityY;
+                    break;
+                case Opcode::Distance:
+                    stack[sp++] = std::hypot(entityX - playerX, entityY - playerY);
+                    break;
+                case Opcode::TypeIn:
+                {
+                    const auto& typeSet = mTypeSets[instruction.typeSet];
+                    stack[sp++] = (typeID < typeSet.size() && typeSet[typeID] != 0) ? 1 : 0;
+                    break;
+                }
+                case Opcode::Negate:
+                    stack[sp - 1] = -stack[sp - 1];
+                    break;
+                case Opcode::Not:
+                    stack[sp - 1] = stack[sp - 1] == 0 ? 1 : 0;
+                    break;
+                default:
+                {
+                    auto rhs = stack[--sp];
+                    auto& lhs = stack[sp - 1];
+                    switch (instruction.opcode)
+                    {
+                        case Opcode::Add:
+                            lhs = lhs + rhs;
+                            break;
+                        case Opcode::Subtract:
+                            lhs = lhs - rhs;
+                            break;
+                        case Opcode::Multiply:
+                            lhs = lhs * rhs;
+                            break;
+                        case Opcode::Divide:
+                            lhs = rhs == 0 ? 0 : lhs / rhs;
+                            break;
+                        case Opcode::BitAnd:
+                            lhs = static_cast<double>(static_cast<uint64_t>(lhs) & static_cast<uint64_t>(rhs));
+                            break;
+                        case Opcode::Less:
+                            lhs = lhs < rhs ? 1 : 0;
+                            break;
+                        case Opcode::LessEqual:
+                            lhs = lhs <= rhs ? 1 : 0;
+                            break;
+                        case Opcode::Greater:
+                            lhs = lhs > rhs ? 1 : 0;
+                            break;
+                        case Opcode::GreaterEqual:
+                            lhs = lhs >= rhs ? 1 : 0;
+                            break;
+                        case Opcode::Equal:
+                            lhs = lhs == rhs ? 1 : 0;
+                            break;
+                        case Opcode::NotEqual:
+                            lhs = lhs != rhs ? 1 : 0;
+                            break;
+                        case Opcode::And:
+                            lhs = (lhs != 0 && rhs != 0) ? 1 : 0;
+                            break;
+                        case Opcode::Or:
+                            lhs = (lhs != 0 || rhs != 0) ? 1 : 0;
+                            break;
+                        default:
+                            break;
+                    }
+                    break;
+                }
+            }
+            if (rejected)
+            {
+                break;
+            }
+        }
+        matches[x] = (!rejected && sp == 1 && stack[0] != 0) ? 1 : 0;
+    }
+}
+
+void S2Plugin::EntityQuery::parseOr()
+{
+    parseAnd();
+    while (accept("||"))
+    {
+        parseAnd();
+        emitInstruction({Opcode::Or});
+    }
+}
+
+void S2Plugin::EntityQuery::parseAnd()
+{
+    parseNot();
+    while (accept("&&"))
+    {
+        parseNot();
+        emitInstruction({Opcode::And});
+    }
+}
+
+void S2Plugin::EntityQuery::parseNot()
+{
+    if (!mScanner.peekToken("!=") && accept("!"))
+    {
+        parseNot();
+        emitInstruction({Opcode::Not});
+        return;
+    }
+    parseComparison();
+}
+
+void S2Plugin::EntityQuery::parseComparison()
+{
+    parseSum();
+    // two character operators first, so that "<=" isn't taken for "<"
+    static const std::vector<std::pair<const char*, Opcode>> comparisons = {{"<=", Opcode::LessEqual}, {">=", Opcode::GreaterEqual}, {"==", Opcode::Equal}, {"!=", Opcode::NotEqual},
+                                                                             {"<", Opcode::Less},       {">", Opcode::Greater}};
+    for (const auto& [token, opcode] : comparisons)
+    {
+        if (accept(token))
+        {
+            parseSum();
+            emitInstruction({opcode});
+            return;
+        }
+    }
+}
+
+void S2Plugin::EntityQuery::parseSum()
+{
+    parseProduct();
+    while (true)
+    {
+        if (accept("+"))
+        {
+            parseProduct();
+            emitInstruction({Opcode::Add});
+        }
+        else if (accept("-"))
+        {
+            parseProduct();
+            emitInstruction({Opcode::Subtract});
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+void S2Plugin::EntityQuery::parseProduct()
+{
+    parseBitAnd();
+    while (true)
+    {
+        if (accept("*"))
+        {
+            parseBitAnd();
+            emitInstruction({Opcode::Multiply});
+        }
+        else if (accept("/"))
+        {
+            parseBitAnd();
+            emitInstruction({Opcode::Divide});
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+void S2Plugin::EntityQuery::parseBitAnd()
+{
+    parseUnary();
+    while (true)
+    {
+        if (!mScanner.peekToken("&&") && accept("&"))
+        {
+            parseUnary();
+            emitInstruction({Opcode::BitAnd});
+        }
+        else
+        {
+            return;
+        }
+    }
+}
+
+void S2Plugin::EntityQuery::parseUnary()
+{
+    if (accept("-"))
+    {
+        parseUnary();
+        emitInstruction({Opcode::Negate});
+        return;
+    }
+    parsePrimary();
+}
+
+void S2Plugin::EntityQuery::parsePrimary()
+{
+    if (mScanner.atEnd())
+    {
+        throw std::runtime_error("unexpected end of expression");
+    }
+
+    if (accept("("))
+    {
+        parseOr();
+        expect(")");
+        return;
+    }
+
+    auto c = mScanner.peek();
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+    {
+        Instruction instruction{Opcode::Constant};
+        if (!mScanner.number(instruction.constant))
+        {
+            throw std::runtime_error("invalid number");
+        }
+        emitInstruction(instruction);
+        return;
+    }
+
+    auto identifier = parseIdentifier();
+    if (identifier == "uid")
+    {
+        emitInstruction({Opcode::UID});
+    }
+    else if (identifier == "type")
+    {
+        emitInstruction({Opcode::Type});
+    }
+    else if (identifier == "mask")
+    {
+        emitInstruction({Opcode::Mask});
+    }
+    else if (identifier == "layer")
+    {
+        emitInstruction({Opcode::Layer});
+    }
+    else if (identifier == "x" || identifier == "y" || identifier == "distance")
+    {
+        mUsesPosition = true;
+        emitInstruction({identifier == "x" ? Opcode::X : (identifier == "y" ? Opcode::Y : Opcode::Distance)});
+    }
+    else if (identifier == "is")
+    {
+        expect("(");
+        auto className = parseIdentifier();
+        expect(")");
+        Instruction instruction{Opcode::TypeIn};
+        instruction.typeSet = typeSetForClass(className);
+        emitInstruction(instruction);
+    }
+    else if (identifier == "name")
+    {
+        expect("(");
+        auto namePart = parseString();
+        expect(")");
+        Instruction instruction{Opcode::TypeIn};
+        instruction.typeSet = typeSetForName(namePart);
+        emitInstruction(instruction);
+    }
+    else
+    {
+        // <class>.<field>, where the field may also be defined by one of the parent classes
+        auto dot = identifier.find('.');
+        if (dot == std::string::npos)
+        {
+            throw std::runtime_error("unknown identifier '" + identifier + "'");
+        }
+        auto className = identifier.substr(0, dot);
+        auto fieldPath = identifier.substr(dot + 1);
+        auto typeSet = typeSetForClass(className);
+
+        auto classFields = mClassFields.find(className);
+        if (classFields == mClassFields.end())
+        {
+            classFields = mClassFields.emplace(className, entityScalarFields(className)).first;
+        }
+        auto field = std::find_if(classFields->second.begin(), classFields->second.end(),
+                                  [&](const EntityScalarField& f) { return f.name == identifier || f.name.substr(f.name.find('.') + 1) == fieldPath; });
+        if (field == classFields->second.end())
+        {
+            throw std::runtime_error("'" + identifier + "' is not a numeric field of " + className);
+        }
+
+        Instruction instruction{Opcode::Field};
+        instruction.offset = static_cast<uint32_t>(field->offset);
+        instruction.size = static_cast<uint8_t>(field->size);
+        instruction.typeSet = typeSet;
+        switch (field->type)
+        {
+            case MemoryFieldType::Float:
+                instruction.kind = FieldKind::Float;
+                break;
+            case MemoryFieldType::Byte:
+            case MemoryFieldType::Word:
+            case MemoryFieldType::Dword:
+            case MemoryFieldType::Qword:
+            case MemoryFieldType::State8:
+            case MemoryFieldType::State16:
+            case MemoryFieldType::State32:
+                instruction.kind = FieldKind::Signed;
+                break;
+            default:
+                instruction.kind = FieldKind::Unsigned;
+                break;
+        }
+        mSnapshotSize = (std::max)(mSnapshotSize, field->offset + field->size);
+        emitInstruction(instruction);
+    }
+}
+
+bool S2Plugin::EntityQuery::accept(const char* token)
+{
+    return mScanner.accept(token);
+}
+
+void S2Plugin::EntityQuery::expect(const char* token)
+{
+    if (!accept(token))
+    {
+        throw std::runtime_error(std::string("expected '") + token + "'");
+    }
+}
+
+std::string S2Plugin::EntityQuery::parseIdentifier()
+{
+    auto identifier = mScanner.name("_.?");
+    if (identifier.empty())
+    {
+        throw std::runtime_error("expected a name");
+    }
+    return identifier;
+}
+
+std::string S2Plugin::EntityQuery::parseString()
+{
+    expect("\"");
+    std::string str;
+    if (!mScanner.until('"', str))
+    {
+        throw std::runtime_error("unterminated string");
+    }
+    return str;
+}
+
+void S2Plugin::EntityQuery::emitInstruction(const Instruction& instruction)
+{
+    switch (instruction.opcode)
+    {
+        case Opcode::Negate:
+        case Opcode::Not:
+            break;
+        case Opcode::Constant:
+        case Opcode::Field:
+        case Opcode::UID:
+        case Opcode::Type:
+        case Opcode::Mask:
+        case Opcode::Layer:
+        case Opcode::X:
+        case Opcode::Y:
+        case Opcode::Distance:
+        case Opcode::TypeIn:
+            mMaxStackDepth = (std::max)(mMaxStackDepth, ++mStackDepth);
+            break;
+        default:
+            --mStackDepth;
+            break;
+    }
+    mProgram.emplace_back(instruction);
+}
+
+uint32_t S2Plugin::EntityQuery::typeSetForClass(const std::string& className)
+{
+    auto& ech = mConfiguration->entityClassHierarchy();
+    if (className != "Entity" && ech.count(className) == 0)
+    {
+        throw std::runtime_error("unknown entity class '" + className + "'");
+    }
+    auto it = mClassTypeSets.find(className);
+    if (it != mClassTypeSets.end())
+    {
+        return it->second;
+    }
+
+    auto entityList = mEntityDB->entityList();
+    if (mClassOfType.empty())
+    {
+        // the same name based class assignment as the entity window uses
+        std::vector<std::pair<std::regex, std::string>> classRegexes;
+        for (const auto& [regexStr, entityClassType] : mConfiguration->defaultEntityClassTypes())
+        {
+            classRegexes.emplace_back(std::regex(regexStr), entityClassType);
+        }
+        mClassOfType.resize(entityList->highestID() + 1, "Entity");
+        for (const auto& [id, name] : entityList->entries())
+        {
+            for (const auto& [r, entityClassType] : classRegexes)
+            {
+                if (std::regex_match(name, r))
+                {
+                    mClassOfType[id] = entityClassType;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> typeSet(mClassOfType.size(), 0);
+    for (size_t id = 0; id < mClassOfType.size(); ++id)
+    {
+        std::string t = mClassOfType[id];
+        while (true)
+        {
+            if (t == className)
+            {
+                typeSet[id] = 1;
+                break;
+            }
+            auto ech_it = ech.find(t);
+            if (t == "Entity" || ech_it == ech.end())
+            {
+                break;
+            }
+            t = ech_it->second;
+        }
+    }
+    mTypeSets.emplace_back(std::move(typeSet));
+    auto index = static_cast<uint32_t>(mTypeSets.size() - 1);
+    mClassTypeSets[className] = index;
+    return index;
+}
+
+uint32_t S2Plugin::EntityQuery::typeSetForName(const std::string& namePart)
+{
+    auto lowerCase = [](std::string s)
+    {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return s;
+    };
+    auto needle = lowerCase(namePart);
+    auto entityList = mEntityDB->entityList();
+    std::vector<uint8_t> typeSet(entityList->highestID() + 1, 0);
+    for (const auto& [id, name] : entityList->entries())
+    {
+        if (id < typeSet.size() && lowerCase(name).find(needle) != std::string::npos)
+        {
+            typeSet[id] = 1;
+        }
+    }
+    mTypeSets.emplace_back(std::move(typeSet));
+    return static_cast<uint32_t>(mTypeSets.size() - 1);
+}
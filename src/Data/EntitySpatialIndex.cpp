@@ -0,0 +1,183 @@
+#include "Data/EntitySpatialIndex.h"
+#include "Data/State.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+namespace
+{
+    // one cell per tile of the largest level, whatever the entities in the snapshot are doing
+    constexpr int32_t gsGridWidth = static_cast<int32_t>(S2Plugin::EntitySpatialIndex::msLevelMaxWidth) + 1;
+    constexpr int32_t gsGridHeight = static_cast<int32_t>(S2Plugin::EntitySpatialIndex::msLevelMaxHeight) + 1;
+} // namespace
+
+void S2Plugin::EntitySpatialIndex::build(const std::vector<size_t>& entities, State* state, EntityDB* entityDB)
+{
+    mAcquired.clear();
+    mAcquired.reserve(entities.size());
+    for (auto entity : entities)
+    {
+        if (entity == 0)
+        {
+            continue;
+        }
+        auto header = state->entityHeader(entity, entityDB);
+        auto x = header.x;
+        auto y = header.y;
+        if (header.overlay != 0)
+        {
+            std::tie(x, y) = state->entityAbsolutePosition(entity, entityDB);
+        }
+        mAcquired.emplace_back(SpatialEntity{entity, header.uid, header.typeID, header.searchMask, x, y});
+    }
+    rebuild(mAcquired);
+}
+
+void S2Plugin::EntitySpatialIndex::rebuild(const std::vector<SpatialEntity>& entities)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // counting sort on cell, the entities outside of the level are set aside
+    constexpr auto cellCount = static_cast<size_t>(gsGridWidth) * gsGridHeight;
+    constexpr auto noCell = (std::numeric_limits<uint32_t>::max)();
+    mCellStart.assign(cellCount + 1, 0);
+    mCellOfEntity.resize(entities.size());
+    mOverflow.clear();
+    for (size_t x = 0; x < entities.size(); ++x)
+    {
+        const auto& e = entities[x];
+        if (!insideGrid(e.x, e.y))
+        {
+            mCellOfEntity[x] = noCell;
+            mOverflow.emplace_back(e);
+            continue;
+        }
+        auto cell = static_cast<uint32_t>((cellY(e.y) * gsGridWidth) + cellX(e.x));
+        mCellOfEntity[x] = cell;
+        ++mCellStart[cell + 1];
+    }
+    for (size_t c = 0; c < cellCount; ++c)
+    {
+        mCellStart[c + 1] += mCellStart[c];
+    }
+    mEntities.resize(entities.size() - mOverflow.size());
+    for (size_t x = 0; x < entities.size(); ++x)
+    {
+        // mCellStart[cell] is used as the insert position and ends up at the start of the next cell, shift back afterwards
+        if (mCellOfEntity[x] != noCell)
+        {
+            mEntities[mCellStart[mCellOfEntity[x]]++] = entities[x];
+        }
+    }
+    for (size_t c = cellCount; c > 0; --c)
+    {
+        mCellStart[c] = mCellStart[c - 1];
+    }
+    mCellStart[0] = 0;
+
+    mLastRebuildDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+const std::vector<S2Plugin::SpatialEntity>& S2Plugin::EntitySpatialIndex::entities() const noexcept
+{
+    return mEntities;
+}
+
+const std::vector<S2Plugin::SpatialEntity>& S2Plugin::EntitySpatialIndex::overflow() const noexcept
+{
+    return mOverflow;
+}
+
+void S2Plugin::EntitySpatialIndex::queryRect(float left, float bottom, float right, float top, std::vector<const SpatialEntity*>& result) const
+{
+    result.clear();
+    if (left > right || bottom > top)
+    {
+        return;
+    }
+    auto inRect = [&](const SpatialEntity& e) { return e.x >= left && e.x <= right && e.y >= bottom && e.y <= top; };
+    if (!mEntities.empty() && right >= 0 && left < gsGridWidth && top >= 0 && bottom < gsGridHeight)
+    {
+        auto fromX = cellX(left);
+        auto toX = cellX(right);
+        auto fromY = cellY(bottom);
+        auto toY = cellY(top);
+        for (auto y = fromY; y <= toY; ++y)
+        {
+            // the cells of a row are contiguous
+            auto rowStart = mCellStart[(y * gsGridWidth) + fromX];
+            auto rowEnd = mCellStart[(y * gsGridWidth) + toX + 1];
+            for (auto i = rowStart; i < rowEnd; ++i)
+            {
+                if (inRect(mEntities[i]))
+                {
+                    result.emplace_back(&mEntities[i]);
+                }
+            }
+        }
+    }
+    for (const auto& e : mOverflow)
+    {
+        if (inRect(e))
+        {
+            result.emplace_back(&e);
+        }
+    }
+}
+
+void S2Plugin::EntitySpatialIndex::queryRadius(float x, float y, float radius, std::vector<const SpatialEntity*>& result) const
+{
+    queryRect(x - radius, y - radius, x + radius, y + radius, result);
+    auto radiusSquared = radius * radius;
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [&](const SpatialEntity* e) { return ((e->x - x) * (e->x - x)) + ((e->y - y) * (e->y - y)) > radiusSquared; }),
+                 result.end());
+}
+
+const S2Plugin::SpatialEntity* S2Plugin::EntitySpatialIndex::nearest(float x, float y, float maxDistance) const
+{
+    std::vector<const SpatialEntity*> candidates;
+    queryRadius(x, y, maxDistance, candidates);
+    const SpatialEntity* best = nullptr;
+    float bestDistance = 0;
+    for (auto e : candidates)
+    {
+        auto distance = ((e->x - x) * (e->x - x)) + ((e->y - y) * (e->y - y));
+        if (best == nullptr || distance < bestDistance)
+        {
+            best = e;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+std::chrono::microseconds S2Plugin::EntitySpatialIndex::lastRebuildDuration() const noexcept
+{
+    return mLastRebuildDuration;
+}
+
+bool S2Plugin::EntitySpatialIndex::insideGrid(float x, float y) noexcept
+{
+    // also false for NaN
+    return x >= 0 && x < gsGridWidth && y >= 0 && y < gsGridHeight;
+}
+
+int32_t S2Plugin::EntitySpatialIndex::cellX(float x) noexcept
+{
+    if (!std::isfinite(x))
+    {
+        return 0;
+    }
+    return static_cast<int32_t>(std::clamp(x, 0.f, static_cast<float>(gsGridWidth - 1)));
+}
+
+int32_t S2Plugin::EntitySpatialIndex::cellY(float y) noexcept
+{
+    if (!std::isfinite(y))
+    {
+        return 0;
+    }
+    return static_cast<int32_t>(std::clamp(y, 0.f, static_cast<float>(gsGridHeight - 1)));
+}
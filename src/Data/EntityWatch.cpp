@@ -0,0 +1,232 @@
+#include "Data/EntityWatch.h"
+#include "Configuration.h"
+#include "Data/EntityDB.h"
+#include "Data/EntityList.h"
+#include "Data/State.h"
+#include "pluginmain.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    double decodeWatchedValue(S2Plugin::MemoryFieldType type, const uint8_t* data, size_t size)
+    {
+        using S2Plugin::MemoryFieldType;
+        uint64_t raw = 0;
+        std::memcpy(&raw, data, (std::min)(size, sizeof(uint64_t)));
+        switch (type)
+        {
+            case MemoryFieldType::Float:
+            {
+                float f;
+                auto bits = static_cast<uint32_t>(raw);
+                std::memcpy(&f, &bits, sizeof(float));
+                return f;
+            }
+            case MemoryFieldType::Byte:
+            case MemoryFieldType::State8:
+                return static_cast<int8_t>(raw);
+            case MemoryFieldType::Word:
+            case MemoryFieldType::State16:
+                return static_cast<int16_t>(raw);
+            case MemoryFieldType::Dword:
+            case MemoryFieldType::State32:
+                return static_cast<int32_t>(raw);
+            case MemoryFieldType::Qword:
+                return static_cast<double>(static_cast<int64_t>(raw));
+            default:
+                return static_cast<double>(raw);
+        }
+    }
+
+    // the field names start with the class that defines them, e.g. Movable.health
+    std::string classOfField(const S2Plugin::EntityScalarField& field)
+    {
+        return field.name.substr(0, field.name.find('.'));
+    }
+} // namespace
+
+S2Plugin::EntityWatch::EntityWatch(Configuration* config, State* state, EntityDB* entityDB) : MemoryMappedData(config), mState(state), mEntityDB(entityDB) {}
+
+bool S2Plugin::EntityWatch::addField(uint32_t uid, const EntityScalarField& field, std::string& error)
+{
+    auto entity = mState->locateEntityByUID(uid).entity;
+    if (entity == 0)
+    {
+        error = "there's no entity with uid " + std::to_string(uid);
+        return false;
+    }
+    auto typeID = mState->entityHeader(entity, mEntityDB).typeID;
+    auto className = classOfField(field);
+    if (!entityIsOfClass(typeID, className))
+    {
+        error = "entity " + std::to_string(uid) + " (" + mEntityDB->entityList()->nameForID(typeID) + ") is not a " + className;
+        return false;
+    }
+    mFields.emplace_back(WatchedField{uid, field});
+    updateReadPlan();
+    return true;
+}
+
+void S2Plugin::EntityWatch::removeField(size_t index)
+{
+    if (index < mFields.size())
+    {
+        mFields.erase(mFields.begin() + index);
+        updateReadPlan();
+    }
+}
+
+size_t S2Plugin::EntityWatch::fieldCount() const noexcept
+{
+    return mFields.size();
+}
+
+const S2Plugin::WatchedField& S2Plugin::EntityWatch::fieldAt(size_t index) const
+{
+    return mFields.at(index);
+}
+
+std::string S2Plugin::EntityWatch::entityNameAt(size_t index) const
+{
+    const auto& field = mFields.at(index);
+    for (const auto& entity : mEntities)
+    {
+        if (entity.uid == field.uid && entity.entity != 0)
+        {
+            return mEntityDB->entityList()->nameForID(entity.typeID);
+        }
+    }
+    return "";
+}
+
+void S2Plugin::EntityWatch::updateReadPlan()
+{
+    std::vector<WatchedEntity> entities;
+    for (size_t x = 0; x < mFields.size(); ++x)
+    {
+        auto it = std::find_if(entities.begin(), entities.end(), [&](const WatchedEntity& e) { return e.uid == mFields[x].uid; });
+        if (it == entities.end())
+        {
+            entities.emplace_back(WatchedEntity{mFields[x].uid});
+            it = entities.end() - 1;
+        }
+        it->fields.emplace_back(x);
+    }
+
+    for (auto& entity : entities)
+    {
+        // merge the byte ranges of the fields: overlapping (the same field watched twice, flags and their parent) or
+        // nearby ranges become one read
+        std::vector<ReadSpan> ranges;
+        for (auto fieldIndex : entity.fields)
+        {
+            ranges.emplace_back(ReadSpan{mFields[fieldIndex].field.offset, mFields[fieldIndex].field.size});
+        }
+        std::sort(ranges.begin(), ranges.end(), [](const ReadSpan& a, const ReadSpan& b) { return a.offset < b.offset; });
+        for (const auto& range : ranges)
+        {
+            if (!entity.spans.empty() && range.offset <= entity.spans.back().offset + entity.spans.back().size + msMaxSpanGap)
+            {
+                auto& span = entity.spans.back();
+                span.size = (std::max)(span.offset + span.size, range.offset + range.size) - span.offset;
+            }
+            else
+            {
+                entity.spans.emplace_back(range);
+            }
+        }
+    }
+    mEntities = std::move(entities);
+    mNextEntity = 0;
+}
+
+void S2Plugin::EntityWatch::refresh(std::chrono::microseconds budget)
+{
+    auto start = std::chrono::steady_clock::now();
+    mLastRefreshEntityCount = 0;
+    mLastRefreshReadCount = 0;
+
+    // always refresh at least one entity, even if the budget is too small for it
+    for (size_t count = 0; count < mEntities.size(); ++count)
+    {
+        if (count > 0 && std::chrono::steady_clock::now() - start >= budget)
+        {
+            break;
+        }
+        auto& entity = mEntities[mNextEntity];
+        mNextEntity = (mNextEntity + 1) % mEntities.size();
+        ++mLastRefreshEntityCount;
+
+        entity.entity = mState->locateEntityByUID(entity.uid).entity;
+        auto alive = entity.entity != 0;
+        // the uid may have been reused by an entity of another class, its fields would be garbage
+        auto anyClassMatches = false;
+        if (alive)
+        {
+            entity.typeID = mState->entityHeader(entity.entity, mEntityDB).typeID;
+            for (auto fieldIndex : entity.fields)
+            {
+                auto& watched = mFields[fieldIndex];
+                watched.classMatches = entityIsOfClass(entity.typeID, classOfField(watched.field));
+                anyClassMatches = anyClassMatches || watched.classMatches;
+            }
+        }
+        for (const auto& span : entity.spans)
+        {
+            if (!alive || !anyClassMatches)
+            {
+                break;
+            }
+            mBuffer.resize(span.size);
+            ++mLastRefreshReadCount;
+            if (!Script::Memory::Read(entity.entity + span.offset, mBuffer.data(), span.size, nullptr))
+            {
+                alive = false;
+                break;
+            }
+            for (auto fieldIndex : entity.fields)
+            {
+                auto& watched = mFields[fieldIndex];
+                if (watched.classMatches && watched.field.offset >= span.offset && watched.field.offset + watched.field.size <= span.offset + span.size)
+                {
+                    watched.history.emplace_back(decodeWatchedValue(watched.field.type, mBuffer.data() + (watched.field.offset - span.offset), watched.field.size));
+                    if (watched.history.size() > msHistoryLength)
+                    {
+                        watched.history.pop_front();
+                    }
+                }
+            }
+        }
+        for (auto fieldIndex : entity.fields)
+        {
+            mFields[fieldIndex].alive = alive;
+        }
+    }
+    mLastRefreshDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+size_t S2Plugin::EntityWatch::lastRefreshEntityCount() const noexcept
+{
+    return mLastRefreshEntityCount;
+}
+
+size_t S2Plugin::EntityWatch::lastRefreshReadCount() const noexcept
+{
+    return mLastRefreshReadCount;
+}
+
+std::chrono::microseconds S2Plugin::EntityWatch::lastRefreshDuration() const noexcept
+{
+    return mLastRefreshDuration;
+}
+
+bool S2Plugin::EntityWatch::entityIsOfClass(uint32_t typeID, const std::string& className)
+{
+    auto it = mClassHierarchyOfType.find(typeID);
+    if (it == mClassHierarchyOfType.end())
+    {
+        it = mClassHierarchyOfType.emplace(typeID, mConfiguration->classHierarchyOfEntity(mEntityDB->entityList()->nameForID(typeID))).first;
+    }
+    return std::find(it->second.begin(), it->second.end(), className) != it->second.end();
+}
@@ -0,0 +1,102 @@
+#include "Data/ExpressionScanner.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+S2Plugin::ExpressionScanner::ExpressionScanner(const std::string& source) : mSource(source) {}
+
+void S2Plugin::ExpressionScanner::skipWhitespace()
+{
+    while (mPosition < mSource.size() && std::isspace(static_cast<unsigned char>(mSource[mPosition])))
+    {
+        ++mPosition;
+    }
+}
+
+bool S2Plugin::ExpressionScanner::atEnd()
+{
+    skipWhitespace();
+    return mPosition == mSource.size();
+}
+
+char S2Plugin::ExpressionScanner::peek()
+{
+    skipWhitespace();
+    return mPosition < mSource.size() ? mSource[mPosition] : '\0';
+}
+
+bool S2Plugin::ExpressionScanner::peekToken(const char* token)
+{
+    skipWhitespace();
+    return mSource.compare(mPosition, std::strlen(token), token) == 0;
+}
+
+bool S2Plugin::ExpressionScanner::accept(const char* token)
+{
+    if (!peekToken(token))
+    {
+        return false;
+    }
+    mPosition += std::strlen(token);
+    return true;
+}
+
+bool S2Plugin::ExpressionScanner::number(double& value)
+{
+    skipWhitespace();
+    auto start = mSource.c_str() + mPosition;
+    char* end = nullptr;
+    if (mSource.compare(mPosition, 2, "0x") == 0 || mSource.compare(mPosition, 2, "0X") == 0)
+    {
+        // as an integer first, doubles don't hold every 64 bit value
+        value = static_cast<double>(std::strtoull(start, &end, 16));
+    }
+    else
+    {
+        value = std::strtod(start, &end);
+    }
+    if (end == start)
+    {
+        return false;
+    }
+    mPosition += end - start;
+    return true;
+}
+
+std::string S2Plugin::ExpressionScanner::name(const char* extraCharacters)
+{
+    skipWhitespace();
+    auto start = mPosition;
+    while (mPosition < mSource.size())
+    {
+        auto c = mSource[mPosition];
+        if (!std::isalnum(static_cast<unsigned char>(c)) && (c == '\0' || std::strchr(extraCharacters, c) == nullptr))
+        {
+            break;
+        }
+        ++mPosition;
+    }
+    return mSource.substr(start, mPosition - start);
+}
+
+bool S2Plugin::ExpressionScanner::until(char close, std::string& text)
+{
+    auto end = mSource.find(close, mPosition);
+    if (end == std::string::npos)
+    {
+        return false;
+    }
+    text = mSource.substr(mPosition, end - mPosition);
+    mPosition = end + 1;
+    return true;
+}
+
+const std::string& S2Plugin::ExpressionScanner::source() const noexcept
+{
+    return mSource;
+}
+
+size_t S2Plugin::ExpressionScanner::position() const noexcept
+{
+    return mPosition;
+}
@@ -0,0 +1,134 @@
+#include "Data/FrameClock.h"
+#include "Data/State.h"
+#include "pluginmain.h"
+#include <timeapi.h>
+
+S2Plugin::FrameClock::FrameClock(State* state, QObject* parent) : QObject(parent), mState(state) {}
+
+S2Plugin::FrameClock::~FrameClock()
+{
+    stop();
+}
+
+bool S2Plugin::FrameClock::subscribe()
+{
+    if (mSubscribers == 0)
+    {
+        if (!mState->loadState() || mState->frameCounterAddress() == 0)
+        {
+            return false;
+        }
+        start();
+    }
+    ++mSubscribers;
+    return true;
+}
+
+void S2Plugin::FrameClock::unsubscribe()
+{
+    if (mSubscribers == 0)
+    {
+        return;
+    }
+    if (--mSubscribers == 0)
+    {
+        stop();
+    }
+}
+
+bool S2Plugin::FrameClock::isRunning() const noexcept
+{
+    return mRunning;
+}
+
+void S2Plugin::FrameClock::reset()
+{
+    // the State is reset as well, so the counter address is stale
+    stop();
+    mSubscribers = 0;
+}
+
+uint32_t S2Plugin::FrameClock::latestFrame() const noexcept
+{
+    return mLatestFrame;
+}
+
+uint64_t S2Plugin::FrameClock::deliveredFrameCount() const noexcept
+{
+    return mDeliveredFrames;
+}
+
+uint64_t S2Plugin::FrameClock::missedFrameCount() const noexcept
+{
+    return mMissedFrames;
+}
+
+void S2Plugin::FrameClock::start()
+{
+    stop();
+    mDeliveredAny = false;
+    mDeliveredFrames = 0;
+    mMissedFrames = 0;
+    mDeliveryPending = false;
+    mRunning = true;
+    mWorker = std::thread(&FrameClock::poll, this, mState->frameCounterAddress());
+}
+
+void S2Plugin::FrameClock::stop()
+{
+    mRunning = false;
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+}
+
+void S2Plugin::FrameClock::poll(size_t frameCounterAddress)
+{
+    // the default timer resolution on Windows is ~15ms, which is coarser than a frame
+    timeBeginPeriod(1);
+    bool first = true;
+    uint32_t previous = 0;
+    while (mRunning)
+    {
+        uint32_t frame = 0;
+        if (Script::Memory::Read(frameCounterAddress, &frame, sizeof(frame), nullptr) && (first || frame != previous))
+        {
+            first = false;
+            previous = frame;
+            mLatestFrame = frame;
+            if (!mDeliveryPending.exchange(true))
+            {
+                QMetaObject::invokeMethod(this, "deliverFrame", Qt::QueuedConnection);
+            }
+        }
+        std::this_thread::sleep_for(msPollInterval);
+    }
+    timeEndPeriod(1);
+}
+
+void S2Plugin::FrameClock::deliverFrame()
+{
+    mDeliveryPending = false;
+    if (!mRunning)
+    {
+        return;
+    }
+    auto frame = mLatestFrame.load();
+    if (mDeliveredAny)
+    {
+        if (frame == mLastDeliveredFrame)
+        {
+            return;
+        }
+        // the counter only goes up, a jump back means a new session (restart, loading a save)
+        if (frame > mLastDeliveredFrame)
+        {
+            mMissedFrames += frame - mLastDeliveredFrame - 1;
+        }
+    }
+    mDeliveredAny = true;
+    mLastDeliveredFrame = frame;
+    ++mDeliveredFrames;
+    emit frameAdvanced(frame);
+}
@@ -1,9 +1,64 @@
 #include "Data/Logger.h"
+#include "Data/FrameClock.h"
+#include "Data/LoggerFieldReader.h"
+#include "Data/LoggerRecording.h"
+#include "Data/LoggerSampler.h"
+#include "Data/LoggerSession.h"
+#include "Data/State.h"
 #include "QtHelpers/ItemModelLoggerFields.h"
 #include "Spelunky2.h"
-#include "pluginmain.h"
+#include <algorithm>
+#include <cstring>
 
-S2Plugin::Logger::Logger(QObject* parent) : QObject(parent) {}
+namespace
+{
+    // sessions are told apart by color when compared, rather than fields
+    constexpr uint8_t gsSessionColorCount = 6;
+    const QColor gsSessionColors[gsSessionColorCount] = {
+        QColor(255, 255, 255), QColor(255, 120, 40), QColor(80, 170, 255), QColor(120, 230, 90), QColor(230, 90, 220), QColor(255, 220, 60),
+    };
+} // namespace
+
+S2Plugin::MemoryFieldType S2Plugin::LoggerField::columnType() const
+{
+    switch (kind)
+    {
+        case LoggerFieldKind::FlagBit:
+            return MemoryFieldType::Bool;
+        case LoggerFieldKind::Expression:
+            return MemoryFieldType::Float;
+        default:
+            return type;
+    }
+}
+
+S2Plugin::Logger::Logger(State* state, FrameClock* frameClock, QObject* parent)
+    : QObject(parent), mState(state), mFrameClock(frameClock), mSpanGap(LoggerFieldReader::msDefaultSpanGap)
+{
+}
+
+S2Plugin::Logger::~Logger()
+{
+    if (mSampler != nullptr)
+    {
+        mSampler->stop();
+        takeSamplerSamples();
+        mSampler.reset();
+    }
+    // closed while recording, keep what was taken so far
+    if (mRecording != nullptr && !mRecordingWritten)
+    {
+        flushChunks(true);
+        if (mRecording != nullptr)
+        {
+            mRecording->finish();
+        }
+    }
+    if (mFrameClockSubscribed)
+    {
+        mFrameClock->unsubscribe();
+    }
+}
 
 void S2Plugin::Logger::addField(const LoggerField& field)
 {
@@ -12,7 +67,7 @@ void S2Plugin::Logger::addField(const LoggerField& field)
         mTableModel->appendRow();
         mFields.emplace_back(field);
         mTableModel->appendRowEnd();
-        mSamples.clear();
+        clearSamples();
         emit fieldsChanged();
     }
 }
@@ -24,7 +79,7 @@ void S2Plugin::Logger::removeFieldAt(size_t fieldIndex)
         mTableModel->removeRow(fieldIndex);
         mFields.erase(mFields.begin() + fieldIndex);
         mTableModel->removeRowEnd();
-        mSamples.clear();
+        clearSamples();
         emit fieldsChanged();
     }
 }
@@ -49,221 +104,729 @@ size_t S2Plugin::Logger::fieldCount() const noexcept
     return mFields.size();
 }
 
-void S2Plugin::Logger::start(size_t samplePeriod, size_t duration)
+bool S2Plugin::Logger::start(size_t samplePeriod, size_t duration, const std::string& recordingPath)
 {
-    mSamples.clear();
+    if (!beginSession(recordingPath))
+    {
+        return false;
+    }
+    // the frame clock only tags the samples here, they are taken by the sampler thread
+    mFrameClockSubscribed = mFrameClock->subscribe();
+    mDurationTimer.reset();
 
-    mSampleTimer = std::make_unique<QTimer>(this);
-    mDurationTimer = std::make_unique<QTimer>(this);
-    QObject::connect(mSampleTimer.get(), &QTimer::timeout, this, &Logger::sample);
-    QObject::connect(mDurationTimer.get(), &QTimer::timeout, this, &Logger::durationEnded);
+    mSampler = std::make_unique<LoggerSampler>(*mReader, std::chrono::milliseconds(samplePeriod), std::chrono::seconds(duration), mFrameClockSubscribed ? mFrameClock : nullptr);
+    mSampler->start();
 
-    mSampleTimer->setTimerType(Qt::PreciseTimer);
-    mSampleTimer->setInterval(samplePeriod);
+    // the sampler ends by itself once the duration has passed, the drain notices
+    mDrainTimer = std::make_unique<QTimer>(this);
+    QObject::connect(mDrainTimer.get(), &QTimer::timeout, this, &Logger::drainSamples);
+    mDrainTimer->setInterval(msDrainInterval);
+    mDrainTimer->start();
+    return true;
+}
 
+bool S2Plugin::Logger::startOnFrames(size_t duration, const std::string& recordingPath)
+{
+    mFrameClockSubscribed = mFrameClock->subscribe();
+    if (!mFrameClockSubscribed)
+    {
+        mError = "The game's frame counter couldn't be found, sample on a timer instead";
+        return false;
+    }
+    if (!beginSession(recordingPath))
+    {
+        mFrameClock->unsubscribe();
+        mFrameClockSubscribed = false;
+        return false;
+    }
+    startDuration(duration);
+    mMissedFramesAtStart = mFrameClock->missedFrameCount();
+    QObject::connect(mFrameClock, &FrameClock::frameAdvanced, this, &Logger::frameAdvanced);
+    return true;
+}
+
+void S2Plugin::Logger::startDuration(size_t duration)
+{
+    mDurationTimer = std::make_unique<QTimer>(this);
+    QObject::connect(mDurationTimer.get(), &QTimer::timeout, this, &Logger::durationEnded);
     mDurationTimer->setTimerType(Qt::PreciseTimer);
     mDurationTimer->setSingleShot(true);
     mDurationTimer->setInterval(duration * 1000);
 
+    mDurationTimer->start();
+}
+
+void S2Plugin::Logger::clearSamples()
+{
+    mStartTime = std::chrono::steady_clock::now();
+    mOverruns = 0;
+    mDropped = 0;
+    mReadNanoseconds = 0;
+    mReadCount = 0;
+    mSampleFrames.clear();
+    mSampleTimes.clear();
+    mSampleCount = 0;
+    mResidentFirst = 0;
+    mSamples.clear();
+    mValueOffsets.clear();
+    mValuesSize = 0;
     for (const auto& field : mFields)
     {
-        std::vector<std::any> v;
-        mSamples[field.uuid] = v;
+        mValueOffsets.emplace_back(mValuesSize);
+        mValuesSize += mSamples.emplace_back(field.columnType()).valueSize();
     }
+    mValueBuffer.resize(mValuesSize);
 
-    mDurationTimer->start();
-    mSampleTimer->start();
+    mTriggerState = mTriggerEnabled ? TriggerState::Armed : TriggerState::Off;
+    mHasPreviousTriggerValue = false;
+    mPreTrigger.resize(mTriggerEnabled ? mTrigger.preTriggerSamples * (sizeof(uint32_t) + sizeof(uint64_t) + mValuesSize) : 0);
+    mPreTriggerNext = 0;
+    mPreTriggerCount = 0;
+    mTriggerSamples.clear();
+
+    mRecording.reset();
+    mRecordingWritten = false;
+    mFlushedCount = 0;
+    mDecodedChunks.clear();
+    mDecodedChunksSize = 0;
 }
 
-void S2Plugin::Logger::sample()
+bool S2Plugin::Logger::beginSession(const std::string& recordingPath)
 {
-    for (const auto& field : mFields)
+    clearSamples();
+    mError.clear();
+    if (mTriggerEnabled && mTrigger.fieldIndex >= mFields.size())
     {
-        switch (field.type)
+        mError = "The trigger's field isn't logged anymore";
+        return false;
+    }
+    // the paths and expressions are planned once, each sample only follows them
+    mReader = std::make_unique<LoggerFieldReader>();
+    if (!mReader->initialize(mFields, mState->offsetForField("layer0"), mState->offsetForField("layer1"), mSpanGap))
+    {
+        mError = mReader->error();
+        mReader.reset();
+        return false;
+    }
+    if (!recordingPath.empty())
+    {
+        mRecording = std::make_unique<LoggerRecording>();
+        if (!mRecording->create(recordingPath, mFields))
         {
-            case MemoryFieldType::Byte:
-            {
-                int8_t value = Script::Memory::ReadByte(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedByte:
-            case MemoryFieldType::Bool:
-            case MemoryFieldType::Flags8:
-            case MemoryFieldType::State8:
-            case MemoryFieldType::CharacterDBID:
-            {
-                uint8_t value = Script::Memory::ReadByte(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Word:
-            {
-                int16_t value = Script::Memory::ReadWord(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedWord:
-            case MemoryFieldType::Flags16:
-            case MemoryFieldType::State16:
-            {
-                uint16_t value = Script::Memory::ReadWord(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Dword:
-            {
-                int32_t value = Script::Memory::ReadDword(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedDword:
-            case MemoryFieldType::Flags32:
-            case MemoryFieldType::State32:
-            case MemoryFieldType::EntityDBID:
-            case MemoryFieldType::EntityUID:
-            case MemoryFieldType::ParticleDBID:
-            case MemoryFieldType::TextureDBID:
-            case MemoryFieldType::StringsTableID:
-            {
-                uint32_t value = Script::Memory::ReadDword(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Float:
-            {
-                uint32_t tmp = Script::Memory::ReadDword(field.memoryOffset);
-                float value = reinterpret_cast<float&>(tmp);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::Qword:
-            {
-                int64_t value = Script::Memory::ReadQword(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
-            case MemoryFieldType::UnsignedQword:
-            {
-                uint64_t value = Script::Memory::ReadQword(field.memoryOffset);
-                mSamples[field.uuid].emplace_back(value);
-                break;
-            }
+            mError = mRecording->error();
+            mRecording.reset();
+            return false;
         }
     }
+    return true;
 }
 
-void S2Plugin::Logger::durationEnded()
+void S2Plugin::Logger::drainSamples()
 {
-    mSampleTimer->stop();
-    emit samplingEnded();
+    if (mSampler == nullptr)
+    {
+        return;
+    }
+    takeSamplerSamples();
+    if (mSampler->finished() || mTriggerState == TriggerState::Done)
+    {
+        durationEnded();
+    }
 }
 
-std::pair<int64_t, int64_t> S2Plugin::Logger::sampleBounds(const LoggerField& field) const
+void S2Plugin::Logger::takeSamplerSamples()
 {
-    int64_t highest = std::numeric_limits<int64_t>::min(); // for all intents and purposes, the values should reasonably all fit in 2^64 / 2
-    int64_t lowest = std::numeric_limits<int64_t>::max();
-    if (mSamples.count(field.uuid) > 0)
+    mSampler->drain(
+        [this](const LoggerSampler::RecordHeader& header, const uint8_t* values) { takeSample(header.frame, header.microseconds, values); });
+    mOverruns = mSampler->overrunCount();
+    mDropped = mSampler->droppedCount();
+    mReadNanoseconds = mSampler->readNanoseconds();
+    mReadCount = mSampler->sampleCount();
+    flushChunks(false);
+}
+
+void S2Plugin::Logger::takeSample(uint32_t frame, uint64_t time, const uint8_t* values)
+{
+    if (mTriggerState == TriggerState::Off)
     {
-        const auto& samples = mSamples.at(field.uuid);
-        for (const auto& value : samples)
+        appendSample(frame, time, values);
+        return;
+    }
+    auto value = mSamples[mTrigger.fieldIndex].valueFromRaw(values + mValueOffsets[mTrigger.fieldIndex]);
+    auto fired = mHasPreviousTriggerValue && mTrigger.fires(mPreviousTriggerValue, value);
+    mPreviousTriggerValue = value;
+    mHasPreviousTriggerValue = true;
+
+    auto recordSize = sizeof(uint32_t) + sizeof(uint64_t) + mValuesSize;
+    if (mTriggerState == TriggerState::Armed)
+    {
+        auto capacity = mTrigger.preTriggerSamples;
+        if (!fired)
         {
-            if (field.type == MemoryFieldType::Float)
+            if (capacity > 0)
             {
-                int64_t v_ceil = std::ceil(std::any_cast<float>(value));
-                int64_t v_floor = std::floor(std::any_cast<float>(value));
-                if (v_ceil > highest)
-                {
-                    highest = v_ceil;
-                }
-                if (v_floor < lowest)
-                {
-                    lowest = v_floor;
-                }
+                auto record = mPreTrigger.data() + (mPreTriggerNext * recordSize);
+                std::memcpy(record, &frame, sizeof(uint32_t));
+                std::memcpy(record + sizeof(uint32_t), &time, sizeof(uint64_t));
+                std::memcpy(record + sizeof(uint32_t) + sizeof(uint64_t), values, mValuesSize);
+                mPreTriggerNext = (mPreTriggerNext + 1) % capacity;
+                mPreTriggerCount = (std::min)(mPreTriggerCount + 1, capacity);
             }
-            else
+            return;
+        }
+        // the samples leading up to the trigger go in first, oldest first
+        for (size_t x = 0; x < mPreTriggerCount; ++x)
+        {
+            auto record = mPreTrigger.data() + (((mPreTriggerNext + capacity - mPreTriggerCount + x) % capacity) * recordSize);
+            uint32_t recordFrame;
+            uint64_t recordTime;
+            std::memcpy(&recordFrame, record, sizeof(uint32_t));
+            std::memcpy(&recordTime, record + sizeof(uint32_t), sizeof(uint64_t));
+            appendSample(recordFrame, recordTime, record + sizeof(uint32_t) + sizeof(uint64_t));
+        }
+        mPreTriggerNext = 0;
+        mPreTriggerCount = 0;
+        mTriggerSamples.emplace_back(mSampleCount);
+        mCaptureEnd = time + (static_cast<uint64_t>(mTrigger.postTriggerDuration) * 1000);
+        mTriggerState = TriggerState::Capturing;
+    }
+    if (mTriggerState == TriggerState::Capturing)
+    {
+        appendSample(frame, time, values);
+        if (time >= mCaptureEnd)
+        {
+            mTriggerState = mTrigger.rearm ? TriggerState::Armed : TriggerState::Done;
+        }
+    }
+}
+
+void S2Plugin::Logger::appendSample(uint32_t frame, uint64_t time, const uint8_t* values)
+{
+    mSampleFrames.emplace_back(frame);
+    mSampleTimes.emplace_back(time);
+    ++mSampleCount;
+    for (size_t x = 0; x < mSamples.size(); ++x)
+    {
+        mSamples[x].appendRaw(values + mValueOffsets[x]);
+    }
+}
+
+bool S2Plugin::LoggerTrigger::fires(double previous, double current) const
+{
+    switch (condition)
+    {
+        case LoggerTriggerCondition::RisesAbove:
+            return previous <= value && current > value;
+        case LoggerTriggerCondition::FallsBelow:
+            return previous >= value && current < value;
+        case LoggerTriggerCondition::Changes:
+            return current != previous;
+        case LoggerTriggerCondition::Equals:
+            return current == value && previous != value;
+    }
+    return false;
+}
+
+void S2Plugin::Logger::setSpanGap(size_t gap)
+{
+    mSpanGap = gap;
+}
+
+void S2Plugin::Logger::setTrigger(const LoggerTrigger& trigger)
+{
+    mTrigger = trigger;
+    mTriggerEnabled = true;
+}
+
+void S2Plugin::Logger::clearTrigger()
+{
+    mTriggerEnabled = false;
+}
+
+const std::vector<size_t>& S2Plugin::Logger::triggerSamples() const noexcept
+{
+    return mTriggerSamples;
+}
+
+void S2Plugin::Logger::flushChunks(bool final)
+{
+    if (mRecording == nullptr || mRecordingWritten)
+    {
+        return;
+    }
+    while (mSampleCount - mFlushedCount >= msChunkSize || (final && mSampleCount > mFlushedCount))
+    {
+        auto count = (std::min)(mSampleCount - mFlushedCount, msChunkSize);
+        mChunkBuffer.resize(chunkDataSize(count));
+        auto out = mChunkBuffer.data();
+        auto resident = mFlushedCount - mResidentFirst;
+        std::memcpy(out, mSampleFrames.data() + resident, count * sizeof(uint32_t));
+        out += count * sizeof(uint32_t);
+        std::memcpy(out, mSampleTimes.data() + resident, count * sizeof(uint64_t));
+        out += count * sizeof(uint64_t);
+        for (const auto& column : mSamples)
+        {
+            column.copyRaw(mFlushedCount, count, out);
+            out += count * column.valueSize();
+        }
+        if (!mRecording->writeChunk(mFlushedCount, static_cast<uint32_t>(count), mChunkBuffer))
+        {
+            // what hasn't been evicted yet stays in memory from here on
+            mError = mRecording->error();
+            mRecording.reset();
+            return;
+        }
+        mFlushedCount += count;
+    }
+    // nobody looks at the samples while recording, whatever is on disk can go
+    evictBefore(mFlushedCount);
+}
+
+void S2Plugin::Logger::evictBefore(size_t index)
+{
+    auto count = (std::min)(index - (std::min)(index, mResidentFirst), mSampleFrames.size());
+    mSampleFrames.erase(mSampleFrames.begin(), mSampleFrames.begin() + count);
+    mSampleTimes.erase(mSampleTimes.begin(), mSampleTimes.begin() + count);
+    mResidentFirst += count;
+    for (auto& column : mSamples)
+    {
+        column.evictBefore(index);
+    }
+}
+
+void S2Plugin::Logger::pageIn(size_t first, size_t last)
+{
+    last = (std::min)(last, mSampleCount);
+    if (mRecording == nullptr || !mRecordingWritten || first >= last)
+    {
+        return;
+    }
+    if (first >= mResidentFirst && last <= mResidentFirst + mSampleFrames.size())
+    {
+        return;
+    }
+    auto firstChunk = first / msChunkSize;
+    auto lastChunk = ((last - 1) / msChunkSize) + 1;
+    if (lastChunk - firstChunk > msResidentChunks)
+    {
+        return;
+    }
+    // the range ends up in the middle of what's read, so scrolling either way stays resident for a while
+    firstChunk -= (std::min)(firstChunk, (msResidentChunks - (lastChunk - firstChunk)) / 2);
+    lastChunk = (std::min)(mRecording->chunks().size(), firstChunk + msResidentChunks);
+    if (firstChunk < lastChunk)
+    {
+        loadChunks(firstChunk, lastChunk);
+    }
+}
+
+bool S2Plugin::Logger::loadChunks(size_t firstChunk, size_t lastChunk)
+{
+    mSampleFrames.clear();
+    mSampleTimes.clear();
+    mResidentFirst = firstChunk * msChunkSize;
+    for (auto& column : mSamples)
+    {
+        column.resetResident(mResidentFirst);
+    }
+    for (auto x = firstChunk; x < lastChunk; ++x)
+    {
+        auto data = decodedChunk(x);
+        if (data == nullptr)
+        {
+            return false;
+        }
+        size_t count = mRecording->chunks()[x].sampleCount;
+        auto in = data->data();
+        auto resident = mSampleFrames.size();
+        mSampleFrames.resize(resident + count);
+        std::memcpy(mSampleFrames.data() + resident, in, count * sizeof(uint32_t));
+        in += count * sizeof(uint32_t);
+        mSampleTimes.resize(resident + count);
+        std::memcpy(mSampleTimes.data() + resident, in, count * sizeof(uint64_t));
+        in += count * sizeof(uint64_t);
+        for (auto& column : mSamples)
+        {
+            column.restoreRaw(in, count);
+            in += count * column.valueSize();
+        }
+    }
+    return true;
+}
+
+bool S2Plugin::Logger::readChunk(size_t chunkIndex)
+{
+    const auto& chunk = mRecording->chunks()[chunkIndex];
+    if (!mRecording->readChunk(chunkIndex, mChunkBuffer))
+    {
+        mError = mRecording->error();
+        return false;
+    }
+    if (mChunkBuffer.size() != chunkDataSize(chunk.sampleCount) || chunk.firstSample != chunkIndex * msChunkSize)
+    {
+        mError = "A chunk of " + mRecording->path() + " doesn't match the fields of the recording";
+        return false;
+    }
+    return true;
+}
+
+const std::vector<uint8_t>* S2Plugin::Logger::decodedChunk(size_t chunkIndex)
+{
+    for (auto it = mDecodedChunks.begin(); it != mDecodedChunks.end(); ++it)
+    {
+        if (it->first == chunkIndex)
+        {
+            mDecodedChunks.splice(mDecodedChunks.begin(), mDecodedChunks, it);
+            return &mDecodedChunks.front().second;
+        }
+    }
+    if (!readChunk(chunkIndex))
+    {
+        return nullptr;
+    }
+    mDecodedChunksSize += mChunkBuffer.size();
+    mDecodedChunks.emplace_front(chunkIndex, std::move(mChunkBuffer));
+    mChunkBuffer = std::vector<uint8_t>();
+    while (mDecodedChunksSize > msDecodedChunksSize && mDecodedChunks.size() > 1)
+    {
+        mDecodedChunksSize -= mDecodedChunks.back().second.size();
+        mDecodedChunks.pop_back();
+    }
+    return &mDecodedChunks.front().second;
+}
+
+const uint8_t* S2Plugin::Logger::decodedChunkOfSample(size_t index, size_t& offset, size_t& count)
+{
+    if (mRecording == nullptr || !mRecordingWritten || index >= mSampleCount)
+    {
+        return nullptr;
+    }
+    auto chunkIndex = index / msChunkSize;
+    if (chunkIndex >= mRecording->chunks().size())
+    {
+        return nullptr;
+    }
+    auto data = decodedChunk(chunkIndex);
+    if (data == nullptr)
+    {
+        return nullptr;
+    }
+    offset = index - (chunkIndex * msChunkSize);
+    count = mRecording->chunks()[chunkIndex].sampleCount;
+    return data->data();
+}
+
+uint32_t S2Plugin::Logger::readSampleFrame(size_t index)
+{
+    if (index >= mResidentFirst && index - mResidentFirst < mSampleFrames.size())
+    {
+        return mSampleFrames[index - mResidentFirst];
+    }
+    size_t offset, count;
+    auto data = decodedChunkOfSample(index, offset, count);
+    if (data == nullptr)
+    {
+        return 0;
+    }
+    uint32_t frame;
+    std::memcpy(&frame, data + (offset * sizeof(uint32_t)), sizeof(frame));
+    return frame;
+}
+
+uint64_t S2Plugin::Logger::readSampleTime(size_t index)
+{
+    if (index >= mResidentFirst && index - mResidentFirst < mSampleTimes.size())
+    {
+        return mSampleTimes[index - mResidentFirst];
+    }
+    size_t offset, count;
+    auto data = decodedChunkOfSample(index, offset, count);
+    if (data == nullptr)
+    {
+        return 0;
+    }
+    uint64_t time;
+    std::memcpy(&time, data + (count * sizeof(uint32_t)) + (offset * sizeof(uint64_t)), sizeof(time));
+    return time;
+}
+
+QVariant S2Plugin::Logger::readSampleValue(size_t fieldIndex, size_t index)
+{
+    const auto& column = mSamples.at(fieldIndex);
+    if (column.isResident(index, index + 1))
+    {
+        return column.valueAt(index);
+    }
+    size_t offset, count;
+    auto data = decodedChunkOfSample(index, offset, count);
+    if (data == nullptr)
+    {
+        return QVariant();
+    }
+    // the chunk has the frames, the times and then each column in turn
+    auto in = data + (count * (sizeof(uint32_t) + sizeof(uint64_t)));
+    for (size_t x = 0; x < fieldIndex; ++x)
+    {
+        in += count * mSamples[x].valueSize();
+    }
+    return column.displayFromRaw(in + (offset * column.valueSize()));
+}
+
+size_t S2Plugin::Logger::chunkDataSize(size_t sampleCount) const
+{
+    auto size = sampleCount * (sizeof(uint32_t) + sizeof(uint64_t));
+    for (const auto& column : mSamples)
+    {
+        size += sampleCount * column.valueSize();
+    }
+    return size;
+}
+
+bool S2Plugin::Logger::openRecording(const std::string& path)
+{
+    auto recording = std::make_unique<LoggerRecording>();
+    if (!recording->open(path))
+    {
+        mError = recording->error();
+        return false;
+    }
+    while (!mFields.empty())
+    {
+        if (mTableModel != nullptr)
+        {
+            mTableModel->removeRow(mFields.size() - 1);
+        }
+        mFields.pop_back();
+        if (mTableModel != nullptr)
+        {
+            mTableModel->removeRowEnd();
+        }
+    }
+    for (const auto& field : recording->fields())
+    {
+        if (mTableModel != nullptr)
+        {
+            mTableModel->appendRow();
+        }
+        mFields.emplace_back(field);
+        if (mTableModel != nullptr)
+        {
+            mTableModel->appendRowEnd();
+        }
+    }
+    clearSamples();
+    mError.clear();
+    // nothing is sampled from a recording, the reads of the last session don't apply to it
+    mReader.reset();
+    mRecording = std::move(recording);
+    mRecordingWritten = true;
+
+    // one pass over the whole recording for the statistics and block bounds, a chunk in memory at a time
+    for (size_t x = 0; x < mRecording->chunks().size(); ++x)
+    {
+        if (!readChunk(x))
+        {
+            // keep the part before the damage, the error tells what happened
+            break;
+        }
+        size_t count = mRecording->chunks()[x].sampleCount;
+        auto in = mChunkBuffer.data() + (count * (sizeof(uint32_t) + sizeof(uint64_t)));
+        for (auto& column : mSamples)
+        {
+            auto valueSize = column.valueSize();
+            for (size_t sample = 0; sample < count; ++sample)
             {
-                int64_t v = 0;
-                switch (field.type)
-                {
-                    case MemoryFieldType::Byte:
-                    {
-                        v = std::any_cast<int8_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedByte:
-                    case MemoryFieldType::Bool:
-                    case MemoryFieldType::Flags8:
-                    case MemoryFieldType::State8:
-                    case MemoryFieldType::CharacterDBID:
-                    {
-                        v = std::any_cast<uint8_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::Word:
-                    {
-                        v = std::any_cast<int16_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedWord:
-                    case MemoryFieldType::Flags16:
-                    case MemoryFieldType::State16:
-                    {
-                        v = std::any_cast<uint16_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::Dword:
-                    {
-                        v = std::any_cast<int32_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedDword:
-                    case MemoryFieldType::Flags32:
-                    case MemoryFieldType::State32:
-                    case MemoryFieldType::EntityDBID:
-                    case MemoryFieldType::EntityUID:
-                    case MemoryFieldType::ParticleDBID:
-                    case MemoryFieldType::TextureDBID:
-                    case MemoryFieldType::StringsTableID:
-                    {
-                        v = std::any_cast<uint32_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::Qword:
-                    {
-                        v = std::any_cast<int64_t>(value);
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedQword:
-                    {
-                        v = std::any_cast<uint64_t>(value);
-                        break;
-                    }
-                }
-                if (v > highest)
-                {
-                    highest = v;
-                }
-                if (v < lowest)
-                {
-                    lowest = v;
-                }
+                column.appendRaw(in + (sample * valueSize));
             }
+            column.evictBefore(mSampleCount + count);
+            in += count * valueSize;
         }
+        mSampleCount += count;
     }
-    return std::make_pair(lowest, highest);
+    mResidentFirst = mSampleCount;
+    mFlushedCount = mSampleCount;
+    pageIn(0, 1);
+    emit fieldsChanged();
+    emit samplingEnded();
+    return true;
 }
 
-const std::vector<std::any>& S2Plugin::Logger::samplesForField(const std::string& fieldUUID) const
+bool S2Plugin::Logger::keepSession(const std::string& name)
 {
-    return mSamples.at(fieldUUID);
+    if (mSampler != nullptr || mFrameClockSubscribed)
+    {
+        mError = "The current session can be kept once the logging has ended";
+        return false;
+    }
+    if (mSampleCount == 0)
+    {
+        mError = "There are no samples to keep";
+        return false;
+    }
+    auto session = std::make_unique<LoggerSession>();
+    if (mRecording != nullptr)
+    {
+        // only a window of the samples is in memory, the recording has them all
+        if (!session->loadRecording(mRecording->path(), mError))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        session->fields = mFields;
+        session->columns = mSamples;
+        session->frames = mSampleFrames;
+    }
+    session->name = name;
+    session->color = gsSessionColors[mSessions.size() % gsSessionColorCount];
+    mSessions.emplace_back(std::move(session));
+    emit sessionsChanged();
+    return true;
 }
 
-size_t S2Plugin::Logger::sampleCount() const noexcept
+bool S2Plugin::Logger::addSessionFromRecording(const std::string& path, const std::string& name)
+{
+    auto session = std::make_unique<LoggerSession>();
+    if (!session->loadRecording(path, mError))
+    {
+        return false;
+    }
+    session->name = name;
+    session->color = gsSessionColors[mSessions.size() % gsSessionColorCount];
+    mSessions.emplace_back(std::move(session));
+    emit sessionsChanged();
+    return true;
+}
+
+void S2Plugin::Logger::removeSession(size_t index)
+{
+    if (index < mSessions.size())
+    {
+        mSessions.erase(mSessions.begin() + index);
+        emit sessionsChanged();
+    }
+}
+
+size_t S2Plugin::Logger::sessionCount() const noexcept
+{
+    return mSessions.size();
+}
+
+const S2Plugin::LoggerSession& S2Plugin::Logger::sessionAt(size_t index) const
+{
+    return *mSessions.at(index);
+}
+
+void S2Plugin::Logger::frameAdvanced(uint32_t frame)
+{
+    captureSample(frame);
+    if (mTriggerState == TriggerState::Done)
+    {
+        durationEnded();
+    }
+}
+
+uint64_t S2Plugin::Logger::missedFrameCount() const noexcept
+{
+    return mFrameClock->missedFrameCount() - mMissedFramesAtStart;
+}
+
+uint32_t S2Plugin::Logger::sampleFrame(size_t index) const
+{
+    return index >= mResidentFirst && index - mResidentFirst < mSampleFrames.size() ? mSampleFrames[index - mResidentFirst] : 0;
+}
+
+uint64_t S2Plugin::Logger::sampleTime(size_t index) const
+{
+    return index >= mResidentFirst && index - mResidentFirst < mSampleTimes.size() ? mSampleTimes[index - mResidentFirst] : 0;
+}
+
+const std::string& S2Plugin::Logger::error() const noexcept
+{
+    return mError;
+}
+
+uint64_t S2Plugin::Logger::overrunCount() const noexcept
+{
+    return mOverruns;
+}
+
+uint64_t S2Plugin::Logger::droppedSampleCount() const noexcept
+{
+    return mDropped;
+}
+
+size_t S2Plugin::Logger::readsPerSample() const noexcept
+{
+    return mReader == nullptr ? 0 : mReader->spanCount();
+}
+
+double S2Plugin::Logger::maxSampleRate() const noexcept
+{
+    if (mReadNanoseconds == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(mReadCount) * 1e9 / static_cast<double>(mReadNanoseconds);
+}
+
+void S2Plugin::Logger::captureSample(uint32_t frame)
+{
+    auto time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - mStartTime).count();
+    auto readStart = std::chrono::steady_clock::now();
+    mReader->read(mValueBuffer.data());
+    mReadNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - readStart).count();
+    ++mReadCount;
+    takeSample(frame, time, mValueBuffer.data());
+    flushChunks(false);
+}
+
+void S2Plugin::Logger::durationEnded()
 {
-    for (const auto& [uuid, samples] : mSamples)
+    if (mDurationTimer != nullptr)
     {
-        return samples.size();
+        mDurationTimer->stop();
     }
-    return 0;
+    if (mSampler != nullptr)
+    {
+        mDrainTimer->stop();
+        mSampler->stop();
+        // whatever the sampler took after the last drain
+        takeSamplerSamples();
+        mSampler.reset();
+    }
+    if (mRecording != nullptr)
+    {
+        flushChunks(true);
+        // read back from the file from here on
+        if (mRecording != nullptr && (!mRecording->finish() || !mRecording->open(mRecording->path())))
+        {
+            mError = mRecording->error();
+            mRecording.reset();
+        }
+        mRecordingWritten = mRecording != nullptr;
+    }
+    QObject::disconnect(mFrameClock, &FrameClock::frameAdvanced, this, &Logger::frameAdvanced);
+    if (mFrameClockSubscribed)
+    {
+        mFrameClock->unsubscribe();
+        mFrameClockSubscribed = false;
+    }
+    emit samplingEnded();
+}
+
+std::pair<int64_t, int64_t> S2Plugin::Logger::sampleBounds(size_t fieldIndex) const
+{
+    return mSamples.at(fieldIndex).bounds();
+}
+
+const S2Plugin::LoggerSampleColumn& S2Plugin::Logger::samplesForField(size_t fieldIndex) const
+{
+    return mSamples.at(fieldIndex);
+}
+
+size_t S2Plugin::Logger::sampleCount() const noexcept
+{
+    return mSampleCount;
 }
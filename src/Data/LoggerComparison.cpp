@@ -0,0 +1,219 @@
+#include "Data/LoggerComparison.h"
+#include "Data/LoggerSession.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr double gsNoValue = std::numeric_limits<double>::quiet_NaN();
+}
+
+void S2Plugin::LoggerComparison::update(const std::vector<const LoggerSession*>& sessions, const std::string& fieldName, LoggerAlignment alignment,
+                                        const LoggerTrigger& trigger, const std::string& triggerFieldName)
+{
+    clear();
+    mSessions.resize(sessions.size());
+
+    // where each session's frame 0 goes, and the range of aligned frames that covers them all
+    auto lowest = (std::numeric_limits<int64_t>::max)();
+    auto highest = (std::numeric_limits<int64_t>::min)();
+    for (size_t x = 0; x < sessions.size(); ++x)
+    {
+        const auto& session = *sessions[x];
+        auto& compared = mSessions[x];
+        auto sampleCount = session.sampleCount();
+        if (sampleCount == 0)
+        {
+            continue;
+        }
+        compared.origin = session.frameOf(0);
+        auto triggerField = session.fieldIndex(triggerFieldName);
+        if (alignment == LoggerAlignment::Trigger && triggerField != -1)
+        {
+            const auto& column = session.columns[triggerField];
+            column.visit(
+                [&](const auto& samples)
+                {
+                    for (size_t sample = 1; sample < samples.size(); ++sample)
+                    {
+                        if (trigger.fires(static_cast<double>(samples[sample - 1]), static_cast<double>(samples[sample])))
+                        {
+                            compared.origin = session.frameOf(sample);
+                            compared.triggerFound = true;
+                            return;
+                        }
+                    }
+                });
+        }
+        lowest = (std::min)(lowest, session.frameOf(0) - compared.origin);
+        highest = (std::max)(highest, session.frameOf(sampleCount - 1) - compared.origin);
+    }
+    if (lowest > highest)
+    {
+        return;
+    }
+    mFirstFrame = lowest;
+    mFrameCount = (std::min)(static_cast<size_t>(highest - lowest + 1), msMaxFrameCount);
+
+    mLowest = (std::numeric_limits<double>::max)();
+    mHighest = std::numeric_limits<double>::lowest();
+    for (size_t x = 0; x < sessions.size(); ++x)
+    {
+        auto fieldIndex = sessions[x]->fieldIndex(fieldName);
+        auto& compared = mSessions[x];
+        compared.hasField = fieldIndex != -1;
+        if (compared.hasField)
+        {
+            resample(*sessions[x], fieldIndex, compared);
+        }
+        else
+        {
+            compared.series.assign(mFrameCount, gsNoValue);
+        }
+    }
+    if (mLowest > mHighest)
+    {
+        mLowest = mHighest = 0;
+    }
+    for (size_t x = 1; x < mSessions.size(); ++x)
+    {
+        if (mSessions[0].hasField && mSessions[x].hasField)
+        {
+            mSessions[x].metrics = measure(mSessions[0].series, mSessions[x].series);
+        }
+    }
+}
+
+void S2Plugin::LoggerComparison::clear()
+{
+    mSessions.clear();
+    mFirstFrame = 0;
+    mFrameCount = 0;
+    mLowest = 0;
+    mHighest = 0;
+}
+
+void S2Plugin::LoggerComparison::resample(const LoggerSession& session, size_t fieldIndex, ComparedSession& compared)
+{
+    compared.series.assign(mFrameCount, gsNoValue);
+    auto& series = compared.series;
+    auto frameCount = static_cast<int64_t>(mFrameCount);
+    session.columns[fieldIndex].visit(
+        [&](const auto& samples)
+        {
+            // the frames between two samples hold the earlier one, several samples in one frame leave the last
+            int64_t filled = -1;
+            double held = 0;
+            for (size_t sample = 0; sample < samples.size(); ++sample)
+            {
+                auto slot = session.frameOf(sample) - compared.origin - mFirstFrame;
+                if (slot < 0)
+                {
+                    // the frame counter went back, e.g. it wasn't found yet when the session started
+                    continue;
+                }
+                if (slot >= frameCount)
+                {
+                    break;
+                }
+                for (auto frame = filled + 1; filled != -1 && frame < slot; ++frame)
+                {
+                    series[frame] = held;
+                }
+                held = static_cast<double>(samples[sample]);
+                series[slot] = held;
+                filled = (std::max)(filled, slot);
+                mLowest = (std::min)(mLowest, held);
+                mHighest = (std::max)(mHighest, held);
+            }
+        });
+}
+
+S2Plugin::LoggerComparisonMetrics S2Plugin::LoggerComparison::measure(const std::vector<double>& reference, const std::vector<double>& series)
+{
+    LoggerComparisonMetrics metrics;
+    double sumAbsolute = 0;
+    double sumSquared = 0;
+    // running means and co-moments (Welford), so long sessions don't lose precision
+    double meanReference = 0;
+    double meanSeries = 0;
+    double m2Reference = 0;
+    double m2Series = 0;
+    double coMoment = 0;
+    for (size_t frame = 0; frame < reference.size(); ++frame)
+    {
+        auto a = reference[frame];
+        auto b = series[frame];
+        if (std::isnan(a) || std::isnan(b))
+        {
+            continue;
+        }
+        auto difference = b - a;
+        ++metrics.frameCount;
+        sumAbsolute += std::abs(difference);
+        sumSquared += difference * difference;
+        metrics.maxAbsoluteDifference = (std::max)(metrics.maxAbsoluteDifference, std::abs(difference));
+
+        auto n = static_cast<double>(metrics.frameCount);
+        auto deltaReference = a - meanReference;
+        meanReference += deltaReference / n;
+        auto deltaSeries = b - meanSeries;
+        meanSeries += deltaSeries / n;
+        m2Reference += deltaReference * (a - meanReference);
+        m2Series += deltaSeries * (b - meanSeries);
+        coMoment += deltaReference * (b - meanSeries);
+    }
+    if (metrics.frameCount != 0)
+    {
+        metrics.meanAbsoluteDifference = sumAbsolute / metrics.frameCount;
+        metrics.rmsDifference = std::sqrt(sumSquared / metrics.frameCount);
+    }
+    metrics.correlation = (m2Reference > 0 && m2Series > 0) ? coMoment / std::sqrt(m2Reference * m2Series) : gsNoValue;
+    return metrics;
+}
+
+size_t S2Plugin::LoggerComparison::sessionCount() const noexcept
+{
+    return mSessions.size();
+}
+
+int64_t S2Plugin::LoggerComparison::firstFrame() const noexcept
+{
+    return mFirstFrame;
+}
+
+size_t S2Plugin::LoggerComparison::frameCount() const noexcept
+{
+    return mFrameCount;
+}
+
+const std::vector<double>& S2Plugin::LoggerComparison::series(size_t sessionIndex) const
+{
+    return mSessions.at(sessionIndex).series;
+}
+
+int64_t S2Plugin::LoggerComparison::origin(size_t sessionIndex) const
+{
+    return mSessions.at(sessionIndex).origin;
+}
+
+bool S2Plugin::LoggerComparison::triggerFound(size_t sessionIndex) const
+{
+    return mSessions.at(sessionIndex).triggerFound;
+}
+
+bool S2Plugin::LoggerComparison::hasField(size_t sessionIndex) const
+{
+    return mSessions.at(sessionIndex).hasField;
+}
+
+const S2Plugin::LoggerComparisonMetrics& S2Plugin::LoggerComparison::metrics(size_t sessionIndex) const
+{
+    return mSessions.at(sessionIndex).metrics;
+}
+
+std::pair<double, double> S2Plugin::LoggerComparison::bounds() const noexcept
+{
+    return std::make_pair(mLowest, mHighest);
+}
@@ -0,0 +1,308 @@
+#include "Data/LoggerExpression.h"
+#include "Data/ExpressionScanner.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+struct S2Plugin::LoggerExpression::Compilation
+{
+    ExpressionScanner scanner;
+    const std::vector<std::string>& fieldNames;
+};
+
+bool S2Plugin::LoggerExpression::compile(const std::string& text, const std::vector<std::string>& fieldNames)
+{
+    mProgram.clear();
+    mError.clear();
+    Compilation compilation{ExpressionScanner(text), fieldNames};
+
+    auto ok = parseSum(compilation);
+    if (ok && !compilation.scanner.atEnd())
+    {
+        ok = fail(compilation, "Unexpected '" + std::string(1, compilation.scanner.peek()) + "'");
+    }
+    if (!ok)
+    {
+        mProgram.clear();
+        return false;
+    }
+
+    // the deepest the stack gets, so evaluating never allocates
+    size_t depth = 0;
+    size_t maxDepth = 0;
+    for (const auto& instruction : mProgram)
+    {
+        switch (instruction.op)
+        {
+            case Op::Constant:
+            case Op::Field:
+                maxDepth = (std::max)(maxDepth, ++depth);
+                break;
+            case Op::Negate:
+            case Op::Abs:
+            case Op::Sqrt:
+            case Op::Floor:
+                break;
+            default:
+                --depth;
+                break;
+        }
+    }
+    mStack.resize(maxDepth);
+    return true;
+}
+
+double S2Plugin::LoggerExpression::evaluate(const double* fieldValues) const
+{
+    if (mProgram.empty())
+    {
+        return 0;
+    }
+    auto top = mStack.data() - 1;
+    for (const auto& instruction : mProgram)
+    {
+        switch (instruction.op)
+        {
+            case Op::Constant:
+                *++top = instruction.constant;
+                break;
+            case Op::Field:
+                *++top = fieldValues[instruction.field];
+                break;
+            case Op::Add:
+                --top;
+                top[0] += top[1];
+                break;
+            case Op::Subtract:
+                --top;
+                top[0] -= top[1];
+                break;
+            case Op::Multiply:
+                --top;
+                top[0] *= top[1];
+                break;
+            case Op::Divide:
+                --top;
+                top[0] /= top[1];
+                break;
+            case Op::Modulo:
+                --top;
+                top[0] = std::fmod(top[0], top[1]);
+                break;
+            case Op::Negate:
+                top[0] = -top[0];
+                break;
+            case Op::Abs:
+                top[0] = std::abs(top[0]);
+                break;
+            case Op::Sqrt:
+                top[0] = std::sqrt(top[0]);
+                break;
+            case Op::Floor:
+                top[0] = std::floor(top[0]);
+                break;
+            case Op::Min:
+                --top;
+                top[0] = (std::min)(top[0], top[1]);
+                break;
+            case Op::Max:
+                --top;
+                top[0] = (std::max)(top[0], top[1]);
+                break;
+            case Op::Hypot:
+                --top;
+                top[0] = std::hypot(top[0], top[1]);
+                break;
+            case Op::Atan2:
+                --top;
+                top[0] = std::atan2(top[0], top[1]);
+                break;
+        }
+    }
+    return top[0];
+}
+
+const std::string& S2Plugin::LoggerExpression::error() const noexcept
+{
+    return mError;
+}
+
+bool S2Plugin::LoggerExpression::parseSum(Compilation& compilation)
+{
+    if (!parseProduct(compilation))
+    {
+        return false;
+    }
+    while (true)
+    {
+        Op op;
+        if (compilation.scanner.accept("+"))
+        {
+            op = Op::Add;
+        }
+        else if (compilation.scanner.accept("-"))
+        {
+            op = Op::Subtract;
+        }
+        else
+        {
+            return true;
+        }
+        if (!parseProduct(compilation))
+        {
+            return false;
+        }
+        mProgram.emplace_back(Instruction{op});
+    }
+}
+
+bool S2Plugin::LoggerExpression::parseProduct(Compilation& compilation)
+{
+    if (!parseUnary(compilation))
+    {
+        return false;
+    }
+    while (true)
+    {
+        Op op;
+        if (compilation.scanner.accept("*"))
+        {
+            op = Op::Multiply;
+        }
+        else if (compilation.scanner.accept("/"))
+        {
+            op = Op::Divide;
+        }
+        else if (compilation.scanner.accept("%"))
+        {
+            op = Op::Modulo;
+        }
+        else
+        {
+            return true;
+        }
+        if (!parseUnary(compilation))
+        {
+            return false;
+        }
+        mProgram.emplace_back(Instruction{op});
+    }
+}
+
+bool S2Plugin::LoggerExpression::parseUnary(Compilation& compilation)
+{
+    if (compilation.scanner.accept("-"))
+    {
+        if (!parseUnary(compilation))
+        {
+            return false;
+        }
+        mProgram.emplace_back(Instruction{Op::Negate});
+        return true;
+    }
+    return parsePrimary(compilation);
+}
+
+bool S2Plugin::LoggerExpression::parsePrimary(Compilation& compilation)
+{
+    auto& scanner = compilation.scanner;
+    if (scanner.atEnd())
+    {
+        return fail(compilation, "Unexpected end of the expression");
+    }
+    if (scanner.accept("("))
+    {
+        if (!parseSum(compilation))
+        {
+            return false;
+        }
+        if (!scanner.accept(")"))
+        {
+            return fail(compilation, "Missing ')'");
+        }
+        return true;
+    }
+    if (scanner.accept("{"))
+    {
+        std::string name;
+        if (!scanner.until('}', name))
+        {
+            return fail(compilation, "Missing '}'");
+        }
+        auto it = std::find(compilation.fieldNames.begin(), compilation.fieldNames.end(), name);
+        if (name.empty() || it == compilation.fieldNames.end())
+        {
+            return fail(compilation, "There's no logged field called '" + name + "' to use");
+        }
+        Instruction instruction{Op::Field};
+        instruction.field = static_cast<size_t>(it - compilation.fieldNames.begin());
+        mProgram.emplace_back(instruction);
+        return true;
+    }
+    auto c = scanner.peek();
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+    {
+        Instruction instruction{Op::Constant};
+        if (!scanner.number(instruction.constant))
+        {
+            return fail(compilation, "Invalid number");
+        }
+        mProgram.emplace_back(instruction);
+        return true;
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)))
+    {
+        return parseCall(compilation, scanner.name());
+    }
+    return fail(compilation, "Unexpected '" + std::string(1, c) + "'");
+}
+
+bool S2Plugin::LoggerExpression::parseCall(Compilation& compilation, const std::string& name)
+{
+    struct Function
+    {
+        const char* name;
+        Op op;
+        size_t arguments;
+    };
+    static const Function functions[] = {
+        {"abs", Op::Abs, 1},   {"sqrt", Op::Sqrt, 1},   {"floor", Op::Floor, 1}, {"min", Op::Min, 2},
+        {"max", Op::Max, 2},   {"hypot", Op::Hypot, 2}, {"atan2", Op::Atan2, 2},
+    };
+    auto function = std::find_if(std::begin(functions), std::end(functions), [&name](const Function& f) { return name == f.name; });
+    if (function == std::end(functions))
+    {
+        return fail(compilation, "Unknown function '" + name + "', put field names in braces");
+    }
+    auto& scanner = compilation.scanner;
+    if (!scanner.accept("("))
+    {
+        return fail(compilation, "Missing '(' after " + name);
+    }
+    for (size_t x = 0; x < function->arguments; ++x)
+    {
+        if (x != 0 && !scanner.accept(","))
+        {
+            return fail(compilation, name + " takes " + std::to_string(function->arguments) + " arguments");
+        }
+        if (!parseSum(compilation))
+        {
+            return false;
+        }
+    }
+    if (!scanner.accept(")"))
+    {
+        return fail(compilation, "Missing ')' after the arguments of " + name);
+    }
+    mProgram.emplace_back(Instruction{function->op});
+    return true;
+}
+
+bool S2Plugin::LoggerExpression::fail(const Compilation& compilation, const std::string& error)
+{
+    if (mError.empty())
+    {
+        mError = error + " (at " + std::to_string(compilation.scanner.position()) + ")";
+    }
+    return false;
+}
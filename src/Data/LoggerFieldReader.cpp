@@ -0,0 +1,242 @@
+#include "Data/LoggerFieldReader.h"
+#include "Data/Logger.h"
+#include "Spelunky2.h"
+#include "pluginmain.h"
+#include <algorithm>
+#include <cstring>
+
+bool S2Plugin::LoggerFieldReader::initialize(const std::vector<LoggerField>& fields, size_t layer0Address, size_t layer1Address, size_t maxSpanGap)
+{
+    mFields.clear();
+    mColumns.clear();
+    mError.clear();
+    mHasExpressions = false;
+    mValuesSize = 0;
+    mLayerAddresses[0] = layer0Address;
+    mLayerAddresses[1] = layer1Address;
+
+    // expressions can use every field that's read from memory
+    std::vector<std::string> names;
+    for (const auto& field : fields)
+    {
+        names.emplace_back(field.kind == LoggerFieldKind::Expression ? std::string() : field.name);
+    }
+
+    for (const auto& field : fields)
+    {
+        auto& column = mColumns.emplace_back(field.columnType());
+        PlannedField planned;
+        planned.kind = field.kind;
+        planned.memoryOffset = field.memoryOffset;
+        planned.valueSize = column.valueSize();
+        planned.valueOffset = mValuesSize;
+        planned.bit = field.bit;
+        planned.pathOffsets = field.pathOffsets;
+        switch (field.kind)
+        {
+            case LoggerFieldKind::FlagBit:
+                planned.readSize = LoggerSampleColumn(field.type).valueSize();
+                break;
+            case LoggerFieldKind::PointerPath:
+                planned.readSize = sizeof(size_t);
+                break;
+            case LoggerFieldKind::UIDPath:
+                planned.readSize = sizeof(uint32_t);
+                break;
+            case LoggerFieldKind::Expression:
+                planned.readSize = 0;
+                if (!planned.expression.compile(field.expression, names))
+                {
+                    mError = field.name + ": " + planned.expression.error();
+                    return false;
+                }
+                mHasExpressions = true;
+                break;
+            default:
+                planned.readSize = planned.valueSize;
+                break;
+        }
+        if ((field.kind == LoggerFieldKind::PointerPath || field.kind == LoggerFieldKind::UIDPath) && planned.pathOffsets.empty())
+        {
+            planned.pathOffsets.emplace_back(0);
+        }
+        mValuesSize += planned.valueSize;
+        mFields.emplace_back(std::move(planned));
+    }
+    mFieldValues.assign(mFields.size(), 0);
+    planSpans(maxSpanGap);
+    return true;
+}
+
+void S2Plugin::LoggerFieldReader::planSpans(size_t maxSpanGap)
+{
+    std::vector<size_t> order;
+    for (size_t x = 0; x < mFields.size(); ++x)
+    {
+        if (mFields[x].readSize != 0)
+        {
+            order.emplace_back(x);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return mFields[a].memoryOffset < mFields[b].memoryOffset; });
+
+    mSpans.clear();
+    std::vector<size_t> fieldSpans(mFields.size(), 0);
+    for (auto fieldIndex : order)
+    {
+        const auto& field = mFields[fieldIndex];
+        if (!mSpans.empty() && field.memoryOffset <= mSpans.back().offset + mSpans.back().size + maxSpanGap)
+        {
+            auto& span = mSpans.back();
+            span.size = (std::max)(span.offset + span.size, field.memoryOffset + field.readSize) - span.offset;
+        }
+        else
+        {
+            mSpans.emplace_back(ReadSpan{field.memoryOffset, field.readSize, 0});
+        }
+        fieldSpans[fieldIndex] = mSpans.size() - 1;
+    }
+
+    size_t bufferSize = 0;
+    for (auto& span : mSpans)
+    {
+        span.bufferOffset = bufferSize;
+        bufferSize += span.size;
+    }
+    mSpanBuffer.resize(bufferSize);
+    for (auto fieldIndex : order)
+    {
+        auto& field = mFields[fieldIndex];
+        const auto& span = mSpans[fieldSpans[fieldIndex]];
+        field.bufferOffset = span.bufferOffset + (field.memoryOffset - span.offset);
+    }
+}
+
+const std::string& S2Plugin::LoggerFieldReader::error() const noexcept
+{
+    return mError;
+}
+
+size_t S2Plugin::LoggerFieldReader::valuesSize() const noexcept
+{
+    return mValuesSize;
+}
+
+size_t S2Plugin::LoggerFieldReader::valueOffset(size_t fieldIndex) const
+{
+    return mFields.at(fieldIndex).valueOffset;
+}
+
+size_t S2Plugin::LoggerFieldReader::spanCount() const noexcept
+{
+    return mSpans.size();
+}
+
+void S2Plugin::LoggerFieldReader::read(uint8_t* values)
+{
+    for (const auto& span : mSpans)
+    {
+        auto buffer = mSpanBuffer.data() + span.bufferOffset;
+        if (!Script::Memory::Read(span.offset, buffer, span.size, nullptr))
+        {
+            std::memset(buffer, 0, span.size);
+        }
+    }
+    for (auto& field : mFields)
+    {
+        if (field.kind == LoggerFieldKind::Expression)
+        {
+            continue;
+        }
+        auto source = mSpanBuffer.data() + field.bufferOffset;
+        auto value = values + field.valueOffset;
+        switch (field.kind)
+        {
+            case LoggerFieldKind::FlagBit:
+            {
+                uint64_t flags = 0;
+                std::memcpy(&flags, source, field.readSize);
+                *value = static_cast<uint8_t>((flags >> field.bit) & 1);
+                break;
+            }
+            case LoggerFieldKind::PointerPath:
+            {
+                size_t pointer = 0;
+                std::memcpy(&pointer, source, sizeof(size_t));
+                readPath(field, pointer, value);
+                break;
+            }
+            case LoggerFieldKind::UIDPath:
+            {
+                uint32_t uid = 0;
+                std::memcpy(&uid, source, sizeof(uint32_t));
+                readPath(field, entityForUID(field, uid), value);
+                break;
+            }
+            default:
+                std::memcpy(value, source, field.valueSize);
+                break;
+        }
+    }
+
+    if (mHasExpressions)
+    {
+        for (size_t x = 0; x < mFields.size(); ++x)
+        {
+            if (mFields[x].kind != LoggerFieldKind::Expression)
+            {
+                mFieldValues[x] = mColumns[x].valueFromRaw(values + mFields[x].valueOffset);
+            }
+        }
+        for (const auto& field : mFields)
+        {
+            if (field.kind == LoggerFieldKind::Expression)
+            {
+                auto result = static_cast<float>(field.expression.evaluate(mFieldValues.data()));
+                std::memcpy(values + field.valueOffset, &result, sizeof(float));
+            }
+        }
+    }
+}
+
+void S2Plugin::LoggerFieldReader::readPath(const PlannedField& field, size_t address, uint8_t* value)
+{
+    for (size_t x = 0; address != 0 && x + 1 < field.pathOffsets.size(); ++x)
+    {
+        address = Script::Memory::ReadQword(address + field.pathOffsets[x]);
+    }
+    if (address == 0 || !Script::Memory::Read(address + field.pathOffsets.back(), value, field.valueSize, nullptr))
+    {
+        // nothing there (anymore), logged as 0
+        std::memset(value, 0, field.valueSize);
+    }
+}
+
+size_t S2Plugin::LoggerFieldReader::entityForUID(PlannedField& field, uint32_t uid)
+{
+    // entities don't move while they live, so the last one found only has to be checked (uid +0x38)
+    if (uid == field.cachedUID && field.cachedEntity != 0 && Script::Memory::ReadDword(field.cachedEntity + 0x38) == uid)
+    {
+        return field.cachedEntity;
+    }
+    field.cachedUID = uid;
+    field.cachedEntity = 0;
+    if (uid == 0 || uid == 0xFFFFFFFF)
+    {
+        return 0;
+    }
+    for (auto layerAddress : mLayerAddresses)
+    {
+        if (layerAddress == 0 || !State::readLayerEntities(Script::Memory::ReadQword(layerAddress), mLayerEntities))
+        {
+            continue;
+        }
+        auto it = std::find(mLayerEntities.uids.begin(), mLayerEntities.uids.end(), uid);
+        if (it != mLayerEntities.uids.end())
+        {
+            field.cachedEntity = mLayerEntities.entities[it - mLayerEntities.uids.begin()];
+            return field.cachedEntity;
+        }
+    }
+    return 0;
+}
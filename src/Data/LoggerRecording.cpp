@@ -0,0 +1,318 @@
+#include "Data/LoggerRecording.h"
+#include "Data/BinaryFile.h"
+#include "Data/Logger.h"
+#include "pluginsdk/lz4/lz4.h"
+#include <cstring>
+
+namespace
+{
+    constexpr char gsRecordingMagic[4] = {'S', '2', 'L', 'R'};
+    constexpr char gsChunkMagic[4] = {'S', '2', 'L', 'C'};
+    constexpr char gsIndexMagic[4] = {'S', '2', 'L', 'I'};
+    // version 2 added the kind of field, with its bit, path and expression; version 3 moved the chunks to LZ4 and
+    // stores their uncompressed size
+    constexpr uint32_t gsRecordingVersion = 3;
+    // the chunk magic, first sample, sample count, uncompressed and compressed size
+    constexpr uint64_t gsChunkHeaderSize = 4 + 8 + 4 + 4 + 4;
+    // the index offset, chunk count and index magic at the very end of a finished recording
+    constexpr uint64_t gsTrailerSize = 8 + 4 + 4;
+} // namespace
+
+bool S2Plugin::LoggerRecording::create(const std::string& path, const std::vector<LoggerField>& fields)
+{
+    mError.clear();
+    mIn.close();
+    mPath = path;
+    mFields = fields;
+    mChunks.clear();
+
+    mOut.open(path, std::ios::binary | std::ios::trunc);
+    if (!mOut)
+    {
+        return fail("Could not open " + path + " for writing");
+    }
+    mOut.write(gsRecordingMagic, sizeof(gsRecordingMagic));
+    writeValue<uint32_t>(mOut, gsRecordingVersion);
+    writeValue<uint32_t>(mOut, static_cast<uint32_t>(mFields.size()));
+    for (const auto& field : mFields)
+    {
+        writeString(mOut, field.name);
+        writeString(mOut, field.uuid);
+        writeValue<uint32_t>(mOut, static_cast<uint32_t>(field.type));
+        writeValue<uint64_t>(mOut, field.memoryOffset);
+        writeValue<uint32_t>(mOut, field.color.rgba());
+        writeValue<uint8_t>(mOut, static_cast<uint8_t>(field.kind));
+        writeValue<uint8_t>(mOut, field.bit);
+        writeValue<uint32_t>(mOut, static_cast<uint32_t>(field.pathOffsets.size()));
+        for (auto offset : field.pathOffsets)
+        {
+            writeValue<uint64_t>(mOut, offset);
+        }
+        writeString(mOut, field.expression);
+    }
+    if (!mOut)
+    {
+        return fail("Could not write the header of " + path);
+    }
+    return true;
+}
+
+bool S2Plugin::LoggerRecording::writeChunk(uint64_t firstSample, uint32_t sampleCount, const std::vector<uint8_t>& data)
+{
+    if (!mOut.is_open())
+    {
+        return fail("The recording isn't open for writing");
+    }
+    // LZ4 rather than something that compresses better: chunks are compressed on the UI thread while recording
+    auto uncompressedSize = static_cast<int>(data.size());
+    mCompressed.resize(LZ4_compressBound(uncompressedSize));
+    auto compressedSize = LZ4_compress(reinterpret_cast<const char*>(data.data()), mCompressed.data(), uncompressedSize);
+    if (compressedSize <= 0 && uncompressedSize != 0)
+    {
+        return fail("Compressing a chunk of " + mPath + " failed");
+    }
+
+    LoggerRecordingChunk chunk;
+    chunk.fileOffset = static_cast<uint64_t>(mOut.tellp()) + gsChunkHeaderSize;
+    chunk.firstSample = firstSample;
+    chunk.sampleCount = sampleCount;
+    chunk.uncompressedSize = static_cast<uint32_t>(uncompressedSize);
+    chunk.compressedSize = static_cast<uint32_t>(compressedSize);
+
+    mOut.write(gsChunkMagic, sizeof(gsChunkMagic));
+    writeValue<uint64_t>(mOut, chunk.firstSample);
+    writeValue<uint32_t>(mOut, chunk.sampleCount);
+    writeValue<uint32_t>(mOut, chunk.uncompressedSize);
+    writeValue<uint32_t>(mOut, chunk.compressedSize);
+    mOut.write(mCompressed.data(), compressedSize);
+    if (!mOut)
+    {
+        return fail("Writing to " + mPath + " failed");
+    }
+    mChunks.emplace_back(chunk);
+    return true;
+}
+
+bool S2Plugin::LoggerRecording::finish()
+{
+    if (!mOut.is_open())
+    {
+        return fail("The recording isn't open for writing");
+    }
+    auto indexOffset = static_cast<uint64_t>(mOut.tellp());
+    mOut.write(gsIndexMagic, sizeof(gsIndexMagic));
+    for (const auto& chunk : mChunks)
+    {
+        writeValue<uint64_t>(mOut, chunk.fileOffset);
+        writeValue<uint64_t>(mOut, chunk.firstSample);
+        writeValue<uint32_t>(mOut, chunk.sampleCount);
+        writeValue<uint32_t>(mOut, chunk.uncompressedSize);
+        writeValue<uint32_t>(mOut, chunk.compressedSize);
+    }
+    writeValue<uint64_t>(mOut, indexOffset);
+    writeValue<uint32_t>(mOut, static_cast<uint32_t>(mChunks.size()));
+    mOut.write(gsIndexMagic, sizeof(gsIndexMagic));
+    auto ok = static_cast<bool>(mOut);
+    mOut.close();
+    return ok ? true : fail("Writing the index of " + mPath + " failed");
+}
+
+bool S2Plugin::LoggerRecording::open(const std::string& path)
+{
+    mError.clear();
+    mOut.close();
+    mIn.close();
+    mPath = path;
+    mFields.clear();
+    mChunks.clear();
+
+    mIn.open(path, std::ios::binary);
+    if (!mIn)
+    {
+        return fail("Could not open " + path);
+    }
+    uint32_t version = 0;
+    uint32_t fieldCount = 0;
+    if (!readMagic(mIn, gsRecordingMagic) || !readValue(mIn, version))
+    {
+        return fail(path + " is not a Logger recording");
+    }
+    if (version != gsRecordingVersion)
+    {
+        return fail(path + " was recorded by another version of the plugin");
+    }
+    if (!readValue(mIn, fieldCount))
+    {
+        return fail("The header of " + path + " is truncated");
+    }
+    for (uint32_t x = 0; x < fieldCount; ++x)
+    {
+        LoggerField field;
+        uint32_t type = 0;
+        uint64_t memoryOffset = 0;
+        uint32_t color = 0;
+        if (!readString(mIn, field.name) || !readString(mIn, field.uuid) || !readValue(mIn, type) || !readValue(mIn, memoryOffset) || !readValue(mIn, color))
+        {
+            return fail("The field descriptions of " + path + " are truncated");
+        }
+        field.type = static_cast<MemoryFieldType>(type);
+        field.memoryOffset = memoryOffset;
+        field.color = QColor::fromRgba(color);
+        uint8_t kind = 0;
+        uint32_t pathLength = 0;
+        if (!readValue(mIn, kind) || !readValue(mIn, field.bit) || !readValue(mIn, pathLength) || pathLength > 0xFF)
+        {
+            return fail("The field descriptions of " + path + " are truncated");
+        }
+        for (uint32_t y = 0; y < pathLength; ++y)
+        {
+            uint64_t offset = 0;
+            if (!readValue(mIn, offset))
+            {
+                return fail("The field descriptions of " + path + " are truncated");
+            }
+            field.pathOffsets.emplace_back(offset);
+        }
+        if (!readString(mIn, field.expression))
+        {
+            return fail("The field descriptions of " + path + " are truncated");
+        }
+        field.kind = static_cast<LoggerFieldKind>(kind);
+        mFields.emplace_back(std::move(field));
+    }
+    return readIndex(static_cast<uint64_t>(mIn.tellg()));
+}
+
+bool S2Plugin::LoggerRecording::readIndex(uint64_t dataStart)
+{
+    mIn.seekg(0, std::ios::end);
+    auto fileSize = static_cast<uint64_t>(mIn.tellg());
+
+    // the chunk sizes are only trusted when they follow from the fields, and the samples run on from chunk to chunk;
+    // LZ4 doesn't compress better than 255 to 1, so a chunk can't decompress to more than that
+    uint64_t sampleSize = sizeof(uint32_t) + sizeof(uint64_t);
+    for (const auto& field : mFields)
+    {
+        sampleSize += LoggerSampleColumn(field.columnType()).valueSize();
+    }
+    auto validChunk = [&](const LoggerRecordingChunk& chunk)
+    {
+        auto nextSample = mChunks.empty() ? 0 : mChunks.back().firstSample + mChunks.back().sampleCount;
+        return chunk.firstSample == nextSample && chunk.uncompressedSize == chunk.sampleCount * sampleSize && chunk.fileOffset >= dataStart &&
+               chunk.fileOffset + chunk.compressedSize <= fileSize && chunk.uncompressedSize <= uint64_t(chunk.compressedSize) * 255;
+    };
+
+    // a finished recording ends in the index
+    if (fileSize >= dataStart + gsTrailerSize)
+    {
+        uint64_t indexOffset = 0;
+        uint32_t chunkCount = 0;
+        mIn.seekg(fileSize - gsTrailerSize);
+        if (readValue(mIn, indexOffset) && readValue(mIn, chunkCount) && readMagic(mIn, gsIndexMagic) && indexOffset >= dataStart && indexOffset < fileSize)
+        {
+            mIn.seekg(indexOffset);
+            if (readMagic(mIn, gsIndexMagic))
+            {
+                for (uint32_t x = 0; x < chunkCount; ++x)
+                {
+                    LoggerRecordingChunk chunk;
+                    if (!readValue(mIn, chunk.fileOffset) || !readValue(mIn, chunk.firstSample) || !readValue(mIn, chunk.sampleCount) || !readValue(mIn, chunk.uncompressedSize) ||
+                        !readValue(mIn, chunk.compressedSize) || !validChunk(chunk))
+                    {
+                        break;
+                    }
+                    mChunks.emplace_back(chunk);
+                }
+                if (mChunks.size() == chunkCount)
+                {
+                    return true;
+                }
+            }
+        }
+        mChunks.clear();
+        mIn.clear();
+    }
+
+    // otherwise walk the chunks up to the first one that didn't make it to disk completely
+    for (auto position = dataStart; position + gsChunkHeaderSize <= fileSize;)
+    {
+        LoggerRecordingChunk chunk;
+        mIn.seekg(position);
+        if (!readMagic(mIn, gsChunkMagic) || !readValue(mIn, chunk.firstSample) || !readValue(mIn, chunk.sampleCount) || !readValue(mIn, chunk.uncompressedSize) ||
+            !readValue(mIn, chunk.compressedSize))
+        {
+            break;
+        }
+        chunk.fileOffset = position + gsChunkHeaderSize;
+        if (!validChunk(chunk))
+        {
+            break;
+        }
+        mChunks.emplace_back(chunk);
+        position = chunk.fileOffset + chunk.compressedSize;
+    }
+    mIn.clear();
+    return true;
+}
+
+bool S2Plugin::LoggerRecording::readChunk(size_t chunkIndex, std::vector<uint8_t>& data)
+{
+    if (!mIn.is_open() || chunkIndex >= mChunks.size())
+    {
+        return fail("The recording isn't open for reading");
+    }
+    const auto& chunk = mChunks[chunkIndex];
+    mCompressed.resize(chunk.compressedSize);
+    mIn.seekg(chunk.fileOffset);
+    if (!mIn.read(mCompressed.data(), mCompressed.size()))
+    {
+        mIn.clear();
+        return fail("Reading from " + mPath + " failed");
+    }
+    data.resize(chunk.uncompressedSize);
+    if (chunk.uncompressedSize == 0)
+    {
+        return true;
+    }
+    auto decompressedSize = LZ4_decompress_safe(mCompressed.data(), reinterpret_cast<char*>(data.data()), static_cast<int>(chunk.compressedSize),
+                                                static_cast<int>(chunk.uncompressedSize));
+    if (decompressedSize != static_cast<int>(chunk.uncompressedSize))
+    {
+        return fail("A chunk of " + mPath + " is corrupt");
+    }
+    return true;
+}
+
+const std::vector<S2Plugin::LoggerField>& S2Plugin::LoggerRecording::fields() const noexcept
+{
+    return mFields;
+}
+
+const std::vector<S2Plugin::LoggerRecordingChunk>& S2Plugin::LoggerRecording::chunks() const noexcept
+{
+    return mChunks;
+}
+
+uint64_t S2Plugin::LoggerRecording::sampleCount() const noexcept
+{
+    return mChunks.empty() ? 0 : mChunks.back().firstSample + mChunks.back().sampleCount;
+}
+
+const std::string& S2Plugin::LoggerRecording::path() const noexcept
+{
+    return mPath;
+}
+
+const std::string& S2Plugin::LoggerRecording::error() const noexcept
+{
+    return mError;
+}
+
+bool S2Plugin::LoggerRecording::fail(const std::string& error)
+{
+    if (mError.empty())
+    {
+        mError = error;
+    }
+    return false;
+}
@@ -0,0 +1,290 @@
+#include "Data/LoggerSampleColumn.h"
+#include "Spelunky2.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+S2Plugin::LoggerSampleColumn::LoggerSampleColumn(MemoryFieldType type)
+{
+    switch (type)
+    {
+        case MemoryFieldType::Byte:
+            mStorage = std::vector<int8_t>();
+            break;
+        case MemoryFieldType::UnsignedByte:
+        case MemoryFieldType::Bool:
+        case MemoryFieldType::Flags8:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::CharacterDBID:
+            mStorage = std::vector<uint8_t>();
+            break;
+        case MemoryFieldType::Word:
+            mStorage = std::vector<int16_t>();
+            break;
+        case MemoryFieldType::UnsignedWord:
+        case MemoryFieldType::Flags16:
+        case MemoryFieldType::State16:
+            mStorage = std::vector<uint16_t>();
+            break;
+        case MemoryFieldType::Dword:
+            mStorage = std::vector<int32_t>();
+            break;
+        case MemoryFieldType::Float:
+            mStorage = std::vector<float>();
+            break;
+        case MemoryFieldType::Qword:
+            mStorage = std::vector<int64_t>();
+            break;
+        case MemoryFieldType::UnsignedQword:
+            mStorage = std::vector<uint64_t>();
+            break;
+        default: // UnsignedDword, Flags32, State32 and the 32 bit IDs
+            mStorage = std::vector<uint32_t>();
+            break;
+    }
+}
+
+void S2Plugin::LoggerSampleColumn::appendRaw(const void* data)
+{
+    std::visit(
+        [this, data](auto& values)
+        {
+            typename std::decay_t<decltype(values)>::value_type value;
+            std::memcpy(&value, data, sizeof(value));
+            values.emplace_back(value);
+            aggregate(static_cast<double>(value));
+        },
+        mStorage);
+}
+
+double S2Plugin::LoggerSampleColumn::valueFromRaw(const void* data) const
+{
+    return std::visit(
+        [data](const auto& values)
+        {
+            typename std::decay_t<decltype(values)>::value_type value;
+            std::memcpy(&value, data, sizeof(value));
+            return static_cast<double>(value);
+        },
+        mStorage);
+}
+
+void S2Plugin::LoggerSampleColumn::reserve(size_t count)
+{
+    std::visit([count](auto& values) { values.reserve(count); }, mStorage);
+}
+
+void S2Plugin::LoggerSampleColumn::clear()
+{
+    std::visit([](auto& values) { values.clear(); }, mStorage);
+    mResidentFirst = 0;
+    mStatistics = LoggerSampleStatistics();
+    mBlockBounds.clear();
+}
+
+void S2Plugin::LoggerSampleColumn::evictBefore(size_t index)
+{
+    std::visit(
+        [this, index](auto& values)
+        {
+            auto count = (std::min)(index - (std::min)(index, mResidentFirst), values.size());
+            values.erase(values.begin(), values.begin() + count);
+            mResidentFirst += count;
+        },
+        mStorage);
+}
+
+void S2Plugin::LoggerSampleColumn::resetResident(size_t first)
+{
+    std::visit([](auto& values) { values.clear(); }, mStorage);
+    mResidentFirst = first;
+}
+
+void S2Plugin::LoggerSampleColumn::restoreRaw(const void* data, size_t count)
+{
+    std::visit(
+        [data, count](auto& values)
+        {
+            auto offset = values.size();
+            values.resize(offset + count);
+            std::memcpy(values.data() + offset, data, count * sizeof(values[0]));
+        },
+        mStorage);
+}
+
+void S2Plugin::LoggerSampleColumn::copyRaw(size_t first, size_t count, void* out) const
+{
+    std::visit([this, first, count, out](const auto& values) { std::memcpy(out, values.data() + (first - mResidentFirst), count * sizeof(values[0])); }, mStorage);
+}
+
+size_t S2Plugin::LoggerSampleColumn::residentFirst() const noexcept
+{
+    return mResidentFirst;
+}
+
+bool S2Plugin::LoggerSampleColumn::isResident(size_t first, size_t last) const noexcept
+{
+    return std::visit([this, first, last](const auto& values) { return first >= mResidentFirst && last <= mResidentFirst + values.size(); }, mStorage);
+}
+
+void S2Plugin::LoggerSampleColumn::aggregate(double value)
+{
+    // the sample was appended already
+    auto index = mStatistics.count++;
+    if (index == 0)
+    {
+        mStatistics.min = value;
+        mStatistics.max = value;
+    }
+    else
+    {
+        mStatistics.min = (std::min)(mStatistics.min, value);
+        mStatistics.max = (std::max)(mStatistics.max, value);
+    }
+    auto delta = value - mStatistics.mean;
+    mStatistics.mean += delta / mStatistics.count;
+    mStatistics.m2 += delta * (value - mStatistics.mean);
+    mBlockBounds.merge(index / msBlockSize, value);
+}
+
+const S2Plugin::LoggerSampleStatistics& S2Plugin::LoggerSampleColumn::statistics() const noexcept
+{
+    return mStatistics;
+}
+
+size_t S2Plugin::LoggerSampleColumn::size() const noexcept
+{
+    return static_cast<size_t>(mStatistics.count);
+}
+
+size_t S2Plugin::LoggerSampleColumn::valueSize() const noexcept
+{
+    return std::visit([](const auto& values) { return sizeof(typename std::decay_t<decltype(values)>::value_type); }, mStorage);
+}
+
+QVariant S2Plugin::LoggerSampleColumn::valueAt(size_t index) const
+{
+    if (!isResident(index, index + 1))
+    {
+        return QVariant();
+    }
+    return std::visit([this, index](const auto& values) { return displayFromRaw(&values[index - mResidentFirst]); }, mStorage);
+}
+
+QVariant S2Plugin::LoggerSampleColumn::displayFromRaw(const void* data) const
+{
+    return std::visit(
+        [data](const auto& values)
+        {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            T value;
+            std::memcpy(&value, data, sizeof(value));
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                return QVariant(value);
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                return QVariant(static_cast<qlonglong>(value));
+            }
+            else
+            {
+                return QVariant(static_cast<qulonglong>(value));
+            }
+        },
+        mStorage);
+}
+
+std::pair<int64_t, int64_t> S2Plugin::LoggerSampleColumn::bounds() const
+{
+    // for all intents and purposes, the values should reasonably all fit in 2^64 / 2
+    if (mStatistics.count == 0)
+    {
+        return std::make_pair((std::numeric_limits<int64_t>::max)(), (std::numeric_limits<int64_t>::min)());
+    }
+    return std::make_pair(static_cast<int64_t>(std::floor(mStatistics.min)), static_cast<int64_t>(std::ceil(mStatistics.max)));
+}
+
+std::pair<double, double> S2Plugin::LoggerSampleColumn::rangeBounds(size_t first, size_t last) const
+{
+    last = (std::min)(last, size());
+    if (first >= last)
+    {
+        return std::make_pair(0., 0.);
+    }
+    auto lowest = (std::numeric_limits<double>::max)();
+    auto highest = std::numeric_limits<double>::lowest();
+    auto scan = [&](size_t from, size_t to)
+    {
+        if (from >= to)
+        {
+            return;
+        }
+        if (!isResident(from, to))
+        {
+            // evicted to the recording file, the bounds of the blocks around them are close enough
+            auto [blockLowest, blockHighest] = mBlockBounds.query(from / msBlockSize, ((to - 1) / msBlockSize) + 1);
+            lowest = (std::min)(lowest, blockLowest);
+            highest = (std::max)(highest, blockHighest);
+            return;
+        }
+        visit(
+            [&](const auto& values)
+            {
+                for (auto x = from; x < to; ++x)
+                {
+                    lowest = (std::min)(lowest, static_cast<double>(values[x - mResidentFirst]));
+                    highest = (std::max)(highest, static_cast<double>(values[x - mResidentFirst]));
+                }
+            });
+    };
+    auto firstBlock = (first + msBlockSize - 1) / msBlockSize;
+    auto lastBlock = last / msBlockSize;
+    if (firstBlock >= lastBlock)
+    {
+        scan(first, last);
+    }
+    else
+    {
+        scan(first, firstBlock * msBlockSize);
+        auto [blockLowest, blockHighest] = mBlockBounds.query(firstBlock, lastBlock);
+        lowest = (std::min)(lowest, blockLowest);
+        highest = (std::max)(highest, blockHighest);
+        scan(lastBlock * msBlockSize, last);
+    }
+    return std::make_pair(lowest, highest);
+}
+
+void S2Plugin::LoggerSampleColumn::decimate(size_t first, size_t last, size_t slices, std::vector<std::pair<double, double>>& out) const
+{
+    out.clear();
+    last = (std::min)(last, size());
+    if (first >= last || slices == 0)
+    {
+        return;
+    }
+    out.reserve(slices);
+    auto count = last - first;
+    auto snap = (count / slices) >= (2 * msBlockSize);
+    for (size_t slice = 0; slice < slices; ++slice)
+    {
+        auto from = first + ((count * slice) / slices);
+        auto to = first + ((count * (slice + 1)) / slices);
+        if (snap)
+        {
+            from -= from % msBlockSize;
+            to = (std::min)(to - (to % msBlockSize), last);
+            if (slice + 1 == slices)
+            {
+                to = last;
+            }
+        }
+        if (to <= from)
+        {
+            to = from + 1;
+        }
+        out.emplace_back(rangeBounds(from, to));
+    }
+}
@@ -0,0 +1,103 @@
+#include "Data/LoggerSampler.h"
+#include "Data/FrameClock.h"
+#include "pluginmain.h"
+#include <timeapi.h>
+
+S2Plugin::LoggerSampler::LoggerSampler(const LoggerFieldReader& reader, std::chrono::microseconds period, std::chrono::milliseconds duration, const FrameClock* frameClock)
+    : mReader(reader), mPeriod(period), mDuration(duration), mFrameClock(frameClock), mRing(sizeof(RecordHeader) + reader.valuesSize(), msRingCapacity)
+{
+}
+
+S2Plugin::LoggerSampler::~LoggerSampler()
+{
+    stop();
+}
+
+void S2Plugin::LoggerSampler::start()
+{
+    stop();
+    mFinished = false;
+    mRunning = true;
+    mWorker = std::thread(&LoggerSampler::run, this);
+}
+
+void S2Plugin::LoggerSampler::stop()
+{
+    mRunning = false;
+    if (mWorker.joinable())
+    {
+        mWorker.join();
+    }
+}
+
+bool S2Plugin::LoggerSampler::finished() const noexcept
+{
+    return mFinished;
+}
+
+uint64_t S2Plugin::LoggerSampler::sampleCount() const noexcept
+{
+    return mSamples;
+}
+
+uint64_t S2Plugin::LoggerSampler::overrunCount() const noexcept
+{
+    return mOverruns;
+}
+
+uint64_t S2Plugin::LoggerSampler::droppedCount() const noexcept
+{
+    return mDropped;
+}
+
+uint64_t S2Plugin::LoggerSampler::readNanoseconds() const noexcept
+{
+    return mReadNanoseconds;
+}
+
+void S2Plugin::LoggerSampler::run()
+{
+    // the default timer resolution on Windows is ~15ms, which is coarser than most periods
+    timeBeginPeriod(1);
+    std::vector<uint8_t> record(mRing.recordSize(), 0);
+    auto values = record.data() + sizeof(RecordHeader);
+
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + mDuration;
+    uint64_t tick = 0;
+    while (mRunning)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= end)
+        {
+            break;
+        }
+
+        RecordHeader header{};
+        header.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+        header.frame = mFrameClock == nullptr ? 0 : mFrameClock->latestFrame();
+        mReader.read(values);
+        mReadNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - now).count();
+        std::memcpy(record.data(), &header, sizeof(RecordHeader));
+        ++mSamples;
+        if (!mRing.push(record.data()))
+        {
+            ++mDropped;
+        }
+
+        // the next tick that's still ahead of us
+        ++tick;
+        auto next = start + (mPeriod * tick);
+        now = std::chrono::steady_clock::now();
+        if (next <= now)
+        {
+            auto behind = static_cast<uint64_t>((now - next) / mPeriod) + 1;
+            mOverruns += behind;
+            tick += behind;
+            next = start + (mPeriod * tick);
+        }
+        std::this_thread::sleep_until(next);
+    }
+    mFinished = true;
+    timeEndPeriod(1);
+}
@@ -0,0 +1,84 @@
+#include "Data/LoggerSession.h"
+#include "Data/LoggerRecording.h"
+#include <cstring>
+
+size_t S2Plugin::LoggerSession::sampleCount() const noexcept
+{
+    return frames.size();
+}
+
+int64_t S2Plugin::LoggerSession::fieldIndex(const std::string& fieldName) const
+{
+    for (size_t x = 0; x < fields.size(); ++x)
+    {
+        if (fields[x].name == fieldName)
+        {
+            return static_cast<int64_t>(x);
+        }
+    }
+    return -1;
+}
+
+int64_t S2Plugin::LoggerSession::frameOf(size_t sample) const
+{
+    // without a frame counter every sample is tagged frame 0
+    if (frames.empty() || (frames.front() == 0 && frames.back() == 0))
+    {
+        return static_cast<int64_t>(sample);
+    }
+    return frames[sample];
+}
+
+bool S2Plugin::LoggerSession::loadRecording(const std::string& path, std::string& error)
+{
+    LoggerRecording recording;
+    if (!recording.open(path))
+    {
+        error = recording.error();
+        return false;
+    }
+    fields = recording.fields();
+    columns.clear();
+    frames.clear();
+    size_t valuesSize = 0;
+    for (const auto& field : fields)
+    {
+        valuesSize += columns.emplace_back(field.columnType()).valueSize();
+    }
+    for (auto& column : columns)
+    {
+        column.reserve(recording.sampleCount());
+    }
+    frames.reserve(recording.sampleCount());
+
+    std::vector<uint8_t> data;
+    for (size_t x = 0; x < recording.chunks().size(); ++x)
+    {
+        const auto& chunk = recording.chunks()[x];
+        if (!recording.readChunk(x, data))
+        {
+            error = recording.error();
+            return false;
+        }
+        size_t count = chunk.sampleCount;
+        if (data.size() != count * (sizeof(uint32_t) + sizeof(uint64_t) + valuesSize) || chunk.firstSample != frames.size())
+        {
+            error = "A chunk of " + path + " doesn't match the fields of the recording";
+            return false;
+        }
+        auto resident = frames.size();
+        frames.resize(resident + count);
+        std::memcpy(frames.data() + resident, data.data(), count * sizeof(uint32_t));
+        auto in = data.data() + (count * (sizeof(uint32_t) + sizeof(uint64_t)));
+        for (auto& column : columns)
+        {
+            auto valueSize = column.valueSize();
+            for (size_t sample = 0; sample < count; ++sample)
+            {
+                column.appendRaw(in + (sample * valueSize));
+            }
+            in += count * valueSize;
+        }
+    }
+    return true;
+}
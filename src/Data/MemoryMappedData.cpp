@@ -152,3 +152,94 @@ size_t S2Plugin::MemoryMappedData::sizeOf(const std::string& typeName)
         return 0;
     }
 }
+
+bool S2Plugin::MemoryMappedData::isScalarType(MemoryFieldType type) noexcept
+{
+    switch (type)
+    {
+        case MemoryFieldType::Byte:
+        case MemoryFieldType::UnsignedByte:
+        case MemoryFieldType::Word:
+        case MemoryFieldType::UnsignedWord:
+        case MemoryFieldType::Dword:
+        case MemoryFieldType::UnsignedDword:
+        case MemoryFieldType::Qword:
+        case MemoryFieldType::UnsignedQword:
+        case MemoryFieldType::Float:
+        case MemoryFieldType::Bool:
+        case MemoryFieldType::Flags8:
+        case MemoryFieldType::Flags16:
+        case MemoryFieldType::Flags32:
+        case MemoryFieldType::State8:
+        case MemoryFieldType::State16:
+        case MemoryFieldType::State32:
+        case MemoryFieldType::EntityDBID:
+        case MemoryFieldType::EntityUID:
+        case MemoryFieldType::ParticleDBID:
+        case MemoryFieldType::TextureDBID:
+        case MemoryFieldType::StringsTableID:
+        case MemoryFieldType::CharacterDBID:
+        case MemoryFieldType::CodePointer:
+        case MemoryFieldType::DataPointer:
+        case MemoryFieldType::EntityPointer:
+        case MemoryFieldType::EntityDBPointer:
+        case MemoryFieldType::TextureDBPointer:
+        case MemoryFieldType::ParticleDBPointer:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::vector<S2Plugin::EntityScalarField> S2Plugin::MemoryMappedData::entityScalarFields(const std::string& entityClass)
+{
+    auto& ech = mConfiguration->entityClassHierarchy();
+    std::vector<std::string> hierarchy;
+    std::string t = entityClass;
+    while (t != "Entity" && !t.empty())
+    {
+        hierarchy.push_back(t);
+        auto ech_it = ech.find(t);
+        if (ech_it == ech.end())
+        {
+            break;
+        }
+        t = ech_it->second;
+    }
+    hierarchy.push_back("Entity");
+
+    std::vector<EntityScalarField> scalarFields;
+    size_t offset = 0;
+    for (auto it = hierarchy.rbegin(); it != hierarchy.rend(); ++it)
+    {
+        collectScalarFields(mConfiguration->typeFieldsOfEntitySubclass(*it), *it + ".", offset, scalarFields);
+    }
+    return scalarFields;
+}
+
+void S2Plugin::MemoryMappedData::collectScalarFields(const std::vector<MemoryField>& fields, const std::string& prefix, size_t& offset, std::vector<EntityScalarField>& scalarFields)
+{
+    std::unordered_map<std::string, size_t> offsetsDummy;
+    for (const auto& field : fields)
+    {
+        if (field.type == MemoryFieldType::InlineStructType)
+        {
+            collectScalarFields(mConfiguration->typeFieldsOfInlineStruct(field.jsonName), prefix + field.name + ".", offset, scalarFields);
+            continue;
+        }
+        if (field.type == MemoryFieldType::PointerType || field.type == MemoryFieldType::UndeterminedThemeInfoPointer)
+        {
+            // don't follow the pointer, there is no memory behind a relative offset
+            offset += sizeof(size_t);
+            continue;
+        }
+
+        auto nextOffset = setOffsetForField(field, "dummy", offset, offsetsDummy);
+        auto size = nextOffset - offset;
+        if (isScalarType(field.type) && size > 0 && size <= sizeof(uint64_t))
+        {
+            scalarFields.emplace_back(EntityScalarField{prefix + field.name, field.type, offset, size});
+        }
+        offset = nextOffset;
+    }
+}
@@ -0,0 +1,88 @@
+#include "Data/MinMaxTree.h"
+#include <algorithm>
+#include <limits>
+
+void S2Plugin::MinMaxTree::merge(size_t leaf, double value)
+{
+    if (leaf >= mCapacity)
+    {
+        grow();
+    }
+    auto node = mCapacity + leaf;
+    if (leaf == mSize)
+    {
+        ++mSize;
+        mMin[node] = value;
+        mMax[node] = value;
+    }
+    else
+    {
+        mMin[node] = (std::min)(mMin[node], value);
+        mMax[node] = (std::max)(mMax[node], value);
+    }
+    // stop as soon as a parent already covers the value
+    for (node /= 2; node > 0; node /= 2)
+    {
+        auto lowest = (std::min)(mMin[2 * node], mMin[(2 * node) + 1]);
+        auto highest = (std::max)(mMax[2 * node], mMax[(2 * node) + 1]);
+        if (lowest == mMin[node] && highest == mMax[node])
+        {
+            break;
+        }
+        mMin[node] = lowest;
+        mMax[node] = highest;
+    }
+}
+
+void S2Plugin::MinMaxTree::clear()
+{
+    mCapacity = 0;
+    mSize = 0;
+    mMin.clear();
+    mMax.clear();
+}
+
+size_t S2Plugin::MinMaxTree::size() const noexcept
+{
+    return mSize;
+}
+
+std::pair<double, double> S2Plugin::MinMaxTree::query(size_t first, size_t last) const
+{
+    auto lowest = (std::numeric_limits<double>::max)();
+    auto highest = std::numeric_limits<double>::lowest();
+    for (auto l = first + mCapacity, r = last + mCapacity; l < r; l /= 2, r /= 2)
+    {
+        if (l & 1)
+        {
+            lowest = (std::min)(lowest, mMin[l]);
+            highest = (std::max)(highest, mMax[l]);
+            ++l;
+        }
+        if (r & 1)
+        {
+            --r;
+            lowest = (std::min)(lowest, mMin[r]);
+            highest = (std::max)(highest, mMax[r]);
+        }
+    }
+    return std::make_pair(lowest, highest);
+}
+
+void S2Plugin::MinMaxTree::grow()
+{
+    // unused leaves hold the identity values, so they never win a comparison
+    auto capacity = mCapacity == 0 ? 64 : mCapacity * 2;
+    std::vector<double> minima(2 * capacity, (std::numeric_limits<double>::max)());
+    std::vector<double> maxima(2 * capacity, std::numeric_limits<double>::lowest());
+    std::copy(mMin.begin() + mCapacity, mMin.begin() + mCapacity + mSize, minima.begin() + capacity);
+    std::copy(mMax.begin() + mCapacity, mMax.begin() + mCapacity + mSize, maxima.begin() + capacity);
+    for (auto node = capacity - 1; node > 0; --node)
+    {
+        minima[node] = (std::min)(minima[2 * node], minima[(2 * node) + 1]);
+        maxima[node] = (std::max)(maxima[2 * node], maxima[(2 * node) + 1]);
+    }
+    mCapacity = capacity;
+    mMin = std::move(minima);
+    mMax = std::move(maxima);
+}
@@ -28,7 +28,7 @@ bool S2Plugin::ParticleDB::loadParticleDB()
     mParticleDBPtr = instructionOffset + 13 + (duint)Script::Memory::ReadDword(instructionOffset + 7);
 
     auto counter = 0;
-    size_t particleDBEntrySize = 0xA0;
+    size_t particleDBEntrySize = msEntrySize;
     while (counter < 250)
     {
         size_t startOffset = mParticleDBPtr + (counter * particleDBEntrySize);
@@ -62,6 +62,12 @@ std::unordered_map<std::string, size_t>& S2Plugin::ParticleDB::offsetsForIndex(u
     return empty;
 }
 
+S2Plugin::DatabaseTableLayout S2Plugin::ParticleDB::tableLayout() const noexcept
+{
+    // the ids run from 1 without gaps, loading stops at the first one that doesn't follow
+    return DatabaseTableLayout{mParticleDBPtr, mMemoryOffsets.size(), msEntrySize};
+}
+
 void S2Plugin::ParticleDB::reset()
 {
     mParticleDBPtr = 0;
@@ -1,7 +1,11 @@
 #include "Data/State.h"
 #include "Configuration.h"
+#include "Data/EntityDB.h"
 #include "Spelunky2.h"
 #include "pluginmain.h"
+#include <array>
+#include <cstring>
+#include <vector>
 
 S2Plugin::State::State(Configuration* config) : MemoryMappedData(config) {}
 
@@ -70,6 +74,9 @@ std::unordered_map<std::string, size_t>& S2Plugin::State::offsets()
 void S2Plugin::State::refreshOffsets()
 {
     mMemoryOffsets.clear();
+    mFrameValid = false;
+    mUIDIndexValid = false;
+    mEntityHeaders.clear();
     auto offset = mStatePtr;
     for (const auto& field : mConfiguration->typeFields(MemoryFieldType::State))
     {
@@ -123,8 +130,200 @@ size_t S2Plugin::State::findNextEntity(size_t entityOffset)
     return nextOffset;
 }
 
+size_t S2Plugin::State::frameCounterAddress() const
+{
+    return offsetForField("time_startup");
+}
+
+void S2Plugin::State::refreshFrame()
+{
+    // time_startup ticks once per game frame; within a refresh pass it was already read when the pass began
+    if (mFrameValid && mRefreshPassDepth != 0)
+    {
+        return;
+    }
+
+    auto frame = Script::Memory::ReadDword(frameCounterAddress());
+    if (!mFrameValid || frame != mFrame)
+    {
+        mFrame = frame;
+        mFrameValid = true;
+        invalidateFrameCache();
+    }
+}
+
+void S2Plugin::State::invalidateFrameCache()
+{
+    mUIDIndexValid = false;
+    mEntityHeaders.clear();
+}
+
+void S2Plugin::State::beginRefreshPass()
+{
+    if (mRefreshPassDepth++ == 0)
+    {
+        invalidateFrameCache();
+        mFrameValid = false;
+        refreshFrame();
+    }
+}
+
+void S2Plugin::State::endRefreshPass()
+{
+    if (mRefreshPassDepth != 0)
+    {
+        --mRefreshPassDepth;
+    }
+}
+
+S2Plugin::EntityUIDLocation S2Plugin::State::locateEntityByUID(uint32_t uid)
+{
+    refreshFrame();
+    updateUIDIndex();
+
+    ++mUIDLookups;
+    auto it = mUIDIndex.find(uid);
+    if (it == mUIDIndex.end())
+    {
+        return EntityUIDLocation{};
+    }
+    ++mUIDLookupHits;
+    return it->second;
+}
+
+S2Plugin::EntityHeader S2Plugin::State::entityHeader(size_t entity, EntityDB* entityDB)
+{
+    if (entity == 0)
+    {
+        return EntityHeader{};
+    }
+    refreshFrame();
+    auto it = mEntityHeaders.find(entity);
+    if (it != mEntityHeaders.end())
+    {
+        return it->second;
+    }
+
+    // vtable +0x0, EntityDB entry +0x8, overlay +0x10, uid +0x38, x +0x40, y +0x44
+    EntityHeader header;
+    std::array<uint8_t, 0x50> buffer;
+    if (Script::Memory::Read(entity, buffer.data(), buffer.size(), nullptr))
+    {
+        std::memcpy(&header.vtable, buffer.data(), sizeof(size_t));
+        std::memcpy(&header.entityDBPointer, buffer.data() + 0x8, sizeof(size_t));
+        std::memcpy(&header.overlay, buffer.data() + 0x10, sizeof(size_t));
+        std::memcpy(&header.uid, buffer.data() + 0x38, sizeof(uint32_t));
+        std::memcpy(&header.x, buffer.data() + 0x40, sizeof(float));
+        std::memcpy(&header.y, buffer.data() + 0x44, sizeof(float));
+        header.typeID = entityDB->typeIDForEntityDBPointer(header.entityDBPointer);
+        header.searchMask = entityDB->searchMaskForEntityDBPointer(header.entityDBPointer);
+
+        // the layer lives far beyond the header, the uid index already knows which layer's list holds the entity
+        updateUIDIndex();
+        auto location = mUIDIndex.find(header.uid);
+        if (location != mUIDIndex.end() && location->second.entity == entity)
+        {
+            header.layer = location->second.layer;
+        }
+    }
+    mEntityHeaders[entity] = header;
+    return header;
+}
+
+std::pair<float, float> S2Plugin::State::entityAbsolutePosition(size_t entity, EntityDB* entityDB)
+{
+    float x = 0;
+    float y = 0;
+    for (uint8_t depth = 0; entity != 0 && depth < 16; ++depth) // overlays don't nest deeply, but guard against garbage
+    {
+        auto header = entityHeader(entity, entityDB);
+        x += header.x;
+        y += header.y;
+        entity = header.overlay;
+    }
+    return std::make_pair(x, y);
+}
+
+void S2Plugin::State::updateUIDIndex()
+{
+    if (mUIDIndexValid)
+    {
+        return;
+    }
+    mUIDIndexValid = true;
+    ++mUIDIndexBuilds;
+    mUIDIndex.clear();
+    uint8_t layerIndex = 0;
+    LayerEntities layerEntities;
+    for (const auto& layerField : {"layer0", "layer1"})
+    {
+        if (readLayerEntities(Script::Memory::ReadQword(offsetForField(layerField)), layerEntities))
+        {
+            for (size_t x = 0; x < layerEntities.entities.size(); ++x)
+            {
+                if (layerEntities.entities[x] != 0)
+                {
+                    mUIDIndex[layerEntities.uids[x]] = EntityUIDLocation{layerEntities.entities[x], layerEntities.entityList + (x * sizeof(size_t)), layerIndex};
+                }
+            }
+        }
+        ++layerIndex;
+    }
+}
+
+bool S2Plugin::State::readLayerEntities(size_t layer, LayerEntities& out)
+{
+    out.entities.clear();
+    out.uids.clear();
+    // entity list +0x8, uid list +0x10, count +0x1C
+    auto entityCount = layer == 0 ? 0 : Script::Memory::ReadDword(layer + 0x1C);
+    if (entityCount == 0)
+    {
+        return false;
+    }
+    out.entityList = Script::Memory::ReadQword(layer + 0x8);
+    out.entities.resize(entityCount);
+    out.uids.resize(entityCount);
+    if (!Script::Memory::Read(out.entityList, out.entities.data(), entityCount * sizeof(size_t), nullptr) ||
+        !Script::Memory::Read(Script::Memory::ReadQword(layer + 0x10), out.uids.data(), entityCount * sizeof(uint32_t), nullptr))
+    {
+        out.entities.clear();
+        out.uids.clear();
+        return false;
+    }
+    return true;
+}
+
+uint64_t S2Plugin::State::uidLookupCount() const noexcept
+{
+    return mUIDLookups;
+}
+
+uint64_t S2Plugin::State::uidLookupHitCount() const noexcept
+{
+    return mUIDLookupHits;
+}
+
+uint64_t S2Plugin::State::uidIndexBuildCount() const noexcept
+{
+    return mUIDIndexBuilds;
+}
+
 void S2Plugin::State::reset()
 {
     mStatePtr = 0;
     mMemoryOffsets.clear();
+    mFrameValid = false;
+    mUIDIndexValid = false;
+    mEntityHeaders.clear();
+}
+
+S2Plugin::StateRefreshPass::StateRefreshPass(State* state) : mState(state)
+{
+    mState->beginRefreshPass();
+}
+
+S2Plugin::StateRefreshPass::~StateRefreshPass()
+{
+    mState->endRefreshPass();
 }
@@ -28,13 +28,18 @@ bool S2Plugin::TextureDB::loadTextureDB()
 
     auto offset = mTextureDBPtr;
 
-    for (auto x = 0; x < (std::min)(1000ull, textureCount); ++x)
+    mEntryCount = (std::min)(1000ull, textureCount);
+    for (auto x = 0; x < mEntryCount; ++x)
     {
         std::unordered_map<std::string, size_t> offsets;
         for (const auto& field : mConfiguration->typeFields(MemoryFieldType::TextureDB))
         {
             offset = setOffsetForField(field, "TextureDB." + field.name, offset, offsets);
         }
+        if (x == 0)
+        {
+            mEntrySize = offset - mTextureDBPtr;
+        }
         auto textureID = Script::Memory::ReadQword(offsets.at("TextureDB.id"));
         mMemoryOffsets[textureID] = offsets;
 
@@ -60,6 +65,11 @@ bool S2Plugin::TextureDB::loadTextureDB()
     return true;
 }
 
+S2Plugin::DatabaseTableLayout S2Plugin::TextureDB::tableLayout() const noexcept
+{
+    return DatabaseTableLayout{mTextureDBPtr, mEntryCount, mEntrySize};
+}
+
 std::unordered_map<std::string, size_t>& S2Plugin::TextureDB::offsetsForTextureID(uint32_t textureDBID)
 {
     if (mMemoryOffsets.count(textureDBID) > 0)
@@ -72,6 +82,8 @@ std::unordered_map<std::string, size_t>& S2Plugin::TextureDB::offsetsForTextureI
 void S2Plugin::TextureDB::reset()
 {
     mTextureDBPtr = 0;
+    mEntryCount = 0;
+    mEntrySize = 0;
 }
 
 size_t S2Plugin::TextureDB::count()
@@ -0,0 +1,124 @@
+#include "QtHelpers/ItemModelCaptureSnapshots.h"
+#include <algorithm>
+#include <iterator>
+
+S2Plugin::ItemModelCaptureSnapshots::ItemModelCaptureSnapshots(QObject* parent) : QAbstractItemModel(parent) {}
+
+Qt::ItemFlags S2Plugin::ItemModelCaptureSnapshots::flags(const QModelIndex& index) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+QVariant S2Plugin::ItemModelCaptureSnapshots::data(const QModelIndex& index, int role) const
+{
+    auto row = static_cast<size_t>(index.row());
+    if (row >= mSnapshots.size() || (role != Qt::DisplayRole && role != Qt::ToolTipRole))
+    {
+        return QVariant();
+    }
+    const auto& snapshot = mSnapshots.at(row);
+    switch (index.column())
+    {
+        case gsColCaptureHit:
+            return static_cast<qulonglong>(snapshot.hit);
+        case gsColCaptureFrame:
+            return snapshot.frame;
+        case gsColCaptureMicroseconds:
+            return snapshot.microseconds;
+    }
+    auto regionIndex = static_cast<size_t>(index.column() - gsColCaptureFirstRegion);
+    if (regionIndex >= mRegions.size())
+    {
+        return QVariant();
+    }
+    auto size = mRegions[regionIndex].size;
+    if (role == Qt::DisplayRole)
+    {
+        size = (std::min)(size, msMaxShownBytes);
+    }
+    QString hex;
+    auto bytes = snapshot.data.data() + mRegionOffsets[regionIndex];
+    for (size_t x = 0; x < size; ++x)
+    {
+        hex += QString("%1 ").arg(static_cast<uint>(bytes[x]), 2, 16, QChar('0'));
+    }
+    return hex.trimmed().toUpper();
+}
+
+int S2Plugin::ItemModelCaptureSnapshots::rowCount(const QModelIndex& parent) const
+{
+    return static_cast<int>(mSnapshots.size());
+}
+
+int S2Plugin::ItemModelCaptureSnapshots::columnCount(const QModelIndex& parent) const
+{
+    return gsColCaptureFirstRegion + static_cast<int>(mRegions.size());
+}
+
+QModelIndex S2Plugin::ItemModelCaptureSnapshots::index(int row, int column, const QModelIndex& parent) const
+{
+    return createIndex(row, column);
+}
+
+QModelIndex S2Plugin::ItemModelCaptureSnapshots::parent(const QModelIndex& index) const
+{
+    return QModelIndex();
+}
+
+QVariant S2Plugin::ItemModelCaptureSnapshots::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+            case gsColCaptureHit:
+                return "Hit";
+            case gsColCaptureFrame:
+                return "Frame";
+            case gsColCaptureMicroseconds:
+                return "Capture (us)";
+        }
+        auto regionIndex = static_cast<size_t>(section - gsColCaptureFirstRegion);
+        if (regionIndex < mRegions.size())
+        {
+            return QString::fromStdString(mRegions[regionIndex].name);
+        }
+    }
+    return QVariant();
+}
+
+void S2Plugin::ItemModelCaptureSnapshots::setRegions(const std::vector<CaptureRegion>& regions)
+{
+    beginResetModel();
+    mRegions = regions;
+    mRegionOffsets.clear();
+    size_t offset = 0;
+    for (const auto& region : mRegions)
+    {
+        mRegionOffsets.emplace_back(offset);
+        offset += region.size;
+    }
+    mSnapshots.clear();
+    endResetModel();
+}
+
+void S2Plugin::ItemModelCaptureSnapshots::append(std::vector<CaptureSnapshot>& snapshots)
+{
+    if (snapshots.empty())
+    {
+        return;
+    }
+    // only the last msMaxSnapshots are kept, of the new ones as well
+    auto first = snapshots.size() > msMaxSnapshots ? snapshots.size() - msMaxSnapshots : 0;
+    auto newCount = snapshots.size() - first;
+    auto excess = (mSnapshots.size() + newCount > msMaxSnapshots) ? mSnapshots.size() + newCount - msMaxSnapshots : 0;
+    if (excess > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(excess) - 1);
+        mSnapshots.erase(mSnapshots.begin(), mSnapshots.begin() + excess);
+        endRemoveRows();
+    }
+    beginInsertRows(QModelIndex(), static_cast<int>(mSnapshots.size()), static_cast<int>(mSnapshots.size() + newCount) - 1);
+    std::move(snapshots.begin() + first, snapshots.end(), std::back_inserter(mSnapshots));
+    endInsertRows();
+}
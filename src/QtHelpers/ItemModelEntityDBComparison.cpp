@@ -0,0 +1,142 @@
+#include "QtHelpers/ItemModelEntityDBComparison.h"
+#include "Data/EntityDB.h"
+#include "Data/EntityDBComparison.h"
+#include "Data/EntityList.h"
+#include "Spelunky2.h"
+
+// the internal id of an index is 0 for top level rows, and group + 1 for the children of a group
+S2Plugin::ItemModelEntityDBComparison::ItemModelEntityDBComparison(EntityDB* entityDB, EntityDBComparison* comparison, bool grouped, QObject* parent)
+    : QAbstractItemModel(parent), mEntityDB(entityDB), mComparison(comparison), mGrouped(grouped)
+{
+}
+
+Qt::ItemFlags S2Plugin::ItemModelEntityDBComparison::flags(const QModelIndex& index) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+QVariant S2Plugin::ItemModelEntityDBComparison::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != gsRoleRawValue))
+    {
+        return QVariant();
+    }
+
+    if (mGrouped && index.internalId() == 0)
+    {
+        const auto& [raw, ids] = mComparison->groups().at(index.row());
+        if (role == gsRoleRawValue)
+        {
+            return mComparison->sortValue(raw);
+        }
+        return QString("%1 (%2)").arg(QString::fromStdString(mComparison->formatValue(raw))).arg(ids.size());
+    }
+
+    auto id = entityIDForIndex(index);
+    if (mGrouped)
+    {
+        auto name = QString::fromStdString(mEntityDB->entityList()->nameForID(id));
+        return role == gsRoleRawValue ? QVariant(name) : QVariant(QString("<font color='blue'><u>%1</u></font>").arg(name));
+    }
+
+    switch (index.column())
+    {
+        case gsColEntityDBComparisonID:
+            return role == gsRoleRawValue ? QVariant(id) : QVariant(QString::asprintf("%03d", id));
+        case gsColEntityDBComparisonName:
+        {
+            auto name = QString::fromStdString(mEntityDB->entityList()->nameForID(id));
+            return role == gsRoleRawValue ? QVariant(name) : QVariant(QString("<font color='blue'><u>%1</u></font>").arg(name));
+        }
+        case gsColEntityDBComparisonValue:
+        {
+            auto raw = mComparison->rawValueAt(index.row());
+            return role == gsRoleRawValue ? QVariant(mComparison->sortValue(raw)) : QVariant(QString::fromStdString(mComparison->formatValue(raw)));
+        }
+    }
+    return QVariant();
+}
+
+int S2Plugin::ItemModelEntityDBComparison::rowCount(const QModelIndex& parent) const
+{
+    if (!mGrouped)
+    {
+        return parent.isValid() ? 0 : static_cast<int>(mComparison->rowCount());
+    }
+    if (!parent.isValid())
+    {
+        return static_cast<int>(mComparison->groups().size());
+    }
+    if (parent.internalId() == 0 && parent.column() == 0)
+    {
+        return static_cast<int>(mComparison->groups().at(parent.row()).second.size());
+    }
+    return 0;
+}
+
+int S2Plugin::ItemModelEntityDBComparison::columnCount(const QModelIndex& parent) const
+{
+    return mGrouped ? 1 : 3;
+}
+
+QModelIndex S2Plugin::ItemModelEntityDBComparison::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+    {
+        return QModelIndex();
+    }
+    return createIndex(row, column, parent.isValid() ? static_cast<quintptr>(parent.row() + 1) : 0);
+}
+
+QModelIndex S2Plugin::ItemModelEntityDBComparison::parent(const QModelIndex& index) const
+{
+    if (!index.isValid() || index.internalId() == 0)
+    {
+        return QModelIndex();
+    }
+    return createIndex(static_cast<int>(index.internalId() - 1), 0, static_cast<quintptr>(0));
+}
+
+QVariant S2Plugin::ItemModelEntityDBComparison::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Orientation::Horizontal && role == Qt::DisplayRole)
+    {
+        if (mGrouped)
+        {
+            return "Value";
+        }
+        switch (section)
+        {
+            case gsColEntityDBComparisonID:
+                return "ID";
+            case gsColEntityDBComparisonName:
+                return "Name";
+            case gsColEntityDBComparisonValue:
+                return "Value";
+        }
+    }
+    return QVariant();
+}
+
+uint32_t S2Plugin::ItemModelEntityDBComparison::entityIDForIndex(const QModelIndex& index) const
+{
+    if (!index.isValid())
+    {
+        return 0;
+    }
+    if (!mGrouped)
+    {
+        return mComparison->idAt(index.row());
+    }
+    if (index.internalId() == 0)
+    {
+        return 0;
+    }
+    return mComparison->groups().at(index.internalId() - 1).second.at(index.row());
+}
+
+void S2Plugin::ItemModelEntityDBComparison::reset()
+{
+    beginResetModel();
+    endResetModel();
+}
@@ -0,0 +1,207 @@
+#include "QtHelpers/ItemModelEntityGrid.h"
+#include "Data/EntityGrid.h"
+#include "Spelunky2.h"
+#include <cstring>
+
+namespace
+{
+    QVariant decodeEntityGridValue(S2Plugin::MemoryFieldType type, uint64_t raw)
+    {
+        using S2Plugin::MemoryFieldType;
+        switch (type)
+        {
+            case MemoryFieldType::Byte:
+                return static_cast<int8_t>(raw);
+            case MemoryFieldType::Word:
+                return static_cast<int16_t>(raw);
+            case MemoryFieldType::Dword:
+                return static_cast<int32_t>(raw);
+            case MemoryFieldType::Qword:
+                return static_cast<qlonglong>(raw);
+            case MemoryFieldType::Float:
+            {
+                float f;
+                auto bits = static_cast<uint32_t>(raw);
+                std::memcpy(&f, &bits, sizeof(float));
+                return f;
+            }
+            case MemoryFieldType::Bool:
+                return raw != 0;
+            default:
+                return static_cast<qulonglong>(raw);
+        }
+    }
+} // namespace
+
+S2Plugin::ItemModelEntityGrid::ItemModelEntityGrid(EntityGrid* grid, QObject* parent) : QAbstractItemModel(parent), mEntityGrid(grid) {}
+
+Qt::ItemFlags S2Plugin::ItemModelEntityGrid::flags(const QModelIndex& index) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+QVariant S2Plugin::ItemModelEntityGrid::data(const QModelIndex& index, int role) const
+{
+    auto row = static_cast<size_t>(index.row());
+    if (row >= mEntityGrid->rowCount())
+    {
+        return QVariant();
+    }
+
+    if (role == Qt::DisplayRole || role == gsRoleRawValue)
+    {
+        switch (index.column())
+        {
+            case gsColEntityGridUID:
+                return mEntityGrid->uidAt(row);
+            case gsColEntityGridName:
+                return QString::fromStdString(mEntityGrid->nameAt(row));
+        }
+
+        const auto& column = mEntityGrid->columns().at(index.column() - gsColEntityGridFirstField);
+        auto raw = mEntityGrid->rawValue(row, index.column() - gsColEntityGridFirstField);
+        if (role == gsRoleRawValue)
+        {
+            return decodeEntityGridValue(column.type, raw);
+        }
+        switch (column.type)
+        {
+            case MemoryFieldType::Flags8:
+            case MemoryFieldType::Flags16:
+            case MemoryFieldType::Flags32:
+                return QString::asprintf("0x%0*llX", static_cast<int>(column.size * 2), raw);
+            case MemoryFieldType::CodePointer:
+            case MemoryFieldType::DataPointer:
+            case MemoryFieldType::EntityPointer:
+            case MemoryFieldType::EntityDBPointer:
+            case MemoryFieldType::TextureDBPointer:
+            case MemoryFieldType::ParticleDBPointer:
+                return QString::asprintf("0x%016llX", raw);
+            default:
+                return decodeEntityGridValue(column.type, raw);
+        }
+    }
+    else if (role == gsRoleMemoryOffset)
+    {
+        return QVariant::fromValue(mEntityGrid->entityAt(row));
+    }
+    return QVariant();
+}
+
+int S2Plugin::ItemModelEntityGrid::rowCount(const QModelIndex& parent) const
+{
+    return static_cast<int>(mEntityGrid->rowCount());
+}
+
+int S2Plugin::ItemModelEntityGrid::columnCount(const QModelIndex& parent) const
+{
+    return gsColEntityGridFirstField + static_cast<int>(mEntityGrid->columns().size());
+}
+
+QModelIndex S2Plugin::ItemModelEntityGrid::index(int row, int column, const QModelIndex& parent) const
+{
+    return createIndex(row, column);
+}
+
+QModelIndex S2Plugin::ItemModelEntityGrid::parent(const QModelIndex& index) const
+{
+    return QModelIndex();
+}
+
+QVariant S2Plugin::ItemModelEntityGrid::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Orientation::Horizontal && role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+            case gsColEntityGridUID:
+                return "UID";
+            case gsColEntityGridName:
+                return "Entity";
+        }
+        if (section - gsColEntityGridFirstField < mEntityGrid->columns().size())
+        {
+            return QString::fromStdString(mEntityGrid->columns().at(section - gsColEntityGridFirstField).name);
+        }
+    }
+    return QVariant();
+}
+
+void S2Plugin::ItemModelEntityGrid::refreshed(bool sameRows)
+{
+    if (sameRows && rowCount() > 0)
+    {
+        // same entities in the same order, only the values changed
+        emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    }
+    else
+    {
+        reset();
+    }
+}
+
+void S2Plugin::ItemModelEntityGrid::reset()
+{
+    beginResetModel();
+    endResetModel();
+}
+
+S2Plugin::SortFilterProxyModelEntityGrid::SortFilterProxyModelEntityGrid(QObject* parent) : QSortFilterProxyModel(parent)
+{
+    setSortRole(gsRoleRawValue);
+    setDynamicSortFilter(true);
+}
+
+bool S2Plugin::SortFilterProxyModelEntityGrid::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
+{
+    if (mFilterString.isEmpty() || mFilterColumn >= sourceModel()->columnCount())
+    {
+        return true;
+    }
+
+    auto index = sourceModel()->index(sourceRow, mFilterColumn, sourceParent);
+    if (mFilterIsNumeric && mFilterColumn != gsColEntityGridName)
+    {
+        auto value = sourceModel()->data(index, gsRoleRawValue).toDouble();
+        if (mFilterOperator == "<")
+            return value < mFilterValue;
+        if (mFilterOperator == "<=")
+            return value <= mFilterValue;
+        if (mFilterOperator == ">")
+            return value > mFilterValue;
+        if (mFilterOperator == ">=")
+            return value >= mFilterValue;
+        if (mFilterOperator == "!=")
+            return value != mFilterValue;
+        return value == mFilterValue;
+    }
+    return sourceModel()->data(index, Qt::DisplayRole).toString().contains(mFilterString, Qt::CaseInsensitive);
+}
+
+void S2Plugin::SortFilterProxyModelEntityGrid::setFilter(int column, const QString& f)
+{
+    mFilterColumn = column;
+    mFilterString = f.trimmed();
+    mFilterOperator.clear();
+    mFilterIsNumeric = false;
+
+    auto valueText = mFilterString;
+    for (const auto& op : {"<=", ">=", "==", "!=", "<", ">"})
+    {
+        if (valueText.startsWith(op))
+        {
+            mFilterOperator = op;
+            valueText = valueText.mid(mFilterOperator.length()).trimmed();
+            break;
+        }
+    }
+    if (valueText.startsWith("0x", Qt::CaseInsensitive))
+    {
+        mFilterValue = static_cast<double>(valueText.toULongLong(&mFilterIsNumeric, 16));
+    }
+    else
+    {
+        mFilterValue = valueText.toDouble(&mFilterIsNumeric);
+    }
+    invalidateFilter();
+}
@@ -0,0 +1,106 @@
+#include "QtHelpers/ItemModelEntityWatch.h"
+#include "Data/EntityWatch.h"
+#include <QVector>
+
+S2Plugin::ItemModelEntityWatch::ItemModelEntityWatch(EntityWatch* watch, QObject* parent) : QAbstractItemModel(parent), mEntityWatch(watch) {}
+
+Qt::ItemFlags S2Plugin::ItemModelEntityWatch::flags(const QModelIndex& index) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+QVariant S2Plugin::ItemModelEntityWatch::data(const QModelIndex& index, int role) const
+{
+    auto row = static_cast<size_t>(index.row());
+    if (row >= mEntityWatch->fieldCount() || role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    const auto& watched = mEntityWatch->fieldAt(row);
+    switch (index.column())
+    {
+        case gsColEntityWatchUID:
+            return watched.uid;
+        case gsColEntityWatchName:
+            if (!watched.alive)
+            {
+                return QString("(not found)");
+            }
+            if (!watched.classMatches)
+            {
+                return QString::fromStdString(mEntityWatch->entityNameAt(row)) + " (not of the field's class)";
+            }
+            return QString::fromStdString(mEntityWatch->entityNameAt(row));
+        case gsColEntityWatchField:
+            return QString::fromStdString(watched.field.name);
+        case gsColEntityWatchValue:
+            if (!watched.alive || !watched.classMatches || watched.history.empty())
+            {
+                return QVariant();
+            }
+            return watched.history.back();
+        case gsColEntityWatchHistory:
+        {
+            // the sparkline delegate paints this
+            QVector<double> history(watched.history.begin(), watched.history.end());
+            return QVariant::fromValue(history);
+        }
+    }
+    return QVariant();
+}
+
+int S2Plugin::ItemModelEntityWatch::rowCount(const QModelIndex& parent) const
+{
+    return static_cast<int>(mEntityWatch->fieldCount());
+}
+
+int S2Plugin::ItemModelEntityWatch::columnCount(const QModelIndex& parent) const
+{
+    return gsColEntityWatchHistory + 1;
+}
+
+QModelIndex S2Plugin::ItemModelEntityWatch::index(int row, int column, const QModelIndex& parent) const
+{
+    return createIndex(row, column);
+}
+
+QModelIndex S2Plugin::ItemModelEntityWatch::parent(const QModelIndex& index) const
+{
+    return QModelIndex();
+}
+
+QVariant S2Plugin::ItemModelEntityWatch::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Orientation::Horizontal && role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+            case gsColEntityWatchUID:
+                return "UID";
+            case gsColEntityWatchName:
+                return "Entity";
+            case gsColEntityWatchField:
+                return "Field";
+            case gsColEntityWatchValue:
+                return "Value";
+            case gsColEntityWatchHistory:
+                return "History";
+        }
+    }
+    return QVariant();
+}
+
+void S2Plugin::ItemModelEntityWatch::refreshed()
+{
+    if (rowCount() > 0)
+    {
+        emit dataChanged(index(0, gsColEntityWatchUID), index(rowCount() - 1, columnCount() - 1));
+    }
+}
+
+void S2Plugin::ItemModelEntityWatch::reset()
+{
+    beginResetModel();
+    endResetModel();
+}
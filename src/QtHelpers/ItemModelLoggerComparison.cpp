@@ -0,0 +1,120 @@
+#include "QtHelpers/ItemModelLoggerComparison.h"
+#include "Data/Logger.h"
+#include "Data/LoggerComparison.h"
+#include "Data/LoggerSession.h"
+#include <cmath>
+
+S2Plugin::ItemModelLoggerComparison::ItemModelLoggerComparison(Logger* logger, LoggerComparison* comparison, QObject* parent)
+    : QAbstractItemModel(parent), mLogger(logger), mComparison(comparison)
+{
+}
+
+Qt::ItemFlags S2Plugin::ItemModelLoggerComparison::flags(const QModelIndex& index) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+QVariant S2Plugin::ItemModelLoggerComparison::data(const QModelIndex& index, int role) const
+{
+    const auto& session = mLogger->sessionAt(index.row());
+    if (role == Qt::DisplayRole)
+    {
+        auto compared = static_cast<size_t>(index.row()) < mComparison->sessionCount();
+        switch (index.column())
+        {
+            case gsLogCompColSession:
+                return QString::fromStdString(session.name);
+            case gsLogCompColSamples:
+                return static_cast<qulonglong>(session.sampleCount());
+            case gsLogCompColAlignedAt:
+            {
+                if (!compared)
+                {
+                    return QVariant();
+                }
+                auto caption = QString("Frame %1").arg(mComparison->origin(index.row()));
+                return mComparison->triggerFound(index.row()) ? caption + " (trigger)" : caption;
+            }
+        }
+        if (!compared || !mComparison->hasField(index.row()))
+        {
+            return index.column() == gsLogCompColFrames && compared ? QString("Field not logged") : QVariant();
+        }
+        if (index.row() == 0)
+        {
+            return index.column() == gsLogCompColFrames ? QString("Reference") : QVariant();
+        }
+        const auto& metrics = mComparison->metrics(index.row());
+        switch (index.column())
+        {
+            case gsLogCompColFrames:
+                return static_cast<qulonglong>(metrics.frameCount);
+            case gsLogCompColMeanDifference:
+                return metrics.meanAbsoluteDifference;
+            case gsLogCompColMaxDifference:
+                return metrics.maxAbsoluteDifference;
+            case gsLogCompColRMSDifference:
+                return metrics.rmsDifference;
+            case gsLogCompColCorrelation:
+                return std::isnan(metrics.correlation) ? QVariant() : QVariant(metrics.correlation);
+        }
+    }
+    else if (role == Qt::ForegroundRole && index.column() == gsLogCompColSession)
+    {
+        return session.color;
+    }
+    return QVariant();
+}
+
+int S2Plugin::ItemModelLoggerComparison::rowCount(const QModelIndex& parent) const
+{
+    return mLogger->sessionCount();
+}
+
+int S2Plugin::ItemModelLoggerComparison::columnCount(const QModelIndex& parent) const
+{
+    return gsLogCompColCorrelation + 1;
+}
+
+QModelIndex S2Plugin::ItemModelLoggerComparison::index(int row, int column, const QModelIndex& parent) const
+{
+    return createIndex(row, column);
+}
+
+QModelIndex S2Plugin::ItemModelLoggerComparison::parent(const QModelIndex& index) const
+{
+    return QModelIndex();
+}
+
+QVariant S2Plugin::ItemModelLoggerComparison::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Orientation::Horizontal && role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+            case gsLogCompColSession:
+                return "Session";
+            case gsLogCompColSamples:
+                return "Samples";
+            case gsLogCompColAlignedAt:
+                return "Aligned at";
+            case gsLogCompColFrames:
+                return "Frames compared";
+            case gsLogCompColMeanDifference:
+                return "Mean abs. difference";
+            case gsLogCompColMaxDifference:
+                return "Max abs. difference";
+            case gsLogCompColRMSDifference:
+                return "RMS difference";
+            case gsLogCompColCorrelation:
+                return "Correlation";
+        }
+    }
+    return QVariant();
+}
+
+void S2Plugin::ItemModelLoggerComparison::reset()
+{
+    beginResetModel();
+    endResetModel();
+}
@@ -23,7 +23,19 @@ QVariant S2Plugin::ItemModelLoggerFields::data(const QModelIndex& index, int rol
             }
             case gsLogFieldColMemoryOffset:
             {
-                return QString::asprintf("0x%016llX", field.memoryOffset);
+                if (field.kind == LoggerFieldKind::Expression)
+                {
+                    return QString::fromStdString("= " + field.expression);
+                }
+                auto offset = QString::asprintf("0x%016llX", field.memoryOffset);
+                if (field.kind == LoggerFieldKind::PointerPath || field.kind == LoggerFieldKind::UIDPath)
+                {
+                    for (auto pathOffset : field.pathOffsets)
+                    {
+                        offset += QString::asprintf(" -> +0x%llX", pathOffset);
+                    }
+                }
+                return offset;
             }
             case gsLogFieldColFieldName:
             {
@@ -31,7 +43,20 @@ QVariant S2Plugin::ItemModelLoggerFields::data(const QModelIndex& index, int rol
             }
             case gsLogFieldColFieldType:
             {
-                return QString::fromStdString(gsMemoryFieldTypeToStringMapping.at(field.type));
+                auto type = QString::fromStdString(gsMemoryFieldTypeToStringMapping.at(field.type));
+                switch (field.kind)
+                {
+                    case LoggerFieldKind::FlagBit:
+                        return QString("Bit %1 of %2").arg(field.bit).arg(type);
+                    case LoggerFieldKind::PointerPath:
+                        return type + " (via pointer)";
+                    case LoggerFieldKind::UIDPath:
+                        return type + " (via entity UID)";
+                    case LoggerFieldKind::Expression:
+                        return QString("Float (expression)");
+                    default:
+                        return type;
+                }
             }
         }
     }
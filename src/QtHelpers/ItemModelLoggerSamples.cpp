@@ -2,6 +2,7 @@
 #include "Data/Logger.h"
 #include "QtHelpers/TableViewLogger.h"
 #include "Spelunky2.h"
+#include <algorithm>
 
 S2Plugin::ItemModelLoggerSamples::ItemModelLoggerSamples(Logger* logger, QObject* parent) : QAbstractItemModel(parent), mLogger(logger) {}
 
@@ -14,66 +15,24 @@ QVariant S2Plugin::ItemModelLoggerSamples::data(const QModelIndex& index, int ro
 {
     if (role == Qt::DisplayRole)
     {
-        if (index.column() == 0)
+        // the view pages in the rows it's about to paint, pageInRows(); rows too far apart for that are read one
+        // at a time from the chunks of the recording
+        auto sample = sampleForRow(index.row());
+        if (index.column() == gsLogSampleColIndex)
         {
-            return index.row();
+            return static_cast<qulonglong>(sample);
+        }
+        else if (index.column() == gsLogSampleColFrame)
+        {
+            return mLogger->readSampleFrame(sample);
+        }
+        else if (index.column() == gsLogSampleColTime)
+        {
+            return QString::number(mLogger->readSampleTime(sample) / 1000., 'f', 3);
         }
         else
         {
-            const auto& field = mLogger->fieldAt(index.column() - 1);
-            const auto& samples = mLogger->samplesForField(field.uuid);
-            switch (field.type)
-            {
-                case MemoryFieldType::Byte:
-                {
-                    return std::any_cast<int8_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::UnsignedByte:
-                case MemoryFieldType::Bool:
-                case MemoryFieldType::Flags8:
-                case MemoryFieldType::State8:
-                case MemoryFieldType::CharacterDBID:
-                {
-                    return std::any_cast<uint8_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::Word:
-                {
-                    return std::any_cast<int16_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::UnsignedWord:
-                case MemoryFieldType::Flags16:
-                case MemoryFieldType::State16:
-                {
-                    return std::any_cast<uint16_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::Dword:
-                {
-                    return std::any_cast<int32_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::UnsignedDword:
-                case MemoryFieldType::Flags32:
-                case MemoryFieldType::State32:
-                case MemoryFieldType::EntityDBID:
-                case MemoryFieldType::EntityUID:
-                case MemoryFieldType::ParticleDBID:
-                case MemoryFieldType::TextureDBID:
-                case MemoryFieldType::StringsTableID:
-                {
-                    return std::any_cast<uint32_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::Float:
-                {
-                    return std::any_cast<float>(samples.at(index.row()));
-                }
-                case MemoryFieldType::Qword:
-                {
-                    return std::any_cast<int64_t>(samples.at(index.row()));
-                }
-                case MemoryFieldType::UnsignedQword:
-                {
-                    return std::any_cast<uint64_t>(samples.at(index.row()));
-                }
-            }
+            return mLogger->readSampleValue(index.column() - gsLogSampleColFirstField, sample);
         }
     }
     return QVariant();
@@ -81,12 +40,12 @@ QVariant S2Plugin::ItemModelLoggerSamples::data(const QModelIndex& index, int ro
 
 int S2Plugin::ItemModelLoggerSamples::rowCount(const QModelIndex& parent) const
 {
-    return mLogger->sampleCount();
+    return static_cast<int>(mRowCount);
 }
 
 int S2Plugin::ItemModelLoggerSamples::columnCount(const QModelIndex& parent) const
 {
-    return mLogger->fieldCount() + 1;
+    return mLogger->fieldCount() + gsLogSampleColFirstField;
 }
 
 QModelIndex S2Plugin::ItemModelLoggerSamples::index(int row, int column, const QModelIndex& parent) const
@@ -105,10 +64,14 @@ QVariant S2Plugin::ItemModelLoggerSamples::headerData(int section, Qt::Orientati
     {
         switch (section)
         {
-            case 0:
+            case gsLogSampleColIndex:
                 return "Sample";
+            case gsLogSampleColFrame:
+                return "Frame";
+            case gsLogSampleColTime:
+                return "Time (ms)";
             default:
-                return QString::fromStdString(mLogger->fieldAt(section - 1).name);
+                return QString::fromStdString(mLogger->fieldAt(section - gsLogSampleColFirstField).name);
         }
     }
     return QVariant();
@@ -117,5 +80,125 @@ QVariant S2Plugin::ItemModelLoggerSamples::headerData(int section, Qt::Orientati
 void S2Plugin::ItemModelLoggerSamples::reset()
 {
     beginResetModel();
+    mRowCount = 0;
+    mScanned = 0;
+    mChangedSamples.clear();
     endResetModel();
 }
+
+void S2Plugin::ItemModelLoggerSamples::setDecimation(LoggerSamplesDecimation decimation, size_t stride)
+{
+    mDecimation = decimation;
+    mStride = (std::max)(stride, size_t(1));
+    reset();
+}
+
+bool S2Plugin::ItemModelLoggerSamples::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && mScanned < mLogger->sampleCount();
+}
+
+void S2Plugin::ItemModelLoggerSamples::fetchMore(const QModelIndex& parent)
+{
+    auto sampleCount = mLogger->sampleCount();
+    size_t scanned = mScanned;
+    size_t rows = 0;
+    std::vector<size_t> changed;
+    switch (mDecimation)
+    {
+        case LoggerSamplesDecimation::All:
+            scanned = (std::min)(sampleCount, mScanned + msFetchSize);
+            rows = scanned - mScanned;
+            break;
+        case LoggerSamplesDecimation::EveryNth:
+            scanned = (std::min)(sampleCount, mScanned + (msFetchSize * mStride));
+            rows = ((scanned + mStride - 1) / mStride) - ((mScanned + mStride - 1) / mStride);
+            break;
+        case LoggerSamplesDecimation::Changes:
+        {
+            auto limit = (std::min)(sampleCount, mScanned + msMaxFetchScan);
+            while (scanned < limit && changed.size() < msFetchSize)
+            {
+                auto to = (std::min)(limit, scanned + msScanSize);
+                scanChanges(scanned, to, changed);
+                scanned = to;
+            }
+            rows = changed.size();
+            break;
+        }
+    }
+    if (rows == 0)
+    {
+        mScanned = scanned;
+        return;
+    }
+    beginInsertRows(QModelIndex(), static_cast<int>(mRowCount), static_cast<int>(mRowCount + rows - 1));
+    mRowCount += rows;
+    mScanned = scanned;
+    mChangedSamples.insert(mChangedSamples.end(), changed.begin(), changed.end());
+    endInsertRows();
+}
+
+void S2Plugin::ItemModelLoggerSamples::pageInRows(size_t firstRow, size_t lastRow)
+{
+    if (firstRow > lastRow || lastRow >= mRowCount)
+    {
+        return;
+    }
+    // the rows around these come along, so scrolling reads a recording a few chunks at a time
+    mLogger->pageIn(sampleForRow(firstRow), sampleForRow(lastRow) + 1);
+}
+
+size_t S2Plugin::ItemModelLoggerSamples::sampleForRow(size_t row) const
+{
+    switch (mDecimation)
+    {
+        case LoggerSamplesDecimation::EveryNth:
+            return row * mStride;
+        case LoggerSamplesDecimation::Changes:
+            return mChangedSamples[row];
+        default:
+            return row;
+    }
+}
+
+void S2Plugin::ItemModelLoggerSamples::scanChanges(size_t first, size_t last, std::vector<size_t>& changed)
+{
+    // compared column by column on the typed values, the first sample always counts as a change
+    std::vector<uint8_t> differs(last - first, 0);
+    if (first == 0)
+    {
+        differs[0] = 1;
+    }
+    auto from = (std::max)(first, size_t(1));
+    mLogger->pageIn(from - 1, last);
+    for (size_t x = 0; x < mLogger->fieldCount() && from < last; ++x)
+    {
+        const auto& column = mLogger->samplesForField(x);
+        if (!column.isResident(from - 1, last))
+        {
+            // couldn't be read back, better to show too much
+            std::fill(differs.begin(), differs.end(), 1);
+            break;
+        }
+        column.visit(
+            [&](const auto& values)
+            {
+                auto residentFirst = column.residentFirst();
+                for (auto sample = from; sample < last; ++sample)
+                {
+                    if (values[sample - residentFirst] != values[sample - residentFirst - 1])
+                    {
+                        differs[sample - first] = 1;
+                    }
+                }
+            });
+    }
+    for (size_t x = 0; x < differs.size(); ++x)
+    {
+        if (differs[x] != 0)
+        {
+            changed.emplace_back(first + x);
+        }
+    }
+}
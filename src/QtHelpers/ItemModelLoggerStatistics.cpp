@@ -0,0 +1,92 @@
+#include "QtHelpers/ItemModelLoggerStatistics.h"
+#include "Data/Logger.h"
+#include <cmath>
+
+S2Plugin::ItemModelLoggerStatistics::ItemModelLoggerStatistics(Logger* logger, QObject* parent) : QAbstractItemModel(parent), mLogger(logger) {}
+
+Qt::ItemFlags S2Plugin::ItemModelLoggerStatistics::flags(const QModelIndex& index) const
+{
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+}
+
+QVariant S2Plugin::ItemModelLoggerStatistics::data(const QModelIndex& index, int role) const
+{
+    if (role == Qt::DisplayRole)
+    {
+        const auto& field = mLogger->fieldAt(index.row());
+        const auto& statistics = mLogger->samplesForField(index.row()).statistics();
+        if (index.column() != gsLogStatColField && index.column() != gsLogStatColCount && statistics.count == 0)
+        {
+            return QVariant();
+        }
+        switch (index.column())
+        {
+            case gsLogStatColField:
+                return QString::fromStdString(field.name);
+            case gsLogStatColCount:
+                return static_cast<qulonglong>(statistics.count);
+            case gsLogStatColMin:
+                return statistics.min;
+            case gsLogStatColMax:
+                return statistics.max;
+            case gsLogStatColMean:
+                return statistics.mean;
+            case gsLogStatColStdDev:
+                return std::sqrt(statistics.variance());
+        }
+    }
+    else if (role == Qt::ForegroundRole && index.column() == gsLogStatColField)
+    {
+        return mLogger->fieldAt(index.row()).color;
+    }
+    return QVariant();
+}
+
+int S2Plugin::ItemModelLoggerStatistics::rowCount(const QModelIndex& parent) const
+{
+    return mLogger->fieldCount();
+}
+
+int S2Plugin::ItemModelLoggerStatistics::columnCount(const QModelIndex& parent) const
+{
+    return gsLogStatColStdDev + 1;
+}
+
+QModelIndex S2Plugin::ItemModelLoggerStatistics::index(int row, int column, const QModelIndex& parent) const
+{
+    return createIndex(row, column);
+}
+
+QModelIndex S2Plugin::ItemModelLoggerStatistics::parent(const QModelIndex& index) const
+{
+    return QModelIndex();
+}
+
+QVariant S2Plugin::ItemModelLoggerStatistics::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Orientation::Horizontal && role == Qt::DisplayRole)
+    {
+        switch (section)
+        {
+            case gsLogStatColField:
+                return "Field";
+            case gsLogStatColCount:
+                return "Samples";
+            case gsLogStatColMin:
+                return "Minimum";
+            case gsLogStatColMax:
+                return "Maximum";
+            case gsLogStatColMean:
+                return "Mean";
+            case gsLogStatColStdDev:
+                return "Standard deviation";
+        }
+    }
+    return QVariant();
+}
+
+void S2Plugin::ItemModelLoggerStatistics::reset()
+{
+    beginResetModel();
+    endResetModel();
+}
@@ -100,10 +100,8 @@ void S2Plugin::ItemModelVirtualTable::detectEntities(ViewToolbar* toolbar)
         {
             auto entityPtr = layerEntities + (x * sizeof(size_t));
             auto entity = Script::Memory::ReadQword(entityPtr);
-            auto entityVTableOffset = Script::Memory::ReadQword(entity);
-
-            auto entityUid = Script::Memory::ReadDword(entity + 56);
-            auto entityName = spel2->getEntityName(entity, entityDB);
+            auto entityVTableOffset = state->entityHeader(entity, entityDB).vtable;
+            auto entityName = spel2->getEntityName(entity, entityDB, state);
             vtl->setSymbolNameForOffsetAddress(entityVTableOffset, entityName);
         }
     };
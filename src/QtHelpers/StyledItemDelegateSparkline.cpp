@@ -0,0 +1,39 @@
+#include "QtHelpers/StyledItemDelegateSparkline.h"
+#include <QApplication>
+#include <QPainter>
+#include <QPolygonF>
+#include <QVector>
+#include <algorithm>
+
+void S2Plugin::StyledItemDelegateSparkline::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QStyleOptionViewItemV4 options = option;
+    initStyleOption(&options, index);
+    options.text.clear();
+    auto style = options.widget != nullptr ? options.widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &options, painter, options.widget); // background and selection
+
+    auto values = index.data(Qt::DisplayRole).value<QVector<double>>();
+    if (values.size() < 2)
+    {
+        return;
+    }
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing, true);
+
+    auto adjusted = QRectF(options.rect.adjusted(3, 3, -3, -3));
+    auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+    auto range = *maxIt - *minIt;
+    QPolygonF line;
+    line.reserve(values.size());
+    for (auto x = 0; x < values.size(); ++x)
+    {
+        auto relative = range == 0 ? 0.5 : (values.at(x) - *minIt) / range;
+        line << QPointF(adjusted.left() + (adjusted.width() * x / (values.size() - 1)), adjusted.bottom() - (adjusted.height() * relative));
+    }
+    painter->setPen(QPen(QColor(0, 120, 215), 1.0));
+    painter->drawPolyline(line);
+
+    painter->restore();
+}
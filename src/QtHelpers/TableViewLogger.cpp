@@ -1,5 +1,6 @@
 #include "QtHelpers/TableViewLogger.h"
 #include "Data/Logger.h"
+#include "Data/LoggerExpression.h"
 #include "QtHelpers/ItemModelLoggerFields.h"
 #include "QtHelpers/StyledItemDelegateColorPicker.h"
 #include "Spelunky2.h"
@@ -8,6 +9,8 @@
 #include <QFont>
 #include <QFontMetrics>
 #include <QHeaderView>
+#include <QInputDialog>
+#include <QMenu>
 #include <QMessageBox>
 #include <QMimeData>
 #include <QPainter>
@@ -15,6 +18,32 @@
 #include <QUuid>
 #include <nlohmann/json.hpp>
 
+namespace
+{
+    constexpr uint8_t gsDefaultColorCount = 6;
+    const std::array<QColor, gsDefaultColorCount> gsDefaultColors = {
+        QColor(255, 102, 99), QColor(254, 177, 68), QColor(253, 253, 151), QColor(158, 224, 158), QColor(158, 193, 207), QColor(204, 153, 201),
+    };
+    const std::unordered_set<S2Plugin::MemoryFieldType> gsAllowedMemoryFieldTypes = {
+        S2Plugin::MemoryFieldType::Byte,           S2Plugin::MemoryFieldType::UnsignedByte,   S2Plugin::MemoryFieldType::Bool,           S2Plugin::MemoryFieldType::Flags8,
+        S2Plugin::MemoryFieldType::State8,         S2Plugin::MemoryFieldType::CharacterDBID,  S2Plugin::MemoryFieldType::Word,           S2Plugin::MemoryFieldType::UnsignedWord,
+        S2Plugin::MemoryFieldType::Flags16,        S2Plugin::MemoryFieldType::State16,        S2Plugin::MemoryFieldType::Dword,          S2Plugin::MemoryFieldType::UnsignedDword,
+        S2Plugin::MemoryFieldType::Float,          S2Plugin::MemoryFieldType::Flags32,        S2Plugin::MemoryFieldType::State32,        S2Plugin::MemoryFieldType::EntityDBID,
+        S2Plugin::MemoryFieldType::EntityUID,      S2Plugin::MemoryFieldType::ParticleDBID,   S2Plugin::MemoryFieldType::TextureDBID,    S2Plugin::MemoryFieldType::StringsTableID,
+        S2Plugin::MemoryFieldType::Qword,          S2Plugin::MemoryFieldType::UnsignedQword,
+    };
+
+    void showWarning(const QString& text)
+    {
+        QMessageBox msgBox;
+        msgBox.setIcon(QMessageBox::Warning);
+        msgBox.setWindowIcon(QIcon(":/icons/caveman.png"));
+        msgBox.setText(text);
+        msgBox.setWindowTitle("Spelunky2");
+        msgBox.exec();
+    }
+} // namespace
+
 S2Plugin::TableViewLogger::TableViewLogger(Logger* logger, QWidget* parent) : QTableView(parent), mLogger(logger)
 {
     setAlternatingRowColors(true);
@@ -47,19 +76,6 @@ void S2Plugin::TableViewLogger::dragMoveEvent(QDragMoveEvent* event)
 
 void S2Plugin::TableViewLogger::dropEvent(QDropEvent* event)
 {
-    static constexpr uint8_t defaultColorCount = 6;
-    static const std::array<QColor, defaultColorCount> defaultColors = {
-        QColor(255, 102, 99), QColor(254, 177, 68), QColor(253, 253, 151), QColor(158, 224, 158), QColor(158, 193, 207), QColor(204, 153, 201),
-    };
-    static const std::unordered_set<MemoryFieldType> allowedMemoryFieldTypes = {
-        MemoryFieldType::Byte,        MemoryFieldType::UnsignedByte,   MemoryFieldType::Bool,    MemoryFieldType::Flags8,        MemoryFieldType::State8,    MemoryFieldType::CharacterDBID,
-        MemoryFieldType::Word,        MemoryFieldType::UnsignedWord,   MemoryFieldType::Flags16, MemoryFieldType::State16,       MemoryFieldType::Dword,     MemoryFieldType::UnsignedDword,
-        MemoryFieldType::Float,       MemoryFieldType::Flags32,        MemoryFieldType::State32, MemoryFieldType::EntityDBID,    MemoryFieldType::EntityUID, MemoryFieldType::ParticleDBID,
-        MemoryFieldType::TextureDBID, MemoryFieldType::StringsTableID, MemoryFieldType::Qword,   MemoryFieldType::UnsignedQword,
-    };
-
-    auto fieldsModel = qobject_cast<ItemModelLoggerFields*>(model());
-
     auto data = event->mimeData()->data("spelunky/memoryfield");
     auto codec = QTextCodec::codecForName("UTF-8");
     auto str = codec->toUnicode(data);
@@ -68,7 +84,7 @@ void S2Plugin::TableViewLogger::dropEvent(QDropEvent* event)
 
     LoggerField field;
     field.type = static_cast<MemoryFieldType>(j[gsJSONDragDropMemoryField_Type].get<uint64_t>());
-    if (allowedMemoryFieldTypes.count(field.type) == 0)
+    if (gsAllowedMemoryFieldTypes.count(field.type) == 0)
     {
         QMessageBox msgBox;
         msgBox.setIcon(QMessageBox::Critical);
@@ -78,12 +94,15 @@ void S2Plugin::TableViewLogger::dropEvent(QDropEvent* event)
         msgBox.exec();
         return;
     }
-    field.uuid = QUuid::createUuid().toString().toStdString();
     field.memoryOffset = j[gsJSONDragDropMemoryField_Offset].get<uint64_t>();
     field.name = j[gsJSONDragDropMemoryField_UID].get<std::string>();
-    field.color = defaultColors[fieldsModel->rowCount() % defaultColorCount];
+    if (j.contains(gsJSONDragDropMemoryField_Flag))
+    {
+        field.kind = LoggerFieldKind::FlagBit;
+        field.bit = static_cast<uint8_t>(j[gsJSONDragDropMemoryField_Flag].get<uint32_t>() - 1);
+    }
 
-    mLogger->addField(field);
+    addField(field);
 
     event->acceptProposedAction();
 }
@@ -135,3 +154,162 @@ void S2Plugin::TableViewLogger::paintEvent(QPaintEvent* event)
         painter.restore();
     }
 }
+
+void S2Plugin::TableViewLogger::contextMenuEvent(QContextMenuEvent* event)
+{
+    auto index = indexAt(event->pos());
+    QMenu menu(this);
+    if (index.isValid())
+    {
+        size_t fieldIndex = index.row();
+        const auto& field = mLogger->fieldAt(fieldIndex);
+        if (field.kind == LoggerFieldKind::Value)
+        {
+            switch (field.type)
+            {
+                case MemoryFieldType::Float:
+                case MemoryFieldType::Bool:
+                    break;
+                case MemoryFieldType::Qword:
+                case MemoryFieldType::UnsignedQword:
+                    QObject::connect(menu.addAction("Follow pointer..."), &QAction::triggered, [this, fieldIndex]() { addPathField(fieldIndex); });
+                    [[fallthrough]];
+                default:
+                    QObject::connect(menu.addAction("Track a bit..."), &QAction::triggered, [this, fieldIndex]() { addBitField(fieldIndex); });
+                    break;
+            }
+            if (field.type == MemoryFieldType::EntityUID)
+            {
+                QObject::connect(menu.addAction("Follow entity UID..."), &QAction::triggered, [this, fieldIndex]() { addPathField(fieldIndex); });
+            }
+        }
+    }
+    if (mLogger->fieldCount() > 0)
+    {
+        QObject::connect(menu.addAction("Add expression..."), &QAction::triggered, [this]() { addExpressionField(); });
+    }
+    if (!menu.isEmpty())
+    {
+        menu.exec(event->globalPos());
+    }
+}
+
+void S2Plugin::TableViewLogger::addBitField(size_t fieldIndex)
+{
+    auto field = mLogger->fieldAt(fieldIndex);
+    auto bitCount = static_cast<int>(LoggerSampleColumn(field.type).valueSize() * 8);
+    bool ok = false;
+    auto bit = QInputDialog::getInt(this, "Spelunky2", QString("Bit of %1 to track (0 - %2)").arg(QString::fromStdString(field.name)).arg(bitCount - 1), 0, 0, bitCount - 1, 1, &ok);
+    if (!ok)
+    {
+        return;
+    }
+    field.kind = LoggerFieldKind::FlagBit;
+    field.bit = static_cast<uint8_t>(bit);
+    field.name += ".bit" + std::to_string(bit);
+    addField(field);
+}
+
+void S2Plugin::TableViewLogger::addPathField(size_t fieldIndex)
+{
+    auto field = mLogger->fieldAt(fieldIndex);
+    auto viaUID = field.type == MemoryFieldType::EntityUID;
+    bool ok = false;
+    auto text = QInputDialog::getText(this, "Spelunky2",
+                                      viaUID ? "Offsets into the entity, e.g. 0x40 for its x position, or 0x108, 0x40 to go through a pointer on the way"
+                                             : "Offsets to follow from the pointer, e.g. 0x130 or 0x108, 0x40 to go through another pointer",
+                                      QLineEdit::Normal, QString(), &ok);
+    if (!ok)
+    {
+        return;
+    }
+    std::vector<size_t> pathOffsets;
+    for (const auto& part : text.split(',', QString::SkipEmptyParts))
+    {
+        auto offset = part.trimmed().toULongLong(&ok, 0);
+        if (!ok)
+        {
+            showWarning("'" + part + "' is not an offset");
+            return;
+        }
+        pathOffsets.emplace_back(offset);
+    }
+    if (pathOffsets.empty())
+    {
+        showWarning("At least one offset is needed");
+        return;
+    }
+
+    QStringList typeNames;
+    for (const auto& [type, typeName] : gsMemoryFieldTypeToStringMapping)
+    {
+        if (gsAllowedMemoryFieldTypes.count(type) != 0)
+        {
+            typeNames << QString::fromStdString(typeName);
+        }
+    }
+    typeNames.sort();
+    auto typeName = QInputDialog::getItem(this, "Spelunky2", "Type of the value at the end", typeNames, typeNames.indexOf("Float"), false, &ok).toStdString();
+    if (!ok)
+    {
+        return;
+    }
+    for (const auto& [type, name] : gsMemoryFieldTypeToStringMapping)
+    {
+        if (name == typeName)
+        {
+            field.type = type;
+        }
+    }
+
+    field.kind = viaUID ? LoggerFieldKind::UIDPath : LoggerFieldKind::PointerPath;
+    field.pathOffsets = pathOffsets;
+    for (auto offset : pathOffsets)
+    {
+        field.name += "->" + QString::asprintf("0x%llX", offset).toStdString();
+    }
+    addField(field);
+}
+
+void S2Plugin::TableViewLogger::addExpressionField()
+{
+    std::vector<std::string> fieldNames;
+    for (size_t x = 0; x < mLogger->fieldCount(); ++x)
+    {
+        const auto& field = mLogger->fieldAt(x);
+        fieldNames.emplace_back(field.kind == LoggerFieldKind::Expression ? std::string() : field.name);
+    }
+    bool ok = false;
+    auto text = QInputDialog::getText(this, "Spelunky2", "Expression over the logged fields, with their names in braces, e.g. hypot({a}, {b})", QLineEdit::Normal, QString(), &ok)
+                    .toStdString();
+    if (!ok || text.empty())
+    {
+        return;
+    }
+    LoggerExpression expression;
+    if (!expression.compile(text, fieldNames))
+    {
+        showWarning(QString::fromStdString(expression.error()));
+        return;
+    }
+    auto name = QInputDialog::getText(this, "Spelunky2", "Name of the expression", QLineEdit::Normal, QString::fromStdString(text), &ok).toStdString();
+    if (!ok)
+    {
+        return;
+    }
+
+    LoggerField field;
+    field.kind = LoggerFieldKind::Expression;
+    field.type = MemoryFieldType::Float;
+    field.memoryOffset = 0;
+    field.expression = text;
+    field.name = name.empty() ? text : name;
+    addField(field);
+}
+
+void S2Plugin::TableViewLogger::addField(LoggerField& field)
+{
+    field.uuid = QUuid::createUuid().toString().toStdString();
+    field.color = gsDefaultColors[model()->rowCount() % gsDefaultColorCount];
+    mLogger->addField(field);
+}
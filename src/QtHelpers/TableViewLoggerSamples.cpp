@@ -0,0 +1,26 @@
+#include "QtHelpers/TableViewLoggerSamples.h"
+#include "QtHelpers/ItemModelLoggerSamples.h"
+#include <QHeaderView>
+
+S2Plugin::TableViewLoggerSamples::TableViewLoggerSamples(QWidget* parent) : QTableView(parent)
+{
+    // fixed row heights, so the view never has to measure rows of a long recording
+    verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    verticalHeader()->setVisible(false);
+}
+
+void S2Plugin::TableViewLoggerSamples::paintEvent(QPaintEvent* event)
+{
+    auto samplesModel = qobject_cast<ItemModelLoggerSamples*>(model());
+    auto firstRow = rowAt(0);
+    if (samplesModel != nullptr && firstRow >= 0)
+    {
+        auto lastRow = rowAt(viewport()->height() - 1);
+        if (lastRow < 0)
+        {
+            lastRow = samplesModel->rowCount() - 1;
+        }
+        samplesModel->pageInRows(static_cast<size_t>(firstRow), static_cast<size_t>(lastRow));
+    }
+    QTableView::paintEvent(event);
+}
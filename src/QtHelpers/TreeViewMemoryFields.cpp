@@ -55,82 +55,87 @@ void S2Plugin::TreeViewMemoryFields::setMemoryMappedData(MemoryMappedData* mmd)
     mMemoryMappedData = mmd;
 }
 
-QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField& field, const std::string& fieldNameOverride, QStandardItem* parent)
+QList<QStandardItem*> S2Plugin::TreeViewMemoryFields::createRowItems(const MemoryField& field, const std::string& fieldNameUID)
 {
-    auto createAndInsertItem = [](const MemoryField& field, const std::string& fieldNameUID, QStandardItem* itemParent) -> QStandardItem*
+    auto itemFieldName = new QStandardItem();
+    itemFieldName->setData(QString::fromStdString(field.name), Qt::DisplayRole);
+    itemFieldName->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldName->setData(QVariant::fromValue(field), gsRoleEntireMemoryField);
+    itemFieldName->setEditable(false);
+
+    auto itemFieldValue = new QStandardItem();
+    itemFieldValue->setData("", Qt::DisplayRole);
+    itemFieldValue->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldValue->setData(QVariant::fromValue(field.type), gsRoleType); // in case we click on, we can see the type
+    itemFieldValue->setData(QVariant::fromValue(field), gsRoleEntireMemoryField);
+    itemFieldValue->setEditable(false);
+
+    auto itemFieldValueHex = new QStandardItem();
+    itemFieldValueHex->setData("", Qt::DisplayRole);
+    itemFieldValueHex->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldValueHex->setData(QVariant::fromValue(field.type), gsRoleType); // in case we click on, we can see the type
+    itemFieldValueHex->setData(QVariant::fromValue(field), gsRoleEntireMemoryField);
+    itemFieldValueHex->setEditable(false);
+
+    auto itemFieldComparisonValue = new QStandardItem();
+    itemFieldComparisonValue->setData("", Qt::DisplayRole);
+    itemFieldComparisonValue->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldComparisonValue->setEditable(false);
+
+    auto itemFieldComparisonValueHex = new QStandardItem();
+    itemFieldComparisonValueHex->setData("", Qt::DisplayRole);
+    itemFieldComparisonValueHex->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldComparisonValueHex->setEditable(false);
+
+    auto itemFieldMemoryOffset = new QStandardItem();
+    itemFieldMemoryOffset->setData("", Qt::DisplayRole);
+    itemFieldMemoryOffset->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldMemoryOffset->setEditable(false);
+
+    auto itemFieldMemoryOffsetDelta = new QStandardItem();
+    itemFieldMemoryOffsetDelta->setData("", Qt::DisplayRole);
+    itemFieldMemoryOffsetDelta->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldMemoryOffsetDelta->setEditable(false);
+
+    auto itemFieldComment = new QStandardItem();
+    itemFieldComment->setData(QString::fromStdString(field.comment).toHtmlEscaped(), Qt::DisplayRole);
+    itemFieldComment->setEditable(false);
+
+    auto itemFieldType = new QStandardItem();
+    if (field.type == MemoryFieldType::EntitySubclass)
     {
-        auto itemFieldName = new QStandardItem();
-        itemFieldName->setData(QString::fromStdString(field.name), Qt::DisplayRole);
-        itemFieldName->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldName->setData(QVariant::fromValue(field), gsRoleEntireMemoryField);
-        itemFieldName->setEditable(false);
-
-        auto itemFieldValue = new QStandardItem();
-        itemFieldValue->setData("", Qt::DisplayRole);
-        itemFieldValue->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldValue->setData(QVariant::fromValue(field.type), gsRoleType); // in case we click on, we can see the type
-        itemFieldValue->setData(QVariant::fromValue(field), gsRoleEntireMemoryField);
-        itemFieldValue->setEditable(false);
-
-        auto itemFieldValueHex = new QStandardItem();
-        itemFieldValueHex->setData("", Qt::DisplayRole);
-        itemFieldValueHex->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldValueHex->setData(QVariant::fromValue(field.type), gsRoleType); // in case we click on, we can see the type
-        itemFieldValueHex->setData(QVariant::fromValue(field), gsRoleEntireMemoryField);
-        itemFieldValueHex->setEditable(false);
-
-        auto itemFieldComparisonValue = new QStandardItem();
-        itemFieldComparisonValue->setData("", Qt::DisplayRole);
-        itemFieldComparisonValue->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldComparisonValue->setEditable(false);
-
-        auto itemFieldComparisonValueHex = new QStandardItem();
-        itemFieldComparisonValueHex->setData("", Qt::DisplayRole);
-        itemFieldComparisonValueHex->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldComparisonValueHex->setEditable(false);
-
-        auto itemFieldMemoryOffset = new QStandardItem();
-        itemFieldMemoryOffset->setData("", Qt::DisplayRole);
-        itemFieldMemoryOffset->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldMemoryOffset->setEditable(false);
-
-        auto itemFieldMemoryOffsetDelta = new QStandardItem();
-        itemFieldMemoryOffsetDelta->setData("", Qt::DisplayRole);
-        itemFieldMemoryOffsetDelta->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldMemoryOffsetDelta->setEditable(false);
-
-        auto itemFieldComment = new QStandardItem();
-        itemFieldComment->setData(QString::fromStdString(field.comment).toHtmlEscaped(), Qt::DisplayRole);
-        itemFieldComment->setEditable(false);
-
-        auto itemFieldType = new QStandardItem();
-        if (field.type == MemoryFieldType::EntitySubclass)
-        {
-            itemFieldType->setData(QString::fromStdString(field.jsonName), Qt::DisplayRole);
-        }
-        else if (field.type == MemoryFieldType::PointerType)
-        {
-            itemFieldType->setData(QString::fromStdString(field.jsonName), Qt::DisplayRole);
-        }
-        else if (field.type == MemoryFieldType::InlineStructType)
-        {
-            itemFieldType->setData(QString::fromStdString(field.jsonName), Qt::DisplayRole);
-        }
-        else if (gsMemoryFieldTypeToStringMapping.count(field.type) > 0)
-        {
-            itemFieldType->setData(QString::fromStdString(gsMemoryFieldTypeToStringMapping.at(field.type)), Qt::DisplayRole);
-        }
-        else
-        {
-            itemFieldType->setData("Unknown field type", Qt::DisplayRole);
-        }
-        itemFieldType->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
-        itemFieldType->setEditable(false);
+        itemFieldType->setData(QString::fromStdString(field.jsonName), Qt::DisplayRole);
+    }
+    else if (field.type == MemoryFieldType::PointerType)
+    {
+        itemFieldType->setData(QString::fromStdString(field.jsonName), Qt::DisplayRole);
+    }
+    else if (field.type == MemoryFieldType::InlineStructType)
+    {
+        itemFieldType->setData(QString::fromStdString(field.jsonName), Qt::DisplayRole);
+    }
+    else if (gsMemoryFieldTypeToStringMapping.count(field.type) > 0)
+    {
+        itemFieldType->setData(QString::fromStdString(gsMemoryFieldTypeToStringMapping.at(field.type)), Qt::DisplayRole);
+    }
+    else
+    {
+        itemFieldType->setData("Unknown field type", Qt::DisplayRole);
+    }
+    itemFieldType->setData(QString::fromStdString(fieldNameUID), gsRoleUID);
+    itemFieldType->setEditable(false);
 
-        itemParent->appendRow(QList<QStandardItem*>() << itemFieldName << itemFieldValue << itemFieldValueHex << itemFieldComparisonValue << itemFieldComparisonValueHex << itemFieldMemoryOffset
-                                                      << itemFieldMemoryOffsetDelta << itemFieldType << itemFieldComment);
+    return QList<QStandardItem*>() << itemFieldName << itemFieldValue << itemFieldValueHex << itemFieldComparisonValue << itemFieldComparisonValueHex << itemFieldMemoryOffset
+                                  << itemFieldMemoryOffsetDelta << itemFieldType << itemFieldComment;
+}
 
-        return itemFieldName;
+QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField& field, const std::string& fieldNameOverride, QStandardItem* parent)
+{
+    auto createAndInsertItem = [](const MemoryField& field, const std::string& fieldNameUID, QStandardItem* itemParent) -> QStandardItem*
+    {
+        auto items = createRowItems(field, fieldNameUID);
+        itemParent->appendRow(items);
+        return items.at(gsColField);
     };
 
     if (parent == nullptr)
@@ -138,6 +143,9 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
         parent = mModel->invisibleRootItem();
     }
 
+    // row insertions always have to reach the view, even in the middle of a batched update
+    auto signalsWereBlocked = mModel->blockSignals(false);
+
     QStandardItem* returnField = nullptr;
     switch (field.type)
     {
@@ -315,6 +323,7 @@ QStandardItem* S2Plugin::TreeViewMemoryFields::addMemoryField(const MemoryField&
             break;
         }
     }
+    mModel->blockSignals(signalsWereBlocked);
     return returnField;
 }
 
@@ -427,6 +436,8 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
             return;
         }
 
+        recordBatchedRowChange(itemField);
+
         itemField->setData(QString::fromStdString(fieldNameOverride), gsRoleFieldName);
         itemField->setData(memoryOffset, gsRoleMemoryOffset);
         itemMemoryOffset->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", memoryOffset), Qt::DisplayRole);
@@ -997,11 +1008,17 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
         {
             if (itemField->hasChildren())
             {
+                auto signalsWereBlocked = mModel->blockSignals(false);
                 itemField->removeRows(0, itemField->rowCount());
+                mModel->blockSignals(signalsWereBlocked);
             }
 
-            auto vectorCount = (memoryOffset == 0 ? 0 : (std::min)(50u, Script::Memory::ReadDword(memoryOffset + 20)));
-            auto vectorItemsOffset = Script::Memory::ReadQword(memoryOffset + 8);
+            // only a preview is shown inline, the full contents open in the paged vector view
+            auto totalCount = (memoryOffset == 0 ? 0 : Script::Memory::ReadDword(memoryOffset + 20));
+            auto vectorCount = (std::min)(50u, totalCount);
+            auto vectorItemsOffset = (memoryOffset == 0 ? 0 : Script::Memory::ReadQword(memoryOffset + 8));
+            itemValue->setData(QString::asprintf("<font color='blue'><u>Show contents (%lu)</u></font>", totalCount), Qt::DisplayRole);
+            itemValue->setData(memoryOffset, gsRoleRawValue);
             for (auto x = 0; x < vectorCount; ++x)
             {
                 MemoryField f;
@@ -1193,7 +1210,7 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
                 auto entityOffset = Entity::findEntityByUID(value, mToolbar->state());
                 if (entityOffset != 0)
                 {
-                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, mToolbar->entityDB());
+                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, mToolbar->entityDB(), mToolbar->state());
                     itemValue->setData(QString::asprintf("<font color='blue'><u>UID %lu (%s)</u></font>", value, entityName.c_str()), Qt::DisplayRole);
                 }
                 else
@@ -1217,7 +1234,7 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
                 auto comparisonEntityOffset = Entity::findEntityByUID(comparisonValue, mToolbar->state());
                 if (comparisonEntityOffset != 0)
                 {
-                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(comparisonEntityOffset, mToolbar->entityDB());
+                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(comparisonEntityOffset, mToolbar->entityDB(), mToolbar->state());
                     itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>UID %lu (%s)</u></font>", comparisonValue, entityName.c_str()), Qt::DisplayRole);
                 }
                 else
@@ -1244,7 +1261,7 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
                 auto entityOffset = Entity::findEntityByUID(value, mToolbar->state());
                 if (entityOffset != 0)
                 {
-                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, mToolbar->entityDB());
+                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, mToolbar->entityDB(), mToolbar->state());
                     itemValue->setData(QString::asprintf("<font color='blue'><u>UID %lu (%s)</u></font>", value, entityName.c_str()), Qt::DisplayRole);
                 }
                 else
@@ -1268,7 +1285,7 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
                 auto comparisonEntityOffset = Entity::findEntityByUID(comparisonValue, mToolbar->state());
                 if (comparisonEntityOffset != 0)
                 {
-                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(comparisonEntityOffset, mToolbar->entityDB());
+                    auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(comparisonEntityOffset, mToolbar->entityDB(), mToolbar->state());
                     itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>UID %lu (%s)</u></font>", comparisonValue, entityName.c_str()), Qt::DisplayRole);
                 }
                 else
@@ -1286,7 +1303,7 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
         case MemoryFieldType::EntityPointer:
         {
             size_t value = (memoryOffset == 0 ? 0 : Script::Memory::ReadQword(memoryOffset));
-            auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(value, mToolbar->entityDB());
+            auto entityName = mToolbar->configuration()->spelunky2()->getEntityName(value, mToolbar->entityDB(), mToolbar->state());
             itemValue->setData(QString::asprintf("<font color='blue'><u>%s</u></font>", entityName.c_str()), Qt::DisplayRole);
             auto newHexValue = QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", value);
             itemField->setBackground(itemValueHex->data(Qt::DisplayRole) == newHexValue ? Qt::transparent : highlightColor);
@@ -1295,7 +1312,7 @@ void S2Plugin::TreeViewMemoryFields::updateValueForField(const MemoryField& fiel
             itemValueHex->setData(value, gsRoleRawValue);
 
             size_t comparisonValue = (comparisonMemoryOffset == 0 ? 0 : Script::Memory::ReadQword(comparisonMemoryOffset));
-            auto comparisonEntityName = mToolbar->configuration()->spelunky2()->getEntityName(comparisonValue, mToolbar->entityDB());
+            auto comparisonEntityName = mToolbar->configuration()->spelunky2()->getEntityName(comparisonValue, mToolbar->entityDB(), mToolbar->state());
             itemComparisonValue->setData(QString::asprintf("<font color='blue'><u>%s</u></font>", comparisonEntityName.c_str()), Qt::DisplayRole);
             auto hexComparisonValue = QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", comparisonValue);
             itemComparisonValueHex->setData(hexComparisonValue, Qt::DisplayRole);
@@ -1934,6 +1951,15 @@ void S2Plugin::TreeViewMemoryFields::cellClicked(const QModelIndex& index)
                     }
                     break;
                 }
+                case MemoryFieldType::Vector:
+                {
+                    auto offset = clickedItem->data(gsRoleRawValue).toULongLong();
+                    if (offset != 0)
+                    {
+                        mToolbar->showVector(offset);
+                    }
+                    break;
+                }
                 case MemoryFieldType::StdMap:
                 {
                     auto offset = clickedItem->data(gsRoleRawValue).toULongLong();
@@ -2035,11 +2061,106 @@ void S2Plugin::TreeViewMemoryFields::cellClicked(const QModelIndex& index)
                     break;
                 }
             }
+            // the edit dialogs and toggles write to game memory, which the game doesn't pick up while paused
+            mToolbar->state()->invalidateFrameCache();
             emit memoryFieldValueUpdated(clickedItem->data(gsRoleFieldName).toString());
         }
     }
 }
 
+void S2Plugin::TreeViewMemoryFields::insertEntityPointerRows(int row, const std::vector<EntityPointerRow>& rows)
+{
+    if (rows.empty())
+    {
+        return;
+    }
+
+    MemoryField field;
+    field.type = MemoryFieldType::EntityPointer;
+
+    beginBatchUpdate();
+
+    // make room for all the rows at once, so the view gets a single insert instead of one per entity
+    auto root = mModel->invisibleRootItem();
+    auto signalsWereBlocked = mModel->blockSignals(false);
+    if (mModel->columnCount() < gsColComment + 1)
+    {
+        mModel->setColumnCount(gsColComment + 1);
+    }
+    root->insertRows(row, static_cast<int>(rows.size()));
+    mModel->blockSignals(signalsWereBlocked);
+
+    for (const auto& entityRow : rows)
+    {
+        field.name = entityRow.fieldName;
+        auto items = createRowItems(field, entityRow.fieldName);
+        for (auto column = 0; column < items.size(); ++column)
+        {
+            root->setChild(row, column, items.at(column));
+        }
+        setEntityPointerRowData(row, entityRow);
+        ++row;
+    }
+
+    endBatchUpdate();
+}
+
+void S2Plugin::TreeViewMemoryFields::updateEntityPointerRow(int row, const EntityPointerRow& entityRow)
+{
+    auto itemField = mModel->item(row, gsColField);
+    if (itemField == nullptr)
+    {
+        return;
+    }
+    auto fieldName = QString::fromStdString(entityRow.fieldName);
+    for (auto column = 0; column < mModel->columnCount(); ++column)
+    {
+        auto item = mModel->item(row, column);
+        if (item != nullptr && column != gsColComment)
+        {
+            item->setData(fieldName, gsRoleUID);
+        }
+    }
+    itemField->setData(fieldName, Qt::DisplayRole);
+    setEntityPointerRowData(row, entityRow);
+}
+
+void S2Plugin::TreeViewMemoryFields::removeTopLevelRows(int row, int count)
+{
+    // row removals always have to reach the view, even in the middle of a batched update
+    auto signalsWereBlocked = mModel->blockSignals(false);
+    mModel->removeRows(row, count);
+    mModel->blockSignals(signalsWereBlocked);
+}
+
+void S2Plugin::TreeViewMemoryFields::setEntityPointerRowData(int row, const EntityPointerRow& entityRow)
+{
+    // the values are known up front, so fill them in directly instead of going through updateValueForField
+    auto itemField = mModel->item(row, gsColField);
+    auto itemValue = mModel->item(row, gsColValue);
+    auto itemValueHex = mModel->item(row, gsColValueHex);
+    auto itemMemoryOffset = mModel->item(row, gsColMemoryOffset);
+    auto itemMemoryOffsetDelta = mModel->item(row, gsColMemoryOffsetDelta);
+    auto itemComparisonValue = mModel->item(row, gsColComparisonValue);
+
+    itemField->setData(QString::fromStdString(entityRow.fieldName), gsRoleFieldName);
+    itemField->setData(entityRow.memoryOffset, gsRoleMemoryOffset);
+    itemMemoryOffset->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", entityRow.memoryOffset), Qt::DisplayRole);
+    itemMemoryOffset->setData(entityRow.memoryOffset, gsRoleRawValue);
+    itemMemoryOffsetDelta->setData(QString::asprintf("+0x%llX", entityRow.memoryOffset), Qt::DisplayRole);
+    itemMemoryOffsetDelta->setData(entityRow.memoryOffset, gsRoleRawValue);
+    itemValue->setData(entityRow.memoryOffset, gsRoleMemoryOffset);
+    itemValue->setData(QString::fromStdString(entityRow.fieldName), gsRoleFieldName);
+    itemValue->setData(QString::asprintf("<font color='blue'><u>%s</u></font>", entityRow.entityName.c_str()), Qt::DisplayRole);
+    itemValue->setData(entityRow.entityOffset, gsRoleRawValue);
+    itemValueHex->setData(QString::asprintf("<font color='blue'><u>0x%016llX</u></font>", entityRow.entityOffset), Qt::DisplayRole);
+    itemValueHex->setData(entityRow.entityOffset, gsRoleRawValue);
+    itemComparisonValue->setData(0, gsRoleMemoryOffset);
+    itemComparisonValue->setData(QString::fromStdString("comparison." + entityRow.fieldName), gsRoleFieldName);
+
+    recordBatchedRowChange(itemField);
+}
+
 void S2Plugin::TreeViewMemoryFields::clear()
 {
     mSavedColumnWidths[gsColField] = columnWidth(gsColField);
@@ -2049,7 +2170,73 @@ void S2Plugin::TreeViewMemoryFields::clear()
     mSavedColumnWidths[gsColMemoryOffsetDelta] = columnWidth(gsColMemoryOffsetDelta);
     mSavedColumnWidths[gsColType] = columnWidth(gsColType);
     mSavedColumnWidths[gsColComment] = columnWidth(gsColComment);
+    mBatchedRowChanges.clear();
+    auto signalsWereBlocked = mModel->blockSignals(false);
     mModel->clear();
+    mModel->blockSignals(signalsWereBlocked);
+}
+
+void S2Plugin::TreeViewMemoryFields::beginBatchUpdate()
+{
+    if (mBatchUpdateDepth++ == 0)
+    {
+        setUpdatesEnabled(false);
+        mModel->blockSignals(true);
+    }
+}
+
+void S2Plugin::TreeViewMemoryFields::endBatchUpdate()
+{
+    if (mBatchUpdateDepth == 0 || --mBatchUpdateDepth > 0)
+    {
+        return;
+    }
+
+    mModel->blockSignals(false);
+    auto lastColumn = mModel->columnCount() - 1;
+    for (const auto& [parentItem, changes] : mBatchedRowChanges)
+    {
+        QModelIndex parentIndex;
+        if (parentItem != nullptr)
+        {
+            if (!changes.parentIndex.isValid()) // parent got removed during the batch
+            {
+                continue;
+            }
+            parentIndex = changes.parentIndex;
+        }
+
+        // coalesce the touched rows into contiguous ranges, one dataChanged per range
+        auto rowCount = mModel->rowCount(parentIndex);
+        auto it = changes.rows.begin();
+        while (it != changes.rows.end() && *it < rowCount)
+        {
+            auto firstRow = *it;
+            auto lastRow = firstRow;
+            while (++it != changes.rows.end() && *it == lastRow + 1 && *it < rowCount)
+            {
+                lastRow = *it;
+            }
+            emit mModel->dataChanged(mModel->index(firstRow, 0, parentIndex), mModel->index(lastRow, lastColumn, parentIndex));
+        }
+    }
+    mBatchedRowChanges.clear();
+    setUpdatesEnabled(true);
+}
+
+void S2Plugin::TreeViewMemoryFields::recordBatchedRowChange(QStandardItem* item)
+{
+    if (mBatchUpdateDepth == 0)
+    {
+        return;
+    }
+    auto parentItem = item->parent();
+    auto& changes = mBatchedRowChanges[parentItem];
+    if (parentItem != nullptr && !changes.parentIndex.isValid())
+    {
+        changes.parentIndex = parentItem->index();
+    }
+    changes.rows.insert(item->row());
 }
 
 void S2Plugin::TreeViewMemoryFields::expandItem(QStandardItem* item)
@@ -2117,8 +2304,18 @@ void S2Plugin::TreeViewMemoryFields::startDrag(Qt::DropActions supportedActions)
 
     nlohmann::json o;
     o[gsJSONDragDropMemoryField_UID] = uniqueFieldName;
-    o[gsJSONDragDropMemoryField_Offset] = memoryOffset;
-    o[gsJSONDragDropMemoryField_Type] = memoryField.type;
+    if (memoryField.type == MemoryFieldType::Flag && selectedItem->parent() != nullptr)
+    {
+        auto flagsItem = selectedItem->parent();
+        o[gsJSONDragDropMemoryField_Offset] = flagsItem->data(gsRoleMemoryOffset).toULongLong();
+        o[gsJSONDragDropMemoryField_Type] = flagsItem->data(gsRoleEntireMemoryField).value<MemoryField>().type;
+        o[gsJSONDragDropMemoryField_Flag] = selectedItem->data(gsRoleFlagIndex).toUInt();
+    }
+    else
+    {
+        o[gsJSONDragDropMemoryField_Offset] = memoryOffset;
+        o[gsJSONDragDropMemoryField_Type] = memoryField.type;
+    }
     auto json = QString::fromStdString(o.dump());
 
     auto codec = QTextCodec::codecForName("UTF-8");
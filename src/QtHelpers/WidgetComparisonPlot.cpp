@@ -0,0 +1,215 @@
+#include "QtHelpers/WidgetComparisonPlot.h"
+#include "Data/Logger.h"
+#include "Data/LoggerComparison.h"
+#include "Data/LoggerSession.h"
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPen>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static const uint8_t gsPlotMargin = 5;
+
+S2Plugin::WidgetComparisonPlot::WidgetComparisonPlot(Logger* logger, LoggerComparison* comparison, QWidget* parent)
+    : QWidget(parent), mLogger(logger), mComparison(comparison)
+{
+    setMouseTracking(true);
+    setCursor(Qt::CrossCursor);
+}
+
+void S2Plugin::WidgetComparisonPlot::comparisonChanged()
+{
+    mColumnsWidth = -1;
+    update();
+}
+
+void S2Plugin::WidgetComparisonPlot::paintEvent(QPaintEvent* event)
+{
+    auto painter = QPainter(this);
+
+    painter.save();
+
+    painter.fillRect(rect(), Qt::black);
+    painter.setPen(Qt::darkGray);
+    auto paintBounds = rect().adjusted(0, 0, -1, -1);
+    float drawHeight = paintBounds.height() - (2 * gsPlotMargin);
+    painter.drawRect(paintBounds);
+    painter.translate(gsPlotMargin, gsPlotMargin);
+
+    auto frameCount = mComparison->frameCount();
+    if (frameCount == 0)
+    {
+        painter.restore();
+        return;
+    }
+    if (mColumnsWidth != plotWidth())
+    {
+        decimate();
+    }
+    auto framesPerPixel = static_cast<double>(frameCount) / plotWidth();
+
+    // aligned frame 0: where the sessions started, or where the trigger fired in each
+    painter.setPen(QPen(Qt::gray, 1, Qt::DashLine));
+    auto originX = -mComparison->firstFrame() / framesPerPixel;
+    painter.drawLine(QPointF(originX, 0), QPointF(originX, drawHeight));
+
+    auto [lowerBound, upperBound] = mComparison->bounds();
+    auto range = upperBound - lowerBound;
+    auto mapY = [&](double value) { return range == 0 ? drawHeight / 2 : drawHeight - (((value - lowerBound) / range) * drawHeight); };
+
+    QPolygonF line;
+    for (size_t session = 0; session < mComparison->sessionCount() && session < mLogger->sessionCount(); ++session)
+    {
+        painter.setPen(mLogger->sessionAt(session).color);
+        const auto& columns = mColumns[session];
+        // a vertical stroke per pixel column, as in the samples plot; the line is broken where a session has no value
+        double previousY = 0;
+        line.clear();
+        for (size_t x = 0; x < columns.size(); ++x)
+        {
+            if (std::isnan(columns[x].first))
+            {
+                painter.drawPolyline(line);
+                line.clear();
+                continue;
+            }
+            auto low = mapY(columns[x].first);
+            auto high = mapY(columns[x].second);
+            if (!line.isEmpty() && std::abs(previousY - low) < std::abs(previousY - high))
+            {
+                line.append(QPointF(x, low));
+                line.append(QPointF(x, high));
+                previousY = high;
+            }
+            else
+            {
+                line.append(QPointF(x, high));
+                line.append(QPointF(x, low));
+                previousY = low;
+            }
+        }
+        painter.drawPolyline(line);
+    }
+    painter.restore();
+
+    if (!mCurrentMousePos.isNull() && underMouse())
+    {
+        painter.save();
+        painter.setRenderHint(QPainter::HighQualityAntialiasing, true);
+        static const auto font = QFont("Arial", 10);
+        painter.setFont(font);
+
+        painter.setPen(Qt::cyan);
+        painter.drawLine(mCurrentMousePos.x(), 0, mCurrentMousePos.x(), paintBounds.height());
+
+        auto frameIndex = static_cast<int64_t>(std::floor((mCurrentMousePos.x() - gsPlotMargin) * framesPerPixel));
+        if (frameIndex >= 0 && frameIndex < static_cast<int64_t>(frameCount))
+        {
+            auto drawOnLeftSide = (mCurrentMousePos.x() > (this->width() / 2));
+            auto drawCaption = [&](const QString& caption, int y)
+            {
+                if (drawOnLeftSide)
+                {
+                    auto captionSize = QFontMetrics(font).size(Qt::TextSingleLine, caption);
+                    painter.drawText(QPoint(mCurrentMousePos.x() - 15 - captionSize.width(), mCurrentMousePos.y() + y), caption);
+                }
+                else
+                {
+                    painter.drawText(QPoint(mCurrentMousePos.x() + 15, mCurrentMousePos.y() + y), caption);
+                }
+            };
+            drawCaption(QString("Frame %1").arg(mComparison->firstFrame() + frameIndex), 0);
+
+            uint16_t y = 15;
+            for (size_t session = 0; session < mComparison->sessionCount() && session < mLogger->sessionCount(); ++session)
+            {
+                auto value = mComparison->series(session)[frameIndex];
+                if (std::isnan(value))
+                {
+                    continue;
+                }
+                painter.setPen(mLogger->sessionAt(session).color);
+                drawCaption(QString("%1 (%2)").arg(value).arg(QString::fromStdString(mLogger->sessionAt(session).name)), y);
+                y += 15;
+            }
+        }
+        painter.restore();
+    }
+}
+
+void S2Plugin::WidgetComparisonPlot::decimate()
+{
+    mColumnsWidth = plotWidth();
+    auto frameCount = mComparison->frameCount();
+    auto columnCount = (std::min)(static_cast<size_t>(mColumnsWidth), frameCount);
+    auto framesPerPixel = static_cast<double>(frameCount) / mColumnsWidth;
+    constexpr auto noValue = std::numeric_limits<double>::quiet_NaN();
+
+    mColumns.resize(mComparison->sessionCount());
+    for (size_t session = 0; session < mComparison->sessionCount(); ++session)
+    {
+        const auto& series = mComparison->series(session);
+        auto& columns = mColumns[session];
+        columns.assign(mColumnsWidth, std::make_pair(noValue, noValue));
+        for (size_t frame = 0; frame < frameCount; ++frame)
+        {
+            auto value = series[frame];
+            if (std::isnan(value))
+            {
+                continue;
+            }
+            auto x = (std::min)(static_cast<size_t>(frame / framesPerPixel), columns.size() - 1);
+            auto& column = columns[x];
+            if (std::isnan(column.first))
+            {
+                column = std::make_pair(value, value);
+            }
+            else
+            {
+                column.first = (std::min)(column.first, value);
+                column.second = (std::max)(column.second, value);
+            }
+        }
+        // fewer frames than pixels: spread each frame's value over its pixels
+        if (columnCount < columns.size())
+        {
+            for (size_t x = 0; x < columns.size(); ++x)
+            {
+                auto frame = static_cast<size_t>(x * framesPerPixel);
+                if (frame < frameCount)
+                {
+                    auto value = series[frame];
+                    columns[x] = std::make_pair(value, value);
+                }
+            }
+        }
+    }
+}
+
+void S2Plugin::WidgetComparisonPlot::mouseMoveEvent(QMouseEvent* event)
+{
+    mCurrentMousePos = event->pos();
+    update();
+}
+
+void S2Plugin::WidgetComparisonPlot::leaveEvent(QEvent* event)
+{
+    update();
+}
+
+int S2Plugin::WidgetComparisonPlot::plotWidth() const
+{
+    return (std::max)(1, width() - (2 * gsPlotMargin));
+}
+
+QSize S2Plugin::WidgetComparisonPlot::minimumSizeHint() const
+{
+    return QSize(150, 50);
+}
+
+QSize S2Plugin::WidgetComparisonPlot::sizeHint() const
+{
+    return minimumSizeHint();
+}
@@ -5,7 +5,9 @@
 #include <QFont>
 #include <QFontMetrics>
 #include <QPainter>
-#include <QScrollArea>
+#include <QPen>
+#include <algorithm>
+#include <cmath>
 
 static const uint8_t gsPlotMargin = 5;
 
@@ -28,89 +30,78 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent* event)
     painter.drawRect(paintBounds);
     painter.translate(gsPlotMargin, gsPlotMargin);
 
-    for (auto i = 0; i < mLogger->fieldCount(); ++i)
+    clampView();
+    auto width = plotWidth();
+    auto sampleCount = mLogger->sampleCount();
+    auto first = static_cast<size_t>(mViewFirst);
+    auto last = (std::min)(sampleCount, static_cast<size_t>(std::ceil(mViewFirst + (width * mSamplesPerPixel))) + 1);
+    // when recording to a file, zoomed in far enough the visible samples are read back; further out the block bounds
+    // of the columns are used instead
+    mLogger->pageIn(first, last);
+
+    // where the captures' triggers fired
+    painter.setPen(QPen(Qt::gray, 1, Qt::DashLine));
+    for (auto triggerSample : mLogger->triggerSamples())
+    {
+        if (triggerSample >= first && triggerSample < last)
+        {
+            auto x = (triggerSample - mViewFirst) / mSamplesPerPixel;
+            painter.drawLine(QPointF(x, 0), QPointF(x, drawHeight));
+        }
+    }
+
+    QPolygonF line;
+    for (auto i = 0; i < mLogger->fieldCount() && first < last; ++i)
     {
         const auto& field = mLogger->fieldAt(i);
+        const auto& column = mLogger->samplesForField(i);
         painter.setPen(field.color);
 
-        auto [lowerBound, upperBound] = mLogger->sampleBounds(field);
-        const auto& samples = mLogger->samplesForField(field.uuid);
-        size_t x = 0;
-        uint16_t mappedY;
-        uint16_t prevX = 0, prevY = 0;
-        bool first = true;
-        for (const auto& sample : samples)
+        // scaled to what's visible, so zooming in on a detail also stretches it vertically
+        auto [lowerBound, upperBound] = column.rangeBounds(first, last);
+        auto range = upperBound - lowerBound;
+        auto mapY = [&](double value) { return range == 0 ? drawHeight / 2 : drawHeight - (((value - lowerBound) / range) * drawHeight); };
+
+        line.clear();
+        if (mSamplesPerPixel <= 1 && column.isResident(first, last))
         {
-            switch (field.type)
-            {
-                case MemoryFieldType::Byte:
-                {
-                    mappedY = ((std::any_cast<int8_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedByte:
-                case MemoryFieldType::Bool:
-                case MemoryFieldType::Flags8:
-                case MemoryFieldType::State8:
-                case MemoryFieldType::CharacterDBID:
-                {
-                    mappedY = ((std::any_cast<uint8_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Word:
-                {
-                    mappedY = ((std::any_cast<int16_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedWord:
-                case MemoryFieldType::Flags16:
-                case MemoryFieldType::State16:
-                {
-                    mappedY = ((std::any_cast<uint16_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Dword:
+            // zoomed in, every sample gets a point
+            column.visit(
+                [&](const auto& samples)
                 {
-                    mappedY = ((std::any_cast<int32_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::UnsignedDword:
-                case MemoryFieldType::Flags32:
-                case MemoryFieldType::State32:
-                case MemoryFieldType::EntityDBID:
-                case MemoryFieldType::EntityUID:
-                case MemoryFieldType::ParticleDBID:
-                case MemoryFieldType::TextureDBID:
-                case MemoryFieldType::StringsTableID:
-                {
-                    mappedY = ((std::any_cast<uint32_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Float:
-                {
-                    mappedY = ((std::any_cast<float>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
-                }
-                case MemoryFieldType::Qword:
+                    for (auto x = first; x < last; ++x)
+                    {
+                        line.append(QPointF((x - mViewFirst) / mSamplesPerPixel, mapY(static_cast<double>(samples[x - column.residentFirst()]))));
+                    }
+                });
+        }
+        else
+        {
+            // zoomed out, a vertical stroke from the lowest to the highest sample per pixel column; joining the strokes
+            // on the side nearest the previous one keeps it a single polyline
+            auto columns = static_cast<size_t>(std::ceil((last - first) / mSamplesPerPixel));
+            column.decimate(first, last, columns, mDecimated);
+            auto offset = (first - mViewFirst) / mSamplesPerPixel;
+            double previousY = 0;
+            for (size_t x = 0; x < mDecimated.size(); ++x)
+            {
+                auto low = mapY(mDecimated[x].first);
+                auto high = mapY(mDecimated[x].second);
+                if (x != 0 && std::abs(previousY - low) < std::abs(previousY - high))
                 {
-                    mappedY = ((std::any_cast<int64_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
+                    line.append(QPointF(offset + x, low));
+                    line.append(QPointF(offset + x, high));
+                    previousY = high;
                 }
-                case MemoryFieldType::UnsignedQword:
+                else
                 {
-                    mappedY = ((std::any_cast<uint64_t>(sample) - lowerBound) / (float)(upperBound - lowerBound)) * drawHeight;
-                    break;
+                    line.append(QPointF(offset + x, high));
+                    line.append(QPointF(offset + x, low));
+                    previousY = low;
                 }
             }
-            if (!first)
-            {
-                painter.drawLine(prevX, prevY, x, drawHeight - mappedY);
-            }
-            first = false;
-            prevX = x;
-            prevY = drawHeight - mappedY;
-            x++;
         }
+        painter.drawPolyline(line);
     }
     painter.restore();
 
@@ -124,11 +115,11 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent* event)
         painter.setPen(Qt::cyan);
         painter.drawLine(mCurrentMousePos.x(), 0, mCurrentMousePos.x(), paintBounds.height());
 
-        int64_t sampleIndex = mCurrentMousePos.x() - gsPlotMargin;
-        if (sampleIndex >= 0 && sampleIndex < mLogger->sampleCount())
+        auto sampleIndex = sampleIndexAt(mCurrentMousePos.x());
+        if (sampleIndex >= 0 && sampleIndex < static_cast<int64_t>(mLogger->sampleCount()))
         {
-            auto scrollArea = qobject_cast<QScrollArea*>(parent()->parent());
-            auto drawOnLeftSide = (scrollArea->mapFromGlobal(QCursor::pos()).x() > (scrollArea->width() / 2));
+            auto drawOnLeftSide = (mCurrentMousePos.x() > (this->width() / 2));
+            mLogger->pageIn(sampleIndex, sampleIndex + 1);
 
             QString sampleCaption = QString("Sample %1").arg(sampleIndex);
             if (drawOnLeftSide)
@@ -145,70 +136,7 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent* event)
             for (auto i = 0; i < mLogger->fieldCount(); ++i)
             {
                 const auto& field = mLogger->fieldAt(i);
-                const auto& samples = mLogger->samplesForField(field.uuid);
-                const auto& sample = samples.at(sampleIndex);
-                QString caption;
-                switch (field.type)
-                {
-                    case MemoryFieldType::Byte:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int8_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedByte:
-                    case MemoryFieldType::Bool:
-                    case MemoryFieldType::Flags8:
-                    case MemoryFieldType::State8:
-                    case MemoryFieldType::CharacterDBID:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint8_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Word:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int16_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedWord:
-                    case MemoryFieldType::Flags16:
-                    case MemoryFieldType::State16:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint16_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Dword:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int32_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedDword:
-                    case MemoryFieldType::Flags32:
-                    case MemoryFieldType::State32:
-                    case MemoryFieldType::EntityDBID:
-                    case MemoryFieldType::EntityUID:
-                    case MemoryFieldType::ParticleDBID:
-                    case MemoryFieldType::TextureDBID:
-                    case MemoryFieldType::StringsTableID:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint32_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Float:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<float>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::Qword:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<int64_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                    case MemoryFieldType::UnsignedQword:
-                    {
-                        caption = QString("%1 (%2)").arg(std::any_cast<uint64_t>(sample)).arg(QString::fromStdString(field.name));
-                        break;
-                    }
-                }
+                auto caption = QString("%1 (%2)").arg(mLogger->samplesForField(i).valueAt(sampleIndex).toString()).arg(QString::fromStdString(field.name));
                 painter.setPen(field.color);
                 if (drawOnLeftSide)
                 {
@@ -229,17 +157,85 @@ void S2Plugin::WidgetSamplesPlot::paintEvent(QPaintEvent* event)
 void S2Plugin::WidgetSamplesPlot::mouseMoveEvent(QMouseEvent* event)
 {
     mCurrentMousePos = event->pos();
+    if (mDragging)
+    {
+        mViewFirst = mDragStartViewFirst - ((event->pos().x() - mDragStartX) * mSamplesPerPixel);
+        mFitToWidth = false;
+    }
     update();
 }
 
+void S2Plugin::WidgetSamplesPlot::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton)
+    {
+        mDragging = true;
+        mDragStartX = event->pos().x();
+        mDragStartViewFirst = mViewFirst;
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void S2Plugin::WidgetSamplesPlot::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton)
+    {
+        mDragging = false;
+        setCursor(Qt::CrossCursor);
+    }
+}
+
+void S2Plugin::WidgetSamplesPlot::wheelEvent(QWheelEvent* event)
+{
+    // zoom around the sample under the cursor, so it stays put
+    auto x = event->pos().x() - gsPlotMargin;
+    auto anchor = mViewFirst + (x * mSamplesPerPixel);
+    auto factor = std::pow(1.25, -event->angleDelta().y() / 120.);
+    auto fitSamplesPerPixel = (std::max)(static_cast<double>(mLogger->sampleCount()) / plotWidth(), msMinSamplesPerPixel);
+    mSamplesPerPixel = std::clamp(mSamplesPerPixel * factor, msMinSamplesPerPixel, fitSamplesPerPixel);
+    mViewFirst = anchor - (x * mSamplesPerPixel);
+    mFitToWidth = (mSamplesPerPixel >= fitSamplesPerPixel);
+    update();
+    event->accept();
+}
+
 void S2Plugin::WidgetSamplesPlot::leaveEvent(QEvent* event)
 {
     update();
 }
 
+void S2Plugin::WidgetSamplesPlot::resetView()
+{
+    mFitToWidth = true;
+    update();
+}
+
+int S2Plugin::WidgetSamplesPlot::plotWidth() const
+{
+    return (std::max)(1, width() - (2 * gsPlotMargin));
+}
+
+void S2Plugin::WidgetSamplesPlot::clampView()
+{
+    auto sampleCount = static_cast<double>(mLogger->sampleCount());
+    if (mFitToWidth)
+    {
+        mViewFirst = 0;
+        mSamplesPerPixel = (std::max)(sampleCount / plotWidth(), msMinSamplesPerPixel);
+        return;
+    }
+    auto visible = plotWidth() * mSamplesPerPixel;
+    mViewFirst = std::clamp(mViewFirst, 0., (std::max)(0., sampleCount - visible));
+}
+
+int64_t S2Plugin::WidgetSamplesPlot::sampleIndexAt(int x) const
+{
+    return static_cast<int64_t>(std::floor(mViewFirst + ((x - gsPlotMargin) * mSamplesPerPixel) + (mSamplesPerPixel < 1 ? 0.5 : 0)));
+}
+
 QSize S2Plugin::WidgetSamplesPlot::minimumSizeHint() const
 {
-    return QSize(mLogger->sampleCount() + (gsPlotMargin * 2) + 100, 50);
+    return QSize(150, 50);
 }
 
 QSize S2Plugin::WidgetSamplesPlot::sizeHint() const
@@ -1,6 +1,14 @@
 #include "QtHelpers/WidgetSpelunkyLevel.h"
+#include "Data/EntityHeatmap.h"
+#include "Data/State.h"
+#include "Views/ViewToolbar.h"
 #include "pluginmain.h"
+#include <QMouseEvent>
+#include <QPaintEvent>
 #include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 struct PostponedEntity
 {
@@ -10,7 +18,7 @@ struct PostponedEntity
     PostponedEntity(float x_, float y_, const QColor& color_) : x(x_), y(y_), color(color_) {}
 };
 
-S2Plugin::WidgetSpelunkyLevel::WidgetSpelunkyLevel(QWidget* parent) : QWidget(parent) {}
+S2Plugin::WidgetSpelunkyLevel::WidgetSpelunkyLevel(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar) {}
 
 void S2Plugin::WidgetSpelunkyLevel::paintEvent(QPaintEvent* event)
 {
@@ -23,25 +31,24 @@ void S2Plugin::WidgetSpelunkyLevel::paintEvent(QPaintEvent* event)
     painter.save();
     painter.scale(msScaleFactor, msScaleFactor);
     painter.setPen(Qt::transparent);
-    for (uint32_t i = 0; i < (std::min)(10000u, mEntitiesCount); ++i)
+
+    // only the entities in the part of the level that needs repainting, plus a tile for the block size
+    auto exposed = event->rect();
+    std::vector<const SpatialEntity*> visibleEntities;
+    mSpatialIndex.queryRect((exposed.left() / msScaleFactor) - msMarginHor - 1, msMarginVer + msLevelMaxHeight - (exposed.bottom() / msScaleFactor) - 1,
+                            (exposed.right() / msScaleFactor) - msMarginHor + 1, msMarginVer + msLevelMaxHeight - (exposed.top() / msScaleFactor) + 1, visibleEntities);
+    const SpatialEntity* selectedEntity = nullptr;
+    for (auto e : visibleEntities)
     {
         QColor colorToUse;
-        auto entityPtr = mEntitiesOffset + (i * sizeof(size_t));
-        auto entity = Script::Memory::ReadQword(entityPtr);
-        auto entityDB = Script::Memory::ReadQword(entity + 8);
-        auto entityUID = Script::Memory::ReadDword(entity + 56);
-        auto entityType = Script::Memory::ReadDword(entityDB + 20);
-        auto entityMask = Script::Memory::ReadDword(entityDB + 24);
-        auto entityOverlay = Script::Memory::ReadQword(entity + 16);
-
-        auto foundInIDs = (mEntityIDsToPaint.count(entityType) == 1);
-        auto foundInUIDs = (mEntityUIDsToPaint.count(entityUID) == 1);
+        auto foundInIDs = (mEntityIDsToPaint.count(e->typeID) == 1);
+        auto foundInUIDs = (mEntityUIDsToPaint.count(e->uid) == 1);
         auto foundInMasks = false;
         if (!foundInIDs && !foundInUIDs) // only check masks if not found elsewhere
         {
             for (const auto& [mask, color] : mEntityMasksToPaint)
             {
-                if ((entityMask & mask) == mask)
+                if ((e->searchMask & mask) == mask)
                 {
                     foundInMasks = true;
                     colorToUse = color;
@@ -49,22 +56,25 @@ void S2Plugin::WidgetSpelunkyLevel::paintEvent(QPaintEvent* event)
                 }
             }
         }
+        if (mSelectedEntityUID != 0 && e->uid == mSelectedEntityUID)
+        {
+            selectedEntity = e;
+        }
 
         if (foundInIDs || foundInUIDs || foundInMasks)
         {
-            auto [entityX, entityY] = getEntityCoordinates(entity);
             if (foundInIDs && !foundInUIDs)
             {
-                colorToUse = mEntityIDsToPaint.at(entityType);
-                postponedEntities.emplace_back(entityX, entityY, colorToUse);
+                colorToUse = mEntityIDsToPaint.at(e->typeID);
+                postponedEntities.emplace_back(e->x, e->y, colorToUse);
             }
             else if (foundInUIDs)
             {
-                colorToUse = mEntityUIDsToPaint.at(entityUID);
-                postponedEntities.emplace_back(entityX, entityY, colorToUse);
+                colorToUse = mEntityUIDsToPaint.at(e->uid);
+                postponedEntities.emplace_back(e->x, e->y, colorToUse);
             }
             painter.setBrush(colorToUse);
-            painter.drawRect(QRectF(msMarginHor + entityX, msMarginVer + msLevelMaxHeight - entityY, 1.0, 1.0));
+            painter.drawRect(QRectF(msMarginHor + e->x, msMarginVer + msLevelMaxHeight - e->y, 1.0, 1.0));
         }
     }
 
@@ -73,6 +83,17 @@ void S2Plugin::WidgetSpelunkyLevel::paintEvent(QPaintEvent* event)
         painter.setBrush(e.color);
         painter.drawRect(QRectF(msMarginHor + e.x, msMarginVer + msLevelMaxHeight - e.y, 1.0, 1.0));
     }
+    if (mHeatmap != nullptr)
+    {
+        // one image for the whole overlay, cell (x, y) is pixel (x, height - 1 - y)
+        painter.drawImage(QRectF(msMarginHor, msMarginVer + msLevelMaxHeight - (EntityHeatmap::msHeight - 1), EntityHeatmap::msWidth, EntityHeatmap::msHeight), mHeatmapImage);
+    }
+    if (selectedEntity != nullptr)
+    {
+        painter.setPen(QPen(Qt::black, 0.4));
+        painter.setBrush(Qt::transparent);
+        painter.drawRect(QRectF(msMarginHor + selectedEntity->x - 0.5, msMarginVer + msLevelMaxHeight - selectedEntity->y - 0.5, 2.0, 2.0));
+    }
     painter.restore();
 
     // DRAW BORDER
@@ -83,11 +104,119 @@ void S2Plugin::WidgetSpelunkyLevel::paintEvent(QPaintEvent* event)
 
 void S2Plugin::WidgetSpelunkyLevel::loadEntities(size_t entitiesOffset, uint32_t entitiesCount)
 {
-    mEntitiesOffset = entitiesOffset;
-    mEntitiesCount = entitiesCount;
+    std::vector<size_t> entities(entitiesCount);
+    if (entitiesCount != 0 && !Script::Memory::Read(entitiesOffset, entities.data(), entitiesCount * sizeof(size_t), nullptr))
+    {
+        entities.clear();
+    }
+    mSpatialIndex.build(entities, mToolbar->state(), mToolbar->entityDB());
     update();
 }
 
+void S2Plugin::WidgetSpelunkyLevel::setHeatmap(EntityHeatmap* heatmap, size_t layer)
+{
+    mHeatmap = heatmap;
+    mHeatmapLayer = layer;
+    mHeatmapImage = QImage(EntityHeatmap::msWidth, EntityHeatmap::msHeight, QImage::Format_ARGB32);
+    mHeatmapImage.fill(Qt::transparent);
+    mHeatmapCounts.assign(EntityHeatmap::msWidth * EntityHeatmap::msHeight, 0);
+    mHeatmapScale = 0;
+    update();
+}
+
+void S2Plugin::WidgetSpelunkyLevel::updateHeatmap()
+{
+    if (mHeatmap == nullptr)
+    {
+        return;
+    }
+    auto maxCount = mHeatmap->takeChangedCells(mHeatmapLayer, mHeatmapChangedCells);
+    if (mHeatmapChangedCells.empty())
+    {
+        return;
+    }
+    for (const auto& [cell, count] : mHeatmapChangedCells)
+    {
+        mHeatmapCounts[cell] = count;
+    }
+
+    // colours are relative to the highest count, rounded up to a power of two so the whole image only needs
+    // recolouring when that doubles (or after clearing), otherwise just the cells that changed are
+    uint32_t scale = 1;
+    while (scale < maxCount && scale < 0x80000000)
+    {
+        scale <<= 1;
+    }
+    if (scale != mHeatmapScale)
+    {
+        mHeatmapScale = scale;
+        for (uint32_t cell = 0; cell < mHeatmapCounts.size(); ++cell)
+        {
+            mHeatmapImage.setPixel(cell % EntityHeatmap::msWidth, EntityHeatmap::msHeight - 1 - (cell / EntityHeatmap::msWidth), heatmapColor(mHeatmapCounts[cell]));
+        }
+    }
+    else
+    {
+        for (const auto& [cell, count] : mHeatmapChangedCells)
+        {
+            mHeatmapImage.setPixel(cell % EntityHeatmap::msWidth, EntityHeatmap::msHeight - 1 - (cell / EntityHeatmap::msWidth), heatmapColor(count));
+        }
+    }
+    update();
+}
+
+QRgb S2Plugin::WidgetSpelunkyLevel::heatmapColor(uint32_t count) const
+{
+    if (count == 0)
+    {
+        return qRgba(0, 0, 0, 0);
+    }
+    // logarithmic, from a faint blue for a single visit to an opaque red for the hottest tiles
+    auto t = std::log2(static_cast<double>(count) + 1.) / std::log2(static_cast<double>(mHeatmapScale) + 1.);
+    t = std::clamp(t, 0., 1.);
+    return qRgba(static_cast<int>(255 * t), 0, static_cast<int>(255 * (1. - t)), 80 + static_cast<int>(150 * t));
+}
+
+const S2Plugin::EntitySpatialIndex& S2Plugin::WidgetSpelunkyLevel::spatialIndex() const noexcept
+{
+    return mSpatialIndex;
+}
+
+uint32_t S2Plugin::WidgetSpelunkyLevel::selectedEntityUID() const noexcept
+{
+    return mSelectedEntityUID;
+}
+
+const S2Plugin::SpatialEntity* S2Plugin::WidgetSpelunkyLevel::entityAt(const QPoint& pos) const
+{
+    // the block of an entity is drawn from its position one tile to the right and one tile up
+    auto x = (pos.x() / msScaleFactor) - msMarginHor - 0.5f;
+    auto y = msMarginVer + msLevelMaxHeight - (pos.y() / msScaleFactor) + 0.5f;
+    return mSpatialIndex.nearest(x, y, msPickRadius);
+}
+
+void S2Plugin::WidgetSpelunkyLevel::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton)
+    {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    auto e = entityAt(event->pos());
+    mSelectedEntityUID = e == nullptr ? 0 : e->uid;
+    update();
+    emit entitySelected(e == nullptr ? 0 : e->entity);
+}
+
+void S2Plugin::WidgetSpelunkyLevel::mouseDoubleClickEvent(QMouseEvent* event)
+{
+    auto e = entityAt(event->pos());
+    if (e != nullptr)
+    {
+        emit entityActivated(e->entity);
+    }
+}
+
 void S2Plugin::WidgetSpelunkyLevel::paintEntityID(uint32_t entityTypeID, const QColor& color)
 {
     mEntityIDsToPaint[entityTypeID] = color;
@@ -126,20 +255,3 @@ QSize S2Plugin::WidgetSpelunkyLevel::sizeHint() const
 {
     return minimumSizeHint();
 }
-
-std::pair<float, float> S2Plugin::WidgetSpelunkyLevel::getEntityCoordinates(size_t entityOffset) const
-{
-    auto rawX = Script::Memory::ReadDword(entityOffset + 64);
-    auto rawY = Script::Memory::ReadDword(entityOffset + 68);
-    float entityX = reinterpret_cast<float&>(rawX);
-    float entityY = reinterpret_cast<float&>(rawY);
-
-    auto entityOverlay = Script::Memory::ReadQword(entityOffset + 16);
-    if (entityOverlay != 0)
-    {
-        auto [addX, addY] = getEntityCoordinates(entityOverlay);
-        entityX += addX;
-        entityY += addY;
-    }
-    return std::make_pair(entityX, entityY);
-}
@@ -1,5 +1,6 @@
 #include "Spelunky2.h"
 #include "Data/EntityDB.h"
+#include "Data/State.h"
 #include "pluginmain.h"
 #include <QIcon>
 #include <QMessageBox>
@@ -135,7 +136,7 @@ size_t S2Plugin::Spelunky2::spelunky2AfterBundleSize()
 //     return offset;
 // }
 
-std::string S2Plugin::Spelunky2::getEntityName(size_t offset, EntityDB* entityDB) const
+std::string S2Plugin::Spelunky2::getEntityName(size_t offset, EntityDB* entityDB, State* state) const
 {
     std::string entityName = "";
     if (offset == 0)
@@ -143,7 +144,7 @@ std::string S2Plugin::Spelunky2::getEntityName(size_t offset, EntityDB* entityDB
         return entityName;
     }
 
-    auto entityID = getEntityTypeID(offset);
+    auto entityID = getEntityTypeID(offset, entityDB, state);
 
     if (entityID > 0 && entityID <= entityDB->entityList()->highestID())
     {
@@ -156,16 +157,11 @@ std::string S2Plugin::Spelunky2::getEntityName(size_t offset, EntityDB* entityDB
     return entityName;
 }
 
-uint32_t S2Plugin::Spelunky2::getEntityTypeID(size_t offset) const
+uint32_t S2Plugin::Spelunky2::getEntityTypeID(size_t offset, EntityDB* entityDB, State* state) const
 {
     if (offset == 0)
     {
         return 0;
     }
-    size_t entityDBPtr = Script::Memory::ReadQword(offset + 8);
-    if (entityDBPtr == 0)
-    {
-        return 0;
-    }
-    return Script::Memory::ReadDword(entityDBPtr + 20);
+    return state->entityHeader(offset, entityDB).typeID;
 }
@@ -0,0 +1,249 @@
+#include "Views/ViewBreakpointCapture.h"
+#include "Data/BreakpointCapture.h"
+#include "Data/State.h"
+#include "QtHelpers/ItemModelCaptureSnapshots.h"
+#include "Spelunky2.h"
+#include "Views/ViewToolbar.h"
+#include "pluginmain.h"
+#include <QCloseEvent>
+#include <QHeaderView>
+#include <QIntValidator>
+
+S2Plugin::ViewBreakpointCapture::ViewBreakpointCapture(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
+{
+    mCapture = std::make_unique<BreakpointCapture>();
+    QObject::connect(mCapture.get(), &BreakpointCapture::snapshotsCaptured, this, &ViewBreakpointCapture::snapshotsCaptured);
+
+    initializeUI();
+    setWindowIcon(QIcon(":/icons/caveman.png"));
+    setWindowTitle("Breakpoint capture");
+    updateStatus();
+}
+
+void S2Plugin::ViewBreakpointCapture::initializeUI()
+{
+    mMainLayout = new QVBoxLayout(this);
+    mMainLayout->setMargin(5);
+    setLayout(mMainLayout);
+
+    // target
+    auto targetLayout = new QHBoxLayout();
+    targetLayout->addWidget(new QLabel("Capture when the game executes", this));
+    mTargetComboBox = new QComboBox(this);
+    mTargetComboBox->addItem("Address");
+    mTargetComboBox->addItem("Statemachine of entity UID");
+    targetLayout->addWidget(mTargetComboBox);
+    mTargetLineEdit = new QLineEdit(this);
+    mTargetLineEdit->setPlaceholderText("Dec or hex starting with 0x");
+    targetLayout->addWidget(mTargetLineEdit);
+    mHardwareCheckBox = new QCheckBox("Hardware breakpoint", this);
+    mHardwareCheckBox->setToolTip("Doesn't modify the game's code, but there are only four of them");
+    targetLayout->addWidget(mHardwareCheckBox);
+    mArmButton = new QPushButton("Arm", this);
+    QObject::connect(mArmButton, &QPushButton::clicked, this, &ViewBreakpointCapture::toggleArmed);
+    targetLayout->addWidget(mArmButton);
+    mMainLayout->addLayout(targetLayout);
+
+    // regions
+    mMainLayout->addWidget(new QLabel("Regions to capture on every hit, one per line: name, address and size. The address can be a number, a State field "
+                                      "(e.g. State.time_level) or 'entity' for the target entity.",
+                                      this));
+    mRegionsEdit = new QPlainTextEdit(this);
+    mRegionsEdit->setFixedHeight(80);
+    mRegionsEdit->setPlaceholderText("level_time State.time_level 4\nentity_start entity 0x50");
+    mMainLayout->addWidget(mRegionsEdit);
+
+    // budget
+    auto budgetLayout = new QHBoxLayout();
+    budgetLayout->addWidget(new QLabel("Stop capturing above", this));
+    mMaxHitsLineEdit = new QLineEdit("1000", this);
+    mMaxHitsLineEdit->setFixedWidth(60);
+    mMaxHitsLineEdit->setValidator(new QIntValidator(1, 100000, this));
+    budgetLayout->addWidget(mMaxHitsLineEdit);
+    budgetLayout->addWidget(new QLabel("hits or", this));
+    mMaxCaptureTimeLineEdit = new QLineEdit("50", this);
+    mMaxCaptureTimeLineEdit->setFixedWidth(50);
+    mMaxCaptureTimeLineEdit->setValidator(new QIntValidator(1, 500, this));
+    budgetLayout->addWidget(mMaxCaptureTimeLineEdit);
+    budgetLayout->addWidget(new QLabel("milliseconds of capturing per second", this));
+    budgetLayout->addStretch();
+    mStatusLabel = new QLabel(this);
+    budgetLayout->addWidget(mStatusLabel);
+    mMainLayout->addLayout(budgetLayout);
+
+    mSnapshotsTableView = new QTableView(this);
+    mSnapshotsTableView->setAlternatingRowColors(true);
+    mSnapshotsTableView->verticalHeader()->setVisible(false);
+    mSnapshotsTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    mSnapshotsTableView->verticalHeader()->setDefaultSectionSize(20);
+    mSnapshotsTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mSnapshotsTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mSnapshotsTableView->horizontalHeader()->setStretchLastSection(true);
+    mModel = new ItemModelCaptureSnapshots(this);
+    mSnapshotsTableView->setModel(mModel);
+    mMainLayout->addWidget(mSnapshotsTableView);
+}
+
+void S2Plugin::ViewBreakpointCapture::closeEvent(QCloseEvent* event)
+{
+    mCapture->disarm();
+    delete this;
+}
+
+QSize S2Plugin::ViewBreakpointCapture::sizeHint() const
+{
+    return QSize(900, 550);
+}
+
+QSize S2Plugin::ViewBreakpointCapture::minimumSizeHint() const
+{
+    return QSize(150, 150);
+}
+
+bool S2Plugin::ViewBreakpointCapture::parseRegions(std::string& error)
+{
+    // the target entity, if any
+    size_t entity = 0;
+    if (mTargetComboBox->currentIndex() == 1)
+    {
+        entity = mToolbar->state()->locateEntityByUID(mTargetLineEdit->text().toUInt(nullptr, 0)).entity;
+    }
+
+    std::vector<CaptureRegion> regions;
+    auto lines = mRegionsEdit->toPlainText().split('\n', QString::SkipEmptyParts);
+    for (const auto& line : lines)
+    {
+        auto parts = line.split(' ', QString::SkipEmptyParts);
+        if (parts.size() != 3)
+        {
+            error = "Expected name, address and size: " + line.toStdString();
+            return false;
+        }
+        CaptureRegion region{parts[0].toStdString(), 0, 0};
+        bool ok = false;
+        if (parts[1] == "entity")
+        {
+            region.address = entity;
+            ok = entity != 0;
+        }
+        else if (parts[1].startsWith("State."))
+        {
+            auto& offsets = mToolbar->state()->offsets();
+            auto it = offsets.find(parts[1].toStdString());
+            ok = it != offsets.end();
+            region.address = ok ? it->second : 0;
+        }
+        else
+        {
+            region.address = parts[1].toULongLong(&ok, 0);
+        }
+        if (!ok || region.address == 0)
+        {
+            error = "Unknown address: " + parts[1].toStdString();
+            return false;
+        }
+        region.size = parts[2].toULongLong(&ok, 0);
+        if (!ok || region.size == 0 || region.size > 0x10000)
+        {
+            error = "The size should be between 1 and 0x10000: " + parts[2].toStdString();
+            return false;
+        }
+        regions.emplace_back(region);
+    }
+    if (regions.empty())
+    {
+        error = "No regions to capture";
+        return false;
+    }
+    mCapture->setRegions(regions);
+    mModel->setRegions(regions);
+    return true;
+}
+
+void S2Plugin::ViewBreakpointCapture::toggleArmed()
+{
+    if (mCapture->isArmed())
+    {
+        mCapture->disarm();
+        updateStatus();
+        return;
+    }
+
+    std::string error;
+    if (!mToolbar->state()->loadState())
+    {
+        mStatusLabel->setText("The State couldn't be loaded");
+        return;
+    }
+    if (!parseRegions(error))
+    {
+        mStatusLabel->setText(QString::fromStdString(error));
+        return;
+    }
+
+    size_t address = 0;
+    std::string captureCondition;
+    if (mTargetComboBox->currentIndex() == 0)
+    {
+        address = mTargetLineEdit->text().toULongLong(nullptr, 0);
+    }
+    else
+    {
+        // the statemachine is shared by every entity of the same class, only capture when it runs for this one
+        auto entity = mToolbar->state()->locateEntityByUID(mTargetLineEdit->text().toUInt(nullptr, 0)).entity;
+        if (entity != 0)
+        {
+            auto vtable = Script::Memory::ReadQword(entity);
+            address = Script::Memory::ReadQword(vtable + (static_cast<size_t>(VIRT_FUNC::ENTITY_STATEMACHINE) * sizeof(size_t)));
+            captureCondition = QString("rcx==0x%1").arg(entity, 0, 16).toStdString();
+        }
+    }
+    if (address == 0)
+    {
+        mStatusLabel->setText("No address to capture at");
+        return;
+    }
+
+    mCapture->setBudget(mMaxHitsLineEdit->text().toUInt(), std::chrono::milliseconds(mMaxCaptureTimeLineEdit->text().toUInt()));
+    if (!mCapture->arm(address, mHardwareCheckBox->checkState() == Qt::Checked, captureCondition, mToolbar->state()->frameCounterAddress(), error))
+    {
+        mStatusLabel->setText(QString::fromStdString(error));
+        return;
+    }
+    updateStatus();
+}
+
+void S2Plugin::ViewBreakpointCapture::snapshotsCaptured()
+{
+    mCapture->takeSnapshots(mReceived);
+    mModel->append(mReceived);
+    if (mCapture->overBudget() && mCapture->isArmed())
+    {
+        // the game would crawl, don't leave the breakpoint in
+        mCapture->disarm();
+    }
+    updateStatus();
+}
+
+void S2Plugin::ViewBreakpointCapture::updateStatus()
+{
+    auto armed = mCapture->isArmed();
+    mArmButton->setText(armed ? "Disarm" : "Arm");
+    mTargetComboBox->setEnabled(!armed);
+    mTargetLineEdit->setEnabled(!armed);
+    mHardwareCheckBox->setEnabled(!armed);
+    mRegionsEdit->setReadOnly(armed);
+
+    auto status = QString("Hits: %1, captured: %2, dropped: %3, %4 hits/s, capture %5 us avg / %6 us max")
+                      .arg(mCapture->hitCount())
+                      .arg(mCapture->captureCount())
+                      .arg(mCapture->droppedCount())
+                      .arg(mCapture->hitsLastSecond())
+                      .arg(mCapture->averageCaptureMicroseconds())
+                      .arg(mCapture->maxCaptureMicroseconds());
+    if (mCapture->overBudget())
+    {
+        status += " - over budget, disarmed";
+    }
+    mStatusLabel->setText(status);
+}
@@ -211,10 +211,12 @@ void S2Plugin::ViewCharacterDB::showIndex(size_t index)
     mLookupIndex = index;
     auto& offsets = mToolbar->characterDB()->offsetsForIndex(mLookupIndex);
     auto deltaReference = offsets.at("CharacterDB.is_female");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::CharacterDB))
     {
         mMainTreeView->updateValueForField(field, "CharacterDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewCharacterDB::label()
@@ -240,10 +242,12 @@ void S2Plugin::ViewCharacterDB::updateFieldValues()
 {
     auto& offsets = mToolbar->characterDB()->offsetsForIndex(mLookupIndex);
     auto deltaReference = offsets.at("CharacterDB.is_female");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::CharacterDB))
     {
         mMainTreeView->updateValueForField(field, "CharacterDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewCharacterDB::compareGroupByCheckBoxClicked(int state)
@@ -0,0 +1,227 @@
+#include "Views/ViewDatabaseExport.h"
+#include "Data/CharacterDB.h"
+#include "Data/DatabaseExporter.h"
+#include "Data/EntityDB.h"
+#include "Data/ParticleDB.h"
+#include "Data/StringsTable.h"
+#include "Data/TextureDB.h"
+#include "Spelunky2.h"
+#include "Views/ViewToolbar.h"
+#include "pluginmain.h"
+#include <QCloseEvent>
+#include <QDateTime>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QGroupBox>
+#include <QLabel>
+#include <QPushButton>
+#include <chrono>
+
+S2Plugin::ViewDatabaseExport::ViewDatabaseExport(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
+{
+    mExporter = std::make_unique<DatabaseExporter>(mToolbar->configuration());
+
+    initializeUI();
+    setWindowIcon(QIcon(":/icons/caveman.png"));
+    setWindowTitle("Export databases");
+}
+
+void S2Plugin::ViewDatabaseExport::initializeUI()
+{
+    mMainLayout = new QVBoxLayout(this);
+    mMainLayout->setMargin(5);
+    setLayout(mMainLayout);
+
+    // export
+    auto exportGroupBox = new QGroupBox("Export", this);
+    auto exportLayout = new QVBoxLayout(exportGroupBox);
+
+    auto databasesLayout = new QHBoxLayout();
+    mEntityDBCheckBox = new QCheckBox("EntityDB", this);
+    mParticleDBCheckBox = new QCheckBox("ParticleDB", this);
+    mTextureDBCheckBox = new QCheckBox("TextureDB", this);
+    mCharacterDBCheckBox = new QCheckBox("CharacterDB", this);
+    for (auto checkBox : {mEntityDBCheckBox, mParticleDBCheckBox, mTextureDBCheckBox, mCharacterDBCheckBox})
+    {
+        checkBox->setCheckState(Qt::Checked);
+        databasesLayout->addWidget(checkBox);
+    }
+    mCSVCheckBox = new QCheckBox("Also write CSV", this);
+    mCSVCheckBox->setCheckState(Qt::Unchecked);
+    databasesLayout->addWidget(mCSVCheckBox);
+    databasesLayout->addStretch();
+    exportLayout->addLayout(databasesLayout);
+
+    auto folderLayout = new QHBoxLayout();
+    folderLayout->addWidget(new QLabel("Folder", this));
+    mFolderLineEdit = new QLineEdit(this);
+    mFolderLineEdit->setText(QDir::homePath());
+    folderLayout->addWidget(mFolderLineEdit);
+    auto browseFolderButton = new QPushButton("Browse", this);
+    QObject::connect(browseFolderButton, &QPushButton::clicked, this, &ViewDatabaseExport::browseFolder);
+    folderLayout->addWidget(browseFolderButton);
+    auto exportButton = new QPushButton("Export", this);
+    QObject::connect(exportButton, &QPushButton::clicked, this, &ViewDatabaseExport::exportDatabases);
+    folderLayout->addWidget(exportButton);
+    exportLayout->addLayout(folderLayout);
+    mMainLayout->addWidget(exportGroupBox);
+
+    // compare
+    auto compareGroupBox = new QGroupBox("Compare two exports", this);
+    auto compareLayout = new QHBoxLayout(compareGroupBox);
+    compareLayout->addWidget(new QLabel("Before", this));
+    mBeforeLineEdit = new QLineEdit(this);
+    compareLayout->addWidget(mBeforeLineEdit);
+    auto browseBeforeButton = new QPushButton("...", this);
+    browseBeforeButton->setFixedWidth(30);
+    QObject::connect(browseBeforeButton, &QPushButton::clicked, this, &ViewDatabaseExport::browseBefore);
+    compareLayout->addWidget(browseBeforeButton);
+    compareLayout->addWidget(new QLabel("After", this));
+    mAfterLineEdit = new QLineEdit(this);
+    compareLayout->addWidget(mAfterLineEdit);
+    auto browseAfterButton = new QPushButton("...", this);
+    browseAfterButton->setFixedWidth(30);
+    QObject::connect(browseAfterButton, &QPushButton::clicked, this, &ViewDatabaseExport::browseAfter);
+    compareLayout->addWidget(browseAfterButton);
+    auto compareButton = new QPushButton("Compare", this);
+    QObject::connect(compareButton, &QPushButton::clicked, this, &ViewDatabaseExport::compareExports);
+    compareLayout->addWidget(compareButton);
+    mMainLayout->addWidget(compareGroupBox);
+
+    mOutput = new QPlainTextEdit(this);
+    mOutput->setReadOnly(true);
+    mOutput->setLineWrapMode(QPlainTextEdit::NoWrap);
+    mOutput->setFont(QFont("Courier", 9));
+    mMainLayout->addWidget(mOutput);
+}
+
+void S2Plugin::ViewDatabaseExport::closeEvent(QCloseEvent* event)
+{
+    delete this;
+}
+
+QSize S2Plugin::ViewDatabaseExport::sizeHint() const
+{
+    return QSize(750, 550);
+}
+
+QSize S2Plugin::ViewDatabaseExport::minimumSizeHint() const
+{
+    return QSize(150, 150);
+}
+
+void S2Plugin::ViewDatabaseExport::browseFolder()
+{
+    auto folder = QFileDialog::getExistingDirectory(this, "Export to", mFolderLineEdit->text());
+    if (!folder.isEmpty())
+    {
+        mFolderLineEdit->setText(folder);
+    }
+}
+
+QString S2Plugin::ViewDatabaseExport::browseExport()
+{
+    return QFileDialog::getOpenFileName(this, "Open export", mFolderLineEdit->text(), "Database exports (*.s2db)");
+}
+
+void S2Plugin::ViewDatabaseExport::browseBefore()
+{
+    auto fileName = browseExport();
+    if (!fileName.isEmpty())
+    {
+        mBeforeLineEdit->setText(fileName);
+    }
+}
+
+void S2Plugin::ViewDatabaseExport::browseAfter()
+{
+    auto fileName = browseExport();
+    if (!fileName.isEmpty())
+    {
+        mAfterLineEdit->setText(fileName);
+    }
+}
+
+void S2Plugin::ViewDatabaseExport::exportDatabases()
+{
+    mOutput->clear();
+    QDir folder(mFolderLineEdit->text());
+    if (!folder.exists())
+    {
+        mOutput->appendPlainText("The folder " + mFolderLineEdit->text() + " doesn't exist");
+        return;
+    }
+    auto timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+
+    auto exportTable = [&](const std::string& tableName, MemoryFieldType entryType, const DatabaseTableLayout& layout)
+    {
+        auto baseName = QString::fromStdString(tableName) + "_" + timestamp;
+        auto path = folder.filePath(baseName + ".s2db");
+        auto csvPath = mCSVCheckBox->checkState() == Qt::Checked ? folder.filePath(baseName + ".csv") : QString();
+
+        auto start = std::chrono::steady_clock::now();
+        std::string error;
+        if (mExporter->exportTable(tableName, entryType, layout, path.toStdString(), csvPath.toStdString(), error))
+        {
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+            mOutput->appendPlainText(QString("%1: %2 entries to %3 in %4 ms").arg(QString::fromStdString(tableName)).arg(layout.entryCount).arg(path).arg(duration.count()));
+        }
+        else
+        {
+            mOutput->appendPlainText(QString::fromStdString(tableName) + ": " + QString::fromStdString(error));
+        }
+    };
+
+    if (mEntityDBCheckBox->checkState() == Qt::Checked)
+    {
+        auto entityDB = mToolbar->entityDB();
+        if (entityDB->loadEntityDB())
+        {
+            exportTable("EntityDB", MemoryFieldType::EntityDB, entityDB->tableLayout());
+        }
+    }
+    if (mParticleDBCheckBox->checkState() == Qt::Checked)
+    {
+        auto particleDB = mToolbar->particleDB();
+        if (particleDB->loadParticleDB())
+        {
+            exportTable("ParticleDB", MemoryFieldType::ParticleDB, particleDB->tableLayout());
+        }
+    }
+    if (mTextureDBCheckBox->checkState() == Qt::Checked)
+    {
+        auto textureDB = mToolbar->textureDB();
+        if (textureDB->loadTextureDB())
+        {
+            exportTable("TextureDB", MemoryFieldType::TextureDB, textureDB->tableLayout());
+        }
+    }
+    if (mCharacterDBCheckBox->checkState() == Qt::Checked)
+    {
+        auto characterDB = mToolbar->characterDB();
+        if (mToolbar->stringsTable()->loadStringsTable() && characterDB->loadCharacters(mToolbar->stringsTable()))
+        {
+            exportTable("CharacterDB", MemoryFieldType::CharacterDB, characterDB->tableLayout());
+        }
+    }
+}
+
+void S2Plugin::ViewDatabaseExport::compareExports()
+{
+    mOutput->clear();
+    DatabaseExport before;
+    DatabaseExport after;
+    std::string error;
+    if (!before.load(mBeforeLineEdit->text().toStdString(), error) || !after.load(mAfterLineEdit->text().toStdString(), error))
+    {
+        mOutput->appendPlainText(QString::fromStdString(error));
+        return;
+    }
+    QStringList lines;
+    for (const auto& line : diffDatabaseExports(before, after))
+    {
+        lines << QString::fromStdString(line);
+    }
+    mOutput->setPlainText(lines.join('\n'));
+}
@@ -3,6 +3,7 @@
 #include "Configuration.h"
 #include "Data/EntityDB.h"
 #include "Data/EntityList.h"
+#include "Data/EntityQuery.h"
 #include "Data/State.h"
 #include "Data/StdMap.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
@@ -13,7 +14,10 @@
 #include <QCloseEvent>
 #include <QHeaderView>
 #include <QLabel>
+#include <QTime>
 #include <QTimer>
+#include <algorithm>
+#include <iterator>
 
 S2Plugin::ViewEntities::ViewEntities(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
 {
@@ -37,17 +41,25 @@ void S2Plugin::ViewEntities::initializeTreeView()
 {
     mMainTreeView = new TreeViewMemoryFields(mToolbar, nullptr, this);
     mMainTreeView->setEnableChangeHighlighting(false);
+    mMainTreeView->setUniformRowHeights(true); // lets the view skip measuring each row of a long entity list
 
     mMainLayout->addWidget(mMainTreeView);
+
+    mEventLog = new QPlainTextEdit(this);
+    mEventLog->setReadOnly(true);
+    mEventLog->setMaximumBlockCount(1000);
+    mEventLog->setFixedHeight(120);
+    mEventLog->setVisible(false);
+    mMainLayout->addWidget(mEventLog);
 }
 
 void S2Plugin::ViewEntities::initializeRefreshAndFilter()
 {
     auto filterLayout = new QGridLayout(this);
 
-    auto refreshButton = new QPushButton("Refresh", this);
-    QObject::connect(refreshButton, &QPushButton::clicked, this, &ViewEntities::refreshEntities);
-    filterLayout->addWidget(refreshButton, 0, 0);
+    mRefreshButton = new QPushButton("Refresh", this);
+    QObject::connect(mRefreshButton, &QPushButton::clicked, this, &ViewEntities::refreshEntities);
+    filterLayout->addWidget(mRefreshButton, 0, 0);
 
     auto label = new QLabel("Filter:", this);
     filterLayout->addWidget(label, 0, 1);
@@ -57,16 +69,50 @@ void S2Plugin::ViewEntities::initializeRefreshAndFilter()
     QObject::connect(mFilterLineEdit, &QLineEdit::textChanged, this, &ViewEntities::refreshEntities);
     filterLayout->addWidget(mFilterLineEdit, 0, 2, 1, 6);
 
+    filterLayout->addWidget(new QLabel("Query:", this), 1, 1);
+    mQueryLineEdit = new QLineEdit(this);
+    mQueryLineEdit->setPlaceholderText("e.g. Movable.health < 3 && distance < 10 && is(Monster) (press enter to apply)");
+    QObject::connect(mQueryLineEdit, &QLineEdit::editingFinished, this, &ViewEntities::queryChanged);
+    filterLayout->addWidget(mQueryLineEdit, 1, 2, 1, 6);
+    mQueryErrorLabel = new QLabel(this);
+    mQueryErrorLabel->setStyleSheet("color: red;");
+    mQueryErrorLabel->setVisible(false);
+    filterLayout->addWidget(mQueryErrorLabel, 2, 2, 1, 6);
+
+    mAutoRefreshTimer = std::make_unique<QTimer>(this);
+    QObject::connect(mAutoRefreshTimer.get(), &QTimer::timeout, this, &ViewEntities::refreshEntities);
+
+    mAutoRefreshCheckBox = new QCheckBox("Auto-refresh every", this);
+    mAutoRefreshCheckBox->setCheckState(Qt::Unchecked);
+    QObject::connect(mAutoRefreshCheckBox, &QCheckBox::clicked, this, &ViewEntities::toggleAutoRefresh);
+    filterLayout->addWidget(mAutoRefreshCheckBox, 3, 2);
+
+    mAutoRefreshIntervalLineEdit = new QLineEdit(this);
+    mAutoRefreshIntervalLineEdit->setFixedWidth(50);
+    mAutoRefreshIntervalLineEdit->setValidator(new QIntValidator(100, 5000, this));
+    mAutoRefreshIntervalLineEdit->setText("100");
+    QObject::connect(mAutoRefreshIntervalLineEdit, &QLineEdit::textChanged, this, &ViewEntities::autoRefreshIntervalChanged);
+    filterLayout->addWidget(mAutoRefreshIntervalLineEdit, 3, 3);
+    filterLayout->addWidget(new QLabel("milliseconds", this), 3, 4);
+
+    mEventLogCheckBox = new QCheckBox("Log spawns/despawns", this);
+    QObject::connect(mEventLogCheckBox, &QCheckBox::stateChanged, this, &ViewEntities::toggleEventLog);
+    filterLayout->addWidget(mEventLogCheckBox, 3, 5);
+
+    mUIDIndexLabel = new QLabel(this);
+    mUIDIndexLabel->setToolTip("UID lookups (the filter, UID fields in the entity windows, ...) share an index that is rebuilt once per game frame");
+    filterLayout->addWidget(mUIDIndexLabel, 3, 6, 1, 3);
+
     mCheckboxLayer0 = new QCheckBox("Front layer (0)", this);
     mCheckboxLayer0->setChecked(true);
     QObject::connect(mCheckboxLayer0, &QCheckBox::stateChanged, this, &ViewEntities::refreshEntities);
-    filterLayout->addWidget(mCheckboxLayer0, 2, 2);
+    filterLayout->addWidget(mCheckboxLayer0, 4, 2);
 
     mCheckboxLayer1 = new QCheckBox("Back layer (0)", this);
     QObject::connect(mCheckboxLayer1, &QCheckBox::stateChanged, this, &ViewEntities::refreshEntities);
-    filterLayout->addWidget(mCheckboxLayer1, 2, 3);
+    filterLayout->addWidget(mCheckboxLayer1, 4, 3);
 
-    int row = 3;
+    int row = 5;
     int col = 2;
     for (auto& checkbox : mCheckbox)
     {
@@ -94,39 +140,33 @@ void S2Plugin::ViewEntities::closeEvent(QCloseEvent* event)
 
 void S2Plugin::ViewEntities::refreshEntities()
 {
-    mMainTreeView->clear();
-    std::unordered_map<std::string, size_t> offsets;
-
-    const auto spel2 = mToolbar->configuration()->spelunky2();
-    const static auto entity_db = mToolbar->entityDB();
+    StateRefreshPass pass(mToolbar->state());
+    auto entityDB = mToolbar->entityDB();
+    auto filterText = mFilterLineEdit->text();
     bool isUIDlookupSuccess = false;
-    uint enteredUID;
-    if (!mFilterLineEdit->text().isEmpty())
+    uint32_t enteredUID = 0;
+    if (!filterText.isEmpty())
     {
-        enteredUID = mFilterLineEdit->text().toUInt(&isUIDlookupSuccess, 0);
+        enteredUID = filterText.toUInt(&isUIDlookupSuccess, 0);
     }
 
-    auto AddEntity = [&](size_t entity_ptr)
+    // the entity lists to show, per layer and mask; each pointer array is read in one go
+    std::map<EntityListKey, std::vector<ListedEntity>> entityLists;
+    auto addPointerArray = [&](const EntityListKey& key, size_t pointers, size_t count)
     {
-        auto entity = Script::Memory::ReadQword(entity_ptr);
-        auto entityUid = Script::Memory::ReadDword(entity + 0x38);
-        QString entityName = QString::fromStdString(spel2->getEntityName(entity, entity_db));
-
-        if (!isUIDlookupSuccess && !mFilterLineEdit->text().isEmpty())
+        auto& list = entityLists[key];
+        std::vector<size_t> entities(count);
+        if (pointers == 0 || count == 0 || !Script::Memory::Read(pointers, entities.data(), count * sizeof(size_t), nullptr))
         {
-            if (!entityName.contains(mFilterLineEdit->text(), Qt::CaseInsensitive))
-                return;
+            return;
+        }
+        list.reserve(list.size() + count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            list.emplace_back(ListedEntity{0, pointers + (i * sizeof(size_t)), entities[i], ""});
         }
-
-        MemoryField field;
-        field.name = "entity_uid_" + std::to_string(entityUid);
-        field.type = MemoryFieldType::EntityPointer;
-        mMainTreeView->addMemoryField(field, field.name);
-        offsets[field.name] = entity_ptr;
-        mMainTreeView->updateValueForField(field, field.name, offsets);
     };
 
-    size_t totalEntities = 0;
     auto layer0 = Script::Memory::ReadQword(mToolbar->state()->offsetForField("layer0"));
     auto layer0Count = Script::Memory::ReadDword(layer0 + 0x1C);
     auto layer1 = Script::Memory::ReadQword(mToolbar->state()->offsetForField("layer1"));
@@ -139,34 +179,10 @@ void S2Plugin::ViewEntities::refreshEntities()
 
     if (isUIDlookupSuccess)
     {
-        // loop thru all entities to find the uid
-        // TODO: change to proper struct when done
-        auto ent_list = Script::Memory::ReadQword(layer0 + 0x8);
-        auto uid_list = Script::Memory::ReadQword(layer0 + 0x10);
-        bool found_uid = false;
-        for (int idx = 0; idx < layer0Count; ++idx)
+        auto location = mToolbar->state()->locateEntityByUID(enteredUID);
+        if (location.entity != 0)
         {
-            auto uid = Script::Memory::ReadDword(uid_list + idx * sizeof(uint32_t));
-            if (enteredUID == uid)
-            {
-                AddEntity(ent_list + idx * sizeof(size_t));
-                found_uid = true;
-                break;
-            }
-        }
-        ent_list = Script::Memory::ReadQword(layer1 + 0x8);
-        uid_list = Script::Memory::ReadQword(layer1 + 0x10);
-        if (found_uid == false)
-        {
-            for (int idx = 0; idx < layer1Count; ++idx)
-            {
-                auto uid = Script::Memory::ReadDword(uid_list + idx * sizeof(uint32_t));
-                if (enteredUID == uid)
-                {
-                    AddEntity(ent_list + idx * sizeof(size_t));
-                    break;
-                }
-            }
+            addPointerArray({location.layer, 0}, location.pointerOffset, 1);
         }
     }
 
@@ -176,6 +192,8 @@ void S2Plugin::ViewEntities::refreshEntities()
     for (auto& checkbox : mCheckbox)
     {
         int field_count = 0;
+        // loop only if uid was not entered and the mask was choosen
+        auto addEntities = !isUIDlookupSuccess && checkbox.mCheckbox->checkState() == Qt::Checked;
 
         if (check_layer0)
         {
@@ -184,17 +202,11 @@ void S2Plugin::ViewEntities::refreshEntities()
             {
                 // TODO: change to proper struct when done
                 auto ent_list = itr.value_ptr();
-                auto pointers = Script::Memory::ReadQword(ent_list);
                 auto list_count = Script::Memory::ReadDword(ent_list + 20);
                 field_count += list_count;
-                // loop only if uid was not entered and the mask was choosen
-                if (!isUIDlookupSuccess && totalEntities < 10000u && checkbox.mCheckbox->checkState() == Qt::Checked)
+                if (addEntities)
                 {
-                    for (size_t i = 0; i < list_count; ++i)
-                    {
-                        AddEntity(pointers + (i * sizeof(size_t)));
-                        ++totalEntities;
-                    }
+                    addPointerArray({0, static_cast<uint32_t>(checkbox.mask)}, Script::Memory::ReadQword(ent_list), list_count);
                 }
             }
         }
@@ -204,32 +216,219 @@ void S2Plugin::ViewEntities::refreshEntities()
             if (itr != map1.end())
             {
                 auto ent_list = itr.value_ptr();
-                auto pointers = Script::Memory::ReadQword(ent_list);
                 auto list_count = Script::Memory::ReadDword(ent_list + 20);
                 field_count += list_count;
-                if (!isUIDlookupSuccess && totalEntities < 10000u && checkbox.mCheckbox->checkState() == Qt::Checked)
+                if (addEntities)
                 {
-                    for (size_t i = 0; i < list_count; ++i)
-                    {
-                        AddEntity(pointers + (i * sizeof(size_t)));
-                        ++totalEntities;
-                    }
+                    addPointerArray({1, static_cast<uint32_t>(checkbox.mask)}, Script::Memory::ReadQword(ent_list), list_count);
                 }
             }
         }
         checkbox.mCheckbox->setText(QString(checkbox.name + " (%1)").arg(field_count));
     }
-    setWindowTitle(QString("%1 Entities").arg(totalEntities));
-
-    mMainTreeView->updateTableHeader();
-    mMainTreeView->setColumnHidden(gsColComparisonValue, true);
-    mMainTreeView->setColumnHidden(gsColComparisonValueHex, true);
-    mMainTreeView->setColumnHidden(gsColMemoryOffsetDelta, true);
-    mMainTreeView->setColumnWidth(gsColField, 145);
-    mMainTreeView->setColumnWidth(gsColValueHex, 125);
-    mMainTreeView->setColumnWidth(gsColMemoryOffset, 125);
-    mMainTreeView->setColumnWidth(gsColType, 100);
-    mMainTreeView->setColumnWidth(gsColValue, 300);
+
+    // the headers come from the state's per-frame cache (one read per entity), the type ids from the cached EntityDB table
+    auto state = mToolbar->state();
+    std::vector<ListedEntity> listed;
+    std::vector<size_t> queryEntities;
+    std::vector<uint8_t> queryLayers;
+    std::vector<uint8_t> queryMatches;
+    for (auto& [key, list] : entityLists)
+    {
+        if (mQuery != nullptr && !mQuery->empty())
+        {
+            queryEntities.clear();
+            for (const auto& listedEntity : list)
+            {
+                queryEntities.emplace_back(listedEntity.entity);
+            }
+            queryLayers.assign(list.size(), key.first);
+            mQuery->evaluate(queryEntities, queryLayers, state, queryMatches);
+        }
+        else
+        {
+            queryMatches.assign(list.size(), 1);
+        }
+
+        for (size_t i = 0; i < list.size(); ++i)
+        {
+            auto& listedEntity = list[i];
+            auto header = state->entityHeader(listedEntity.entity, entityDB);
+            listedEntity.uid = header.uid;
+            if (listedEntity.entity != 0)
+            {
+                auto entityID = header.typeID;
+                listedEntity.name = (entityID > 0 && entityID <= entityDB->entityList()->highestID()) ? entityDB->entityList()->nameForID(entityID) : "UNKNOWN/DEAD ENTITY";
+            }
+
+            if (queryMatches[i] != 0 && (isUIDlookupSuccess || filterText.isEmpty() || QString::fromStdString(listedEntity.name).contains(filterText, Qt::CaseInsensitive)))
+            {
+                listed.emplace_back(listedEntity);
+            }
+        }
+        std::sort(list.begin(), list.end(), [](const ListedEntity& a, const ListedEntity& b) { return a.uid < b.uid; });
+    }
+    std::sort(listed.begin(), listed.end(), [](const ListedEntity& a, const ListedEntity& b) { return a.uid < b.uid; });
+    listed.erase(std::unique(listed.begin(), listed.end(), [](const ListedEntity& a, const ListedEntity& b) { return a.uid == b.uid; }), listed.end());
+
+    if (mEventLogCheckBox->checkState() == Qt::Checked)
+    {
+        logEntityListChanges(entityLists);
+    }
+    mPreviousEntityLists = std::move(entityLists);
+
+    // walk the old and the new rows (both sorted on uid) side by side, and only insert/remove/update what differs,
+    // so the selection and scroll position survive a refresh
+    auto toRow = [](const ListedEntity& e) { return EntityPointerRow{"entity_uid_" + std::to_string(e.uid), e.pointerOffset, e.entity, e.name}; };
+    mMainTreeView->beginBatchUpdate();
+    size_t oldIndex = 0;
+    size_t newIndex = 0;
+    int row = 0;
+    while (oldIndex < mListedEntities.size() || newIndex < listed.size())
+    {
+        if (newIndex == listed.size() || (oldIndex < mListedEntities.size() && mListedEntities[oldIndex].uid < listed[newIndex].uid))
+        {
+            auto firstOldIndex = oldIndex;
+            while (oldIndex < mListedEntities.size() && (newIndex == listed.size() || mListedEntities[oldIndex].uid < listed[newIndex].uid))
+            {
+                ++oldIndex;
+            }
+            mMainTreeView->removeTopLevelRows(row, static_cast<int>(oldIndex - firstOldIndex));
+        }
+        else if (oldIndex == mListedEntities.size() || listed[newIndex].uid < mListedEntities[oldIndex].uid)
+        {
+            std::vector<EntityPointerRow> rows;
+            while (newIndex < listed.size() && (oldIndex == mListedEntities.size() || listed[newIndex].uid < mListedEntities[oldIndex].uid))
+            {
+                rows.emplace_back(toRow(listed[newIndex++]));
+            }
+            mMainTreeView->insertEntityPointerRows(row, rows);
+            row += static_cast<int>(rows.size());
+        }
+        else
+        {
+            const auto& oldEntity = mListedEntities[oldIndex++];
+            const auto& newEntity = listed[newIndex++];
+            if (oldEntity.pointerOffset != newEntity.pointerOffset || oldEntity.entity != newEntity.entity || oldEntity.name != newEntity.name)
+            {
+                mMainTreeView->updateEntityPointerRow(row, toRow(newEntity));
+            }
+            ++row;
+        }
+    }
+    mMainTreeView->endBatchUpdate();
+    mListedEntities = std::move(listed);
+    setWindowTitle(QString("%1 Entities").arg(mListedEntities.size()));
+
+    auto lookups = state->uidLookupCount();
+    mUIDIndexLabel->setText(QString("UID index: %1 lookups, %2% hits, %3 rebuilds")
+                                .arg(lookups)
+                                .arg(lookups == 0 ? 0.0 : 100.0 * state->uidLookupHitCount() / lookups, 0, 'f', 1)
+                                .arg(state->uidIndexBuildCount()));
+
+    if (!mColumnsInitialized && mMainTreeView->model()->columnCount() > 0)
+    {
+        mMainTreeView->updateTableHeader();
+        mMainTreeView->setColumnHidden(gsColComparisonValue, true);
+        mMainTreeView->setColumnHidden(gsColComparisonValueHex, true);
+        mMainTreeView->setColumnHidden(gsColMemoryOffsetDelta, true);
+        mMainTreeView->setColumnWidth(gsColField, 145);
+        mMainTreeView->setColumnWidth(gsColValueHex, 125);
+        mMainTreeView->setColumnWidth(gsColMemoryOffset, 125);
+        mMainTreeView->setColumnWidth(gsColType, 100);
+        mMainTreeView->setColumnWidth(gsColValue, 300);
+        mColumnsInitialized = true;
+    }
+}
+
+void S2Plugin::ViewEntities::logEntityListChanges(const std::map<EntityListKey, std::vector<ListedEntity>>& entityLists)
+{
+    auto byUID = [](const ListedEntity& a, const ListedEntity& b) { return a.uid < b.uid; };
+    auto timestamp = QTime::currentTime().toString("HH:mm:ss.zzz");
+    for (const auto& [key, list] : entityLists)
+    {
+        // lists that weren't shown before (e.g. a mask that just got ticked) didn't spawn anything
+        auto previous = mPreviousEntityLists.find(key);
+        if (previous == mPreviousEntityLists.end())
+        {
+            continue;
+        }
+
+        QString listName = key.first == 0 ? "front layer" : "back layer";
+        for (const auto& checkbox : mCheckbox)
+        {
+            if (static_cast<uint32_t>(checkbox.mask) == key.second)
+            {
+                listName += ", " + checkbox.name;
+            }
+        }
+
+        std::vector<ListedEntity> despawned;
+        std::vector<ListedEntity> spawned;
+        std::set_difference(previous->second.begin(), previous->second.end(), list.begin(), list.end(), std::back_inserter(despawned), byUID);
+        std::set_difference(list.begin(), list.end(), previous->second.begin(), previous->second.end(), std::back_inserter(spawned), byUID);
+        for (const auto& e : despawned)
+        {
+            mEventLog->appendPlainText(QString("%1 - despawned UID %2 %3 (%4)").arg(timestamp).arg(e.uid).arg(QString::fromStdString(e.name)).arg(listName));
+        }
+        for (const auto& e : spawned)
+        {
+            mEventLog->appendPlainText(QString("%1 + spawned UID %2 %3 (%4)").arg(timestamp).arg(e.uid).arg(QString::fromStdString(e.name)).arg(listName));
+        }
+    }
+}
+
+void S2Plugin::ViewEntities::queryChanged()
+{
+    auto text = mQueryLineEdit->text().toStdString();
+    if (text == mQueryText)
+    {
+        return;
+    }
+    mQueryText = text;
+
+    if (mQuery == nullptr)
+    {
+        mQuery = std::make_unique<EntityQuery>(mToolbar->configuration(), mToolbar->entityDB());
+    }
+    if (mQuery->compile(text))
+    {
+        mQueryErrorLabel->setVisible(false);
+    }
+    else
+    {
+        mQueryErrorLabel->setText(QString::fromStdString(mQuery->error()) + " (no entities are shown until the query is fixed)");
+        mQueryErrorLabel->setVisible(true);
+    }
+    refreshEntities();
+}
+
+void S2Plugin::ViewEntities::toggleAutoRefresh(int newState)
+{
+    if (newState == Qt::Unchecked)
+    {
+        mAutoRefreshTimer->stop();
+        mRefreshButton->setEnabled(true);
+    }
+    else
+    {
+        mAutoRefreshTimer->setInterval(mAutoRefreshIntervalLineEdit->text().toUInt());
+        mAutoRefreshTimer->start();
+        mRefreshButton->setEnabled(false);
+    }
+}
+
+void S2Plugin::ViewEntities::autoRefreshIntervalChanged(const QString& text)
+{
+    if (mAutoRefreshCheckBox->checkState() == Qt::Checked)
+    {
+        mAutoRefreshTimer->setInterval(mAutoRefreshIntervalLineEdit->text().toUInt());
+    }
+}
+
+void S2Plugin::ViewEntities::toggleEventLog(int newState)
+{
+    mEventLog->setVisible(newState == Qt::Checked);
 }
 
 QSize S2Plugin::ViewEntities::sizeHint() const
@@ -3,13 +3,16 @@
 #include "Data/CPPGenerator.h"
 #include "Data/Entity.h"
 #include "Data/EntityDB.h"
+#include "Data/EntityHeatmap.h"
 #include "Data/EntityList.h"
+#include "Data/FrameClock.h"
 #include "Data/State.h"
 #include "QtHelpers/CPPSyntaxHighlighter.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
 #include "QtHelpers/WidgetMemoryView.h"
 #include "QtHelpers/WidgetSpelunkyLevel.h"
 #include "Spelunky2.h"
+#include "Views/ViewEntities.h"
 #include "Views/ViewToolbar.h"
 #include "pluginmain.h"
 #include <QCloseEvent>
@@ -17,6 +20,29 @@
 #include <QHeaderView>
 #include <QLabel>
 #include <string>
+#include <utility>
+
+namespace
+{
+    // the heatmap layers besides "all entities" and "this entity's type", in the order of the layer combo box
+    const std::pair<const char*, S2Plugin::MASK> gsHeatmapMasks[] = {
+        {"PLAYER", S2Plugin::MASK::PLAYER},
+        {"MOUNT", S2Plugin::MASK::MOUNT},
+        {"MONSTER", S2Plugin::MASK::MONSTER},
+        {"ITEM", S2Plugin::MASK::ITEM},
+        {"EXPLOSION", S2Plugin::MASK::EXPLOSION},
+        {"ROPE", S2Plugin::MASK::ROPE},
+        {"FX", S2Plugin::MASK::FX},
+        {"ACTIVEFLOOR", S2Plugin::MASK::ACTIVEFLOOR},
+        {"FLOOR", S2Plugin::MASK::FLOOR},
+        {"DECORATION", S2Plugin::MASK::DECORATION},
+        {"BG", S2Plugin::MASK::BG},
+        {"SHADOW", S2Plugin::MASK::SHADOW},
+        {"LOGICAL", S2Plugin::MASK::LOGICAL},
+        {"WATER", S2Plugin::MASK::WATER},
+        {"LAVA", S2Plugin::MASK::LAVA},
+    };
+} // namespace
 
 S2Plugin::ViewEntity::ViewEntity(size_t entityOffset, ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
 {
@@ -25,14 +51,14 @@ S2Plugin::ViewEntity::ViewEntity(size_t entityOffset, ViewToolbar* toolbar, QWid
     initializeUI();
     setWindowIcon(QIcon(":/icons/caveman.png"));
 
-    mEntity = std::make_unique<Entity>(entityOffset, mMainTreeView, mMemoryView, mMemoryComparisonView, mToolbar->entityDB(), mToolbar->configuration());
+    mEntity = std::make_unique<Entity>(entityOffset, mMainTreeView, mMemoryView, mMemoryComparisonView, mToolbar->entityDB(), mToolbar->state(), mToolbar->configuration());
     mMainTreeView->setMemoryMappedData(mEntity.get());
     mEntity->populateTreeView();
 
     mMainLayout->setMargin(5);
     setLayout(mMainLayout);
 
-    setWindowTitle(QString::asprintf("Entity %s 0x%016llX", mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, toolbar->entityDB()).c_str(), entityOffset));
+    setWindowTitle(QString::asprintf("Entity %s 0x%016llX", mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, toolbar->entityDB(), toolbar->state()).c_str(), entityOffset));
     mMainTreeView->setVisible(true);
 
     mEntity->refreshOffsets();
@@ -156,12 +182,38 @@ void S2Plugin::ViewEntity::initializeUI()
     mMemoryComparisonScrollArea->setVisible(false);
 
     // TAB LEVEL
+    auto heatmapLayout = new QHBoxLayout();
+    mHeatmapCheckBox = new QCheckBox("Heatmap", mTabLevel);
+    mHeatmapCheckBox->setToolTip("Accumulates where the entities were on every game frame, while checked");
+    heatmapLayout->addWidget(mHeatmapCheckBox);
+    QObject::connect(mHeatmapCheckBox, &QCheckBox::clicked, this, &ViewEntity::toggleHeatmap);
+    mHeatmapLayerComboBox = new QComboBox(mTabLevel);
+    mHeatmapLayerComboBox->addItem("All entities");
+    mHeatmapLayerComboBox->addItem("Entities of this type");
+    for (const auto& [name, mask] : gsHeatmapMasks)
+    {
+        mHeatmapLayerComboBox->addItem(QString("Mask ") + name);
+    }
+    heatmapLayout->addWidget(mHeatmapLayerComboBox);
+    QObject::connect(mHeatmapLayerComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewEntity::heatmapLayerChanged);
+    auto clearHeatmapButton = new QPushButton("Clear", mTabLevel);
+    heatmapLayout->addWidget(clearHeatmapButton);
+    QObject::connect(clearHeatmapButton, &QPushButton::clicked, this, &ViewEntity::clearHeatmap);
+    mHeatmapStatusLabel = new QLabel(mTabLevel);
+    heatmapLayout->addWidget(mHeatmapStatusLabel);
+    heatmapLayout->addStretch();
+    dynamic_cast<QVBoxLayout*>(mTabLevel->layout())->addLayout(heatmapLayout);
+
     scroll = new QScrollArea(mTabLevel);
-    mSpelunkyLevel = new WidgetSpelunkyLevel(scroll);
+    mSpelunkyLevel = new WidgetSpelunkyLevel(mToolbar, scroll);
     scroll->setStyleSheet("background-color: #fff;");
     scroll->setWidget(mSpelunkyLevel);
     scroll->setVisible(true);
     mTabLevel->layout()->addWidget(scroll);
+    QObject::connect(mSpelunkyLevel, &WidgetSpelunkyLevel::entitySelected, this, &ViewEntity::levelEntitySelected);
+    QObject::connect(mSpelunkyLevel, &WidgetSpelunkyLevel::entityActivated, mToolbar, &ViewToolbar::showEntity);
+    mLevelSelectionLabel = new QLabel("Click an entity on the map to select it, double click to open it", mTabLevel);
+    mTabLevel->layout()->addWidget(mLevelSelectionLabel);
 
     // TAB CPP
     mCPPTextEdit = new QTextEdit(this);
@@ -185,11 +237,16 @@ void S2Plugin::ViewEntity::initializeUI()
 
 void S2Plugin::ViewEntity::closeEvent(QCloseEvent* event)
 {
+    if (mHeatmapCheckBox->checkState() == Qt::Checked)
+    {
+        mToolbar->frameClock()->unsubscribe();
+    }
     delete this;
 }
 
 void S2Plugin::ViewEntity::refreshEntity()
 {
+    StateRefreshPass pass(mToolbar->state());
     mEntity->refreshValues();
     mMainTreeView->updateTableHeader(false);
     if (mMainTabWidget->currentWidget() == mTabMemory)
@@ -303,6 +360,18 @@ void S2Plugin::ViewEntity::updateLevel()
     mSpelunkyLevel->update();
 }
 
+void S2Plugin::ViewEntity::levelEntitySelected(size_t entityOffset)
+{
+    if (entityOffset == 0)
+    {
+        mLevelSelectionLabel->setText("Click an entity on the map to select it, double click to open it");
+        return;
+    }
+    auto header = mToolbar->state()->entityHeader(entityOffset, mToolbar->entityDB());
+    auto name = mToolbar->configuration()->spelunky2()->getEntityName(entityOffset, mToolbar->entityDB(), mToolbar->state());
+    mLevelSelectionLabel->setText(QString::asprintf("Selected: %s (UID %u) at 0x%016llX", name.c_str(), header.uid, entityOffset));
+}
+
 void S2Plugin::ViewEntity::label()
 {
     mEntity->label();
@@ -338,3 +407,76 @@ S2Plugin::Entity* S2Plugin::ViewEntity::entity() const
 {
     return mEntity.get();
 }
+
+void S2Plugin::ViewEntity::toggleHeatmap(bool checked)
+{
+    auto frameClock = mToolbar->frameClock();
+    if (!checked)
+    {
+        QObject::disconnect(frameClock, &FrameClock::frameAdvanced, this, &ViewEntity::heatmapFrameAdvanced);
+        frameClock->unsubscribe();
+        mHeatmap->stop(); // keeps the counts, so the heatmap stays visible
+        return;
+    }
+    if (!frameClock->subscribe())
+    {
+        mHeatmapCheckBox->setCheckState(Qt::Unchecked);
+        return;
+    }
+
+    // all layers accumulate at once, the combo box only picks the one that's shown
+    std::vector<HeatmapLayer> layers;
+    layers.emplace_back(HeatmapLayer{HeatmapLayerKind::All, 0});
+    layers.emplace_back(HeatmapLayer{HeatmapLayerKind::TypeID, mToolbar->state()->entityHeader(mEntity->memoryOffset(), mToolbar->entityDB()).typeID});
+    for (const auto& [name, mask] : gsHeatmapMasks)
+    {
+        layers.emplace_back(HeatmapLayer{HeatmapLayerKind::Mask, static_cast<uint32_t>(mask)});
+    }
+    if (mHeatmap == nullptr)
+    {
+        mHeatmap = std::make_unique<EntityHeatmap>();
+    }
+    mHeatmap->start(mToolbar->state()->offsetForField(mEntity->cameraLayer() == 1 ? "layer1" : "layer0"), layers);
+    mSpelunkyLevel->setHeatmap(mHeatmap.get(), mHeatmapLayerComboBox->currentIndex());
+    QObject::connect(frameClock, &FrameClock::frameAdvanced, this, &ViewEntity::heatmapFrameAdvanced);
+}
+
+void S2Plugin::ViewEntity::heatmapLayerChanged(int index)
+{
+    if (mHeatmap != nullptr)
+    {
+        mSpelunkyLevel->setHeatmap(mHeatmap.get(), index);
+        mHeatmap->markAllChanged(index);
+        mSpelunkyLevel->updateHeatmap();
+    }
+}
+
+void S2Plugin::ViewEntity::clearHeatmap()
+{
+    if (mHeatmap != nullptr)
+    {
+        mHeatmap->clear();
+        mSpelunkyLevel->updateHeatmap();
+        mHeatmapStatusLabel->clear();
+    }
+}
+
+void S2Plugin::ViewEntity::heatmapFrameAdvanced(uint32_t frame)
+{
+    mHeatmap->frameAdvanced();
+    if (mMainTabWidget->currentWidget() == mTabLevel)
+    {
+        mSpelunkyLevel->updateHeatmap();
+    }
+    if (frame % 30 == 0)
+    {
+        auto status = QString::asprintf("%llu frames, %zu entities in %u reads, %lld us per frame, %llu frames missed", mHeatmap->accumulatedFrameCount(),
+                                        mHeatmap->lastEntityCount(), mHeatmap->lastReadCount(), static_cast<long long>(mHeatmap->lastAccumulationDuration().count()),
+                                        mHeatmap->missedFrameCount());
+        if (mHeatmap->lastFailedSpanCount() != 0)
+        {
+            status += QString::asprintf(", %u spans read per entity, %u entities unreadable", mHeatmap->lastFailedSpanCount(), mHeatmap->lastUnreadableEntityCount());
+        }
+        mHeatmapStatusLabel->setText(status);
+    }
+}
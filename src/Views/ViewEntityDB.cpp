@@ -1,11 +1,11 @@
 #include "Views/ViewEntityDB.h"
 #include "Configuration.h"
 #include "Data/EntityDB.h"
+#include "Data/EntityDBComparison.h"
 #include "Data/EntityList.h"
+#include "QtHelpers/ItemModelEntityDBComparison.h"
 #include "QtHelpers/StyledItemDelegateHTML.h"
-#include "QtHelpers/TableWidgetItemNumeric.h"
 #include "QtHelpers/TreeViewMemoryFields.h"
-#include "QtHelpers/TreeWidgetItemNumeric.h"
 #include "Spelunky2.h"
 #include "Views/ViewToolbar.h"
 #include "pluginmain.h"
@@ -13,7 +13,6 @@
 #include <QHeaderView>
 #include <QLineEdit>
 #include <QPushButton>
-#include <QTreeWidgetItem>
 
 struct ComparisonField
 {
@@ -105,32 +104,42 @@ void S2Plugin::ViewEntityDB::initializeUI()
 
         dynamic_cast<QVBoxLayout*>(mTabCompare->layout())->addLayout(topLayout);
 
-        mCompareTableWidget = new QTableWidget(mToolbar->entityDB()->entityList()->count(), 3, this);
-        mCompareTableWidget->setAlternatingRowColors(true);
-        mCompareTableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-        mCompareTableWidget->setHorizontalHeaderLabels(QStringList() << "ID"
-                                                                     << "Name"
-                                                                     << "Value");
-        mCompareTableWidget->verticalHeader()->setVisible(false);
-        mCompareTableWidget->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
-        mCompareTableWidget->verticalHeader()->setDefaultSectionSize(20);
-        mCompareTableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-        mCompareTableWidget->setColumnWidth(0, 40);
-        mCompareTableWidget->setColumnWidth(1, 325);
-        mCompareTableWidget->setColumnWidth(2, 150);
+        mComparison = std::make_unique<EntityDBComparison>(mToolbar->entityDB());
         mHTMLDelegate = std::make_unique<StyledItemDelegateHTML>();
-        mCompareTableWidget->setItemDelegate(mHTMLDelegate.get());
-        QObject::connect(mCompareTableWidget, &QTableWidget::cellClicked, this, &ViewEntityDB::comparisonCellClicked);
-
-        mCompareTreeWidget = new QTreeWidget(this);
-        mCompareTreeWidget->setAlternatingRowColors(true);
-        mCompareTreeWidget->headerItem()->setHidden(true);
-        mCompareTreeWidget->setHidden(true);
-        mCompareTreeWidget->setItemDelegate(mHTMLDelegate.get());
-        QObject::connect(mCompareTreeWidget, &QTreeWidget::itemClicked, this, &ViewEntityDB::groupedComparisonItemClicked);
-
-        mTabCompare->layout()->addWidget(mCompareTableWidget);
-        mTabCompare->layout()->addWidget(mCompareTreeWidget);
+
+        mCompareTableView = new QTableView(this);
+        mCompareTableView->setAlternatingRowColors(true);
+        mCompareTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+        mCompareTableView->verticalHeader()->setVisible(false);
+        mCompareTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        mCompareTableView->verticalHeader()->setDefaultSectionSize(20);
+        mCompareTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        mCompareTableModel = new ItemModelEntityDBComparison(mToolbar->entityDB(), mComparison.get(), false, this);
+        mCompareTableProxy = new QSortFilterProxyModel(this);
+        mCompareTableProxy->setSourceModel(mCompareTableModel);
+        mCompareTableProxy->setSortRole(gsRoleRawValue);
+        mCompareTableView->setModel(mCompareTableProxy);
+        mCompareTableView->setSortingEnabled(true);
+        mCompareTableView->sortByColumn(gsColEntityDBComparisonID, Qt::AscendingOrder);
+        mCompareTableView->setColumnWidth(gsColEntityDBComparisonID, 40);
+        mCompareTableView->setColumnWidth(gsColEntityDBComparisonName, 325);
+        mCompareTableView->setColumnWidth(gsColEntityDBComparisonValue, 150);
+        mCompareTableView->setItemDelegateForColumn(gsColEntityDBComparisonName, mHTMLDelegate.get());
+        QObject::connect(mCompareTableView, &QTableView::clicked, this, &ViewEntityDB::comparisonCellClicked);
+
+        mCompareTreeView = new QTreeView(this);
+        mCompareTreeView->setAlternatingRowColors(true);
+        mCompareTreeView->setHeaderHidden(true);
+        mCompareTreeView->setHidden(true);
+        mCompareTreeView->setUniformRowHeights(true);
+        mCompareTreeView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        mCompareTreeView->setItemDelegate(mHTMLDelegate.get());
+        mCompareTreeModel = new ItemModelEntityDBComparison(mToolbar->entityDB(), mComparison.get(), true, this);
+        mCompareTreeView->setModel(mCompareTreeModel);
+        QObject::connect(mCompareTreeView, &QTreeView::clicked, this, &ViewEntityDB::groupedComparisonItemClicked);
+
+        mTabCompare->layout()->addWidget(mCompareTableView);
+        mTabCompare->layout()->addWidget(mCompareTreeView);
     }
 
     mSearchLineEdit->setVisible(true);
@@ -183,10 +192,12 @@ void S2Plugin::ViewEntityDB::showIndex(size_t index)
     mLookupIndex = index;
     auto& offsets = mToolbar->entityDB()->offsetsForIndex(index);
     auto deltaReference = offsets.at("EntityDB.create_func");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::EntityDB))
     {
         mMainTreeView->updateValueForField(field, "EntityDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
     mMainTreeView->setColumnWidth(gsColField, 125);
     mMainTreeView->setColumnWidth(gsColValueHex, 125);
     mMainTreeView->setColumnWidth(gsColMemoryOffset, 125);
@@ -207,6 +218,7 @@ void S2Plugin::ViewEntityDB::label()
 void S2Plugin::ViewEntityDB::fieldUpdated(const QString& fieldName)
 {
     updateFieldValues();
+    mComparison->invalidate();
 }
 
 void S2Plugin::ViewEntityDB::fieldExpanded(const QModelIndex& index)
@@ -218,31 +230,46 @@ void S2Plugin::ViewEntityDB::updateFieldValues()
 {
     auto& offsets = mToolbar->entityDB()->offsetsForIndex(mLookupIndex);
     auto deltaReference = offsets.at("EntityDB.create_func");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::EntityDB))
     {
         mMainTreeView->updateValueForField(field, "EntityDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewEntityDB::compareGroupByCheckBoxClicked(int state)
 {
-    mCompareTableWidget->setHidden(state == Qt::Checked);
-    mCompareTreeWidget->setHidden(state == Qt::Unchecked);
+    mCompareTableView->setHidden(state == Qt::Checked);
+    mCompareTreeView->setHidden(state == Qt::Unchecked);
 }
 
 void S2Plugin::ViewEntityDB::comparisonFieldChosen(const QString& fieldName)
 {
-    mCompareTableWidget->clearContents();
-    mCompareTreeWidget->clear();
-
     auto comboIndex = mCompareFieldComboBox->currentIndex();
     if (comboIndex == 0)
     {
-        return;
+        mComparison->clear();
     }
-
-    populateComparisonTableWidget();
-    populateComparisonTreeWidget();
+    else
+    {
+        auto tmp = mCompareFieldComboBox->currentData().value<ComparisonField>();
+        auto entityDB = mToolbar->entityDB();
+        auto offset = entityDB->offsetInEntry("EntityDB." + tmp.prefix + tmp.field.name);
+        if (tmp.field.type == MemoryFieldType::Flag)
+        {
+            // the comment holds the number of bits of the flags field
+            mComparison->setField(offset, std::stoul(tmp.field.comment) / 8, MemoryFieldType::Flag, static_cast<int8_t>(tmp.field.extraInfo));
+        }
+        else
+        {
+            std::unordered_map<std::string, size_t> offsetsDummy;
+            auto size = entityDB->setOffsetForField(tmp.field, "dummy", 0, offsetsDummy);
+            mComparison->setField(offset, size, tmp.field.type);
+        }
+    }
+    mCompareTableModel->reset();
+    mCompareTreeModel->reset();
 }
 
 void S2Plugin::ViewEntityDB::populateComparisonCombobox(const std::string& prefix, const std::vector<S2Plugin::MemoryField>& fields)
@@ -258,7 +285,10 @@ void S2Plugin::ViewEntityDB::populateComparisonCombobox(const std::string& prefi
             case MemoryFieldType::Flags16:
             case MemoryFieldType::Flags8:
             {
-                mCompareFieldComboBox->addItem(QString::fromStdString(field.name), QVariant::fromValue(field));
+                ComparisonField flagsField;
+                flagsField.prefix = prefix;
+                flagsField.field = field;
+                mCompareFieldComboBox->addItem(QString::fromStdString(prefix + field.name), QVariant::fromValue(flagsField));
                 uint8_t flagCount = (field.type == MemoryFieldType::Flags16 ? 16 : (field.type == MemoryFieldType::Flags8 ? 8 : 32));
                 for (uint8_t x = 1; x <= flagCount; ++x)
                 {
@@ -282,6 +312,10 @@ void S2Plugin::ViewEntityDB::populateComparisonCombobox(const std::string& prefi
             }
             default:
             {
+                if (!MemoryMappedData::isScalarType(field.type))
+                {
+                    continue;
+                }
                 ComparisonField tmp;
                 tmp.prefix = prefix;
                 tmp.field = field;
@@ -292,205 +326,19 @@ void S2Plugin::ViewEntityDB::populateComparisonCombobox(const std::string& prefi
     }
 }
 
-void S2Plugin::ViewEntityDB::populateComparisonTableWidget()
-{
-    mCompareTableWidget->setSortingEnabled(false);
-
-    auto tmp = mCompareFieldComboBox->currentData().value<ComparisonField>();
-    const auto& field = tmp.field;
-    const auto& prefix = tmp.prefix;
-
-    auto entityDB = mToolbar->entityDB();
-    auto entityList = entityDB->entityList();
-
-    size_t row = 0;
-    for (auto x = 1; x <= entityDB->entityList()->highestID(); ++x)
-    {
-        if (!entityList->isValidID(x))
-        {
-            continue;
-        }
-
-        auto item0 = new QTableWidgetItem(QString::asprintf("%03d", x));
-        item0->setTextAlignment(Qt::AlignCenter);
-        mCompareTableWidget->setItem(row, 0, item0);
-        mCompareTableWidget->setItem(row, 1, new QTableWidgetItem(QString("<font color='blue'><u>%1</u></font>").arg(QString::fromStdString(entityList->nameForID(x)))));
-
-        auto [caption, value] = valueForField(prefix, field, x);
-        auto item = new TableWidgetItemNumeric(caption);
-        item->setData(Qt::UserRole, value);
-        mCompareTableWidget->setItem(row, 2, item);
-
-        row++;
-    }
-    mCompareTableWidget->setSortingEnabled(true);
-    mCompareTableWidget->sortItems(0);
-}
-
-void S2Plugin::ViewEntityDB::populateComparisonTreeWidget()
-{
-    mCompareTreeWidget->setSortingEnabled(false);
-
-    auto tmp = mCompareFieldComboBox->currentData().value<ComparisonField>();
-    const auto& field = tmp.field;
-    const auto& prefix = tmp.prefix;
-
-    auto entityDB = mToolbar->entityDB();
-    auto entityList = entityDB->entityList();
-
-    std::unordered_map<std::string, QVariant> rootValues;
-    std::unordered_map<std::string, std::unordered_set<uint32_t>> groupedValues; // valueString -> set<entity id's>
-    for (uint32_t x = 1; x <= entityDB->entityList()->highestID(); ++x)
-    {
-        if (!entityList->isValidID(x))
-        {
-            continue;
-        }
-
-        auto [caption, value] = valueForField(prefix, field, x);
-        auto captionStr = caption.toStdString();
-        rootValues[captionStr] = value;
-
-        if (groupedValues.count(captionStr) == 0)
-        {
-            groupedValues[captionStr] = {x};
-        }
-        else
-        {
-            groupedValues[captionStr].insert(x);
-        }
-    }
-
-    for (const auto& [groupString, entityIds] : groupedValues)
-    {
-        auto rootItem = new TreeWidgetItemNumeric(nullptr, QString::fromStdString(groupString));
-        rootItem->setData(0, Qt::UserRole, rootValues.at(groupString));
-        mCompareTreeWidget->insertTopLevelItem(0, rootItem);
-        for (const auto& entityId : entityIds)
-        {
-            auto entityName = entityList->nameForID(entityId);
-            auto caption = QString("<font color='blue'><u>%1</u></font>").arg(QString::fromStdString(entityName));
-            auto childItem = new QTreeWidgetItem(rootItem, QStringList(caption));
-            childItem->setData(0, Qt::UserRole, entityId);
-            mCompareTreeWidget->insertTopLevelItem(0, childItem);
-        }
-    }
-
-    mCompareTreeWidget->setSortingEnabled(true);
-    mCompareTreeWidget->sortItems(0, Qt::AscendingOrder);
-}
-
-std::pair<QString, QVariant> S2Plugin::ViewEntityDB::valueForField(const std::string& prefix, const MemoryField& field, size_t entityDBIndex)
-{
-    auto offset = mToolbar->entityDB()->offsetsForIndex(entityDBIndex).at("EntityDB." + prefix + field.name);
-    switch (field.type)
-    {
-        case MemoryFieldType::CodePointer:
-        case MemoryFieldType::DataPointer:
-        {
-            size_t value = Script::Memory::ReadQword(offset);
-            return std::make_pair(QString::asprintf("0x%016llX", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Byte:
-        case MemoryFieldType::State8:
-        case MemoryFieldType::CharacterDBID:
-        {
-            int8_t value = Script::Memory::ReadByte(offset);
-            return std::make_pair(QString::asprintf("%d", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::UnsignedByte:
-        case MemoryFieldType::Flags8:
-        {
-            uint8_t value = Script::Memory::ReadByte(offset);
-            return std::make_pair(QString::asprintf("%u", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Word:
-        case MemoryFieldType::State16:
-        {
-            int16_t value = Script::Memory::ReadWord(offset);
-            return std::make_pair(QString::asprintf("%d", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::UnsignedWord:
-        case MemoryFieldType::Flags16:
-        {
-            uint16_t value = Script::Memory::ReadWord(offset);
-            return std::make_pair(QString::asprintf("%u", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Dword:
-        case MemoryFieldType::State32:
-        case MemoryFieldType::TextureDBID:
-        {
-            int32_t value = Script::Memory::ReadDword(offset);
-            return std::make_pair(QString::asprintf("%ld", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::ParticleDBID:
-        case MemoryFieldType::EntityDBID:
-        case MemoryFieldType::StringsTableID:
-        case MemoryFieldType::UnsignedDword:
-        case MemoryFieldType::Flags32:
-        {
-            uint32_t value = Script::Memory::ReadDword(offset);
-            return std::make_pair(QString::asprintf("%lu", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Qword:
-        {
-            int64_t value = Script::Memory::ReadQword(offset);
-            return std::make_pair(QString::asprintf("%lld", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::UnsignedQword:
-        {
-            uint64_t value = Script::Memory::ReadQword(offset);
-            return std::make_pair(QString::asprintf("%llu", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Float:
-        {
-            uint32_t dword = Script::Memory::ReadDword(offset);
-            float value = reinterpret_cast<float&>(dword);
-            return std::make_pair(QString::asprintf("%f", value), QVariant::fromValue(value));
-        }
-        case MemoryFieldType::Bool:
-        {
-            auto b = Script::Memory::ReadByte(offset);
-            bool value = reinterpret_cast<bool&>(b);
-            return std::make_pair(value ? "True" : "False", QVariant::fromValue(b));
-        }
-        case MemoryFieldType::Flag:
-        {
-            uint8_t flagToCheck = field.extraInfo;
-            bool isFlagSet = false;
-            if (field.comment == "32")
-            {
-                isFlagSet = ((Script::Memory::ReadDword(offset) & (1 << flagToCheck)) > 0);
-            }
-            else if (field.comment == "16")
-            {
-                isFlagSet = ((Script::Memory::ReadWord(offset) & (1 << flagToCheck)) > 0);
-            }
-            else if (field.comment == "8")
-            {
-                isFlagSet = ((Script::Memory::ReadByte(offset) & (1 << flagToCheck)) > 0);
-            }
-
-            bool value = reinterpret_cast<bool&>(isFlagSet);
-            return std::make_pair(value ? "True" : "False", QVariant::fromValue(isFlagSet));
-        }
-    }
-    return std::make_pair("unknown", 0);
-}
-
-void S2Plugin::ViewEntityDB::comparisonCellClicked(int row, int column)
+void S2Plugin::ViewEntityDB::comparisonCellClicked(const QModelIndex& index)
 {
-    if (column == 1)
+    if (index.column() == gsColEntityDBComparisonName)
     {
-        auto clickedID = mCompareTableWidget->item(row, 0)->data(Qt::DisplayRole).toULongLong();
-        showIndex(clickedID);
+        showIndex(mCompareTableModel->entityIDForIndex(mCompareTableProxy->mapToSource(index)));
     }
 }
 
-void S2Plugin::ViewEntityDB::groupedComparisonItemClicked(QTreeWidgetItem* item, int column)
+void S2Plugin::ViewEntityDB::groupedComparisonItemClicked(const QModelIndex& index)
 {
-    if (item->childCount() == 0)
+    auto id = mCompareTreeModel->entityIDForIndex(index);
+    if (id != 0)
     {
-        showIndex(item->data(0, Qt::UserRole).toUInt());
+        showIndex(id);
     }
 }
@@ -0,0 +1,283 @@
+#include "Views/ViewEntityGrid.h"
+#include "Configuration.h"
+#include "Data/EntityDB.h"
+#include "Data/EntityGrid.h"
+#include "Data/State.h"
+#include "QtHelpers/ItemModelEntityGrid.h"
+#include "Spelunky2.h"
+#include "Views/ViewEntities.h"
+#include "Views/ViewToolbar.h"
+#include "pluginmain.h"
+#include <QCloseEvent>
+#include <QHeaderView>
+#include <QLabel>
+#include <algorithm>
+
+S2Plugin::ViewEntityGrid::ViewEntityGrid(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
+{
+    mEntityGrid = std::make_unique<EntityGrid>(mToolbar->configuration(), mToolbar->state(), mToolbar->entityDB());
+
+    initializeUI();
+    setWindowIcon(QIcon(":/icons/caveman.png"));
+    setWindowTitle("Entity grid");
+
+    entityClassChanged(mEntityClassComboBox->currentText());
+    sourceChanged();
+}
+
+void S2Plugin::ViewEntityGrid::initializeUI()
+{
+    mMainLayout = new QVBoxLayout(this);
+    mMainLayout->setMargin(5);
+    setLayout(mMainLayout);
+
+    // rows
+    auto sourceLayout = new QHBoxLayout();
+    sourceLayout->addWidget(new QLabel("Entities from", this));
+    mLayerComboBox = new QComboBox(this);
+    mLayerComboBox->addItem("Front layer", static_cast<int>(EntityGridLayer::Front));
+    mLayerComboBox->addItem("Back layer", static_cast<int>(EntityGridLayer::Back));
+    mLayerComboBox->addItem("Both layers", static_cast<int>(EntityGridLayer::Both));
+    QObject::connect(mLayerComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewEntityGrid::sourceChanged);
+    sourceLayout->addWidget(mLayerComboBox);
+
+    sourceLayout->addWidget(new QLabel("Mask", this));
+    mMaskComboBox = new QComboBox(this);
+    mMaskComboBox->addItem("All", 0u);
+    mMaskComboBox->addItem("PLAYER", static_cast<uint32_t>(MASK::PLAYER));
+    mMaskComboBox->addItem("MOUNT", static_cast<uint32_t>(MASK::MOUNT));
+    mMaskComboBox->addItem("MONSTER", static_cast<uint32_t>(MASK::MONSTER));
+    mMaskComboBox->addItem("ITEM", static_cast<uint32_t>(MASK::ITEM));
+    mMaskComboBox->addItem("EXPLOSION", static_cast<uint32_t>(MASK::EXPLOSION));
+    mMaskComboBox->addItem("ROPE", static_cast<uint32_t>(MASK::ROPE));
+    mMaskComboBox->addItem("FX", static_cast<uint32_t>(MASK::FX));
+    mMaskComboBox->addItem("ACTIVEFLOOR", static_cast<uint32_t>(MASK::ACTIVEFLOOR));
+    mMaskComboBox->addItem("FLOOR", static_cast<uint32_t>(MASK::FLOOR));
+    mMaskComboBox->addItem("DECORATION", static_cast<uint32_t>(MASK::DECORATION));
+    mMaskComboBox->addItem("BG", static_cast<uint32_t>(MASK::BG));
+    mMaskComboBox->addItem("SHADOW", static_cast<uint32_t>(MASK::SHADOW));
+    mMaskComboBox->addItem("LOGICAL", static_cast<uint32_t>(MASK::LOGICAL));
+    mMaskComboBox->addItem("WATER", static_cast<uint32_t>(MASK::WATER));
+    mMaskComboBox->addItem("LAVA", static_cast<uint32_t>(MASK::LAVA));
+    QObject::connect(mMaskComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewEntityGrid::sourceChanged);
+    sourceLayout->addWidget(mMaskComboBox);
+
+    sourceLayout->addWidget(new QLabel("or UIDs", this));
+    mUIDsLineEdit = new QLineEdit(this);
+    mUIDsLineEdit->setPlaceholderText("Comma separated, dec or hex starting with 0x");
+    QObject::connect(mUIDsLineEdit, &QLineEdit::editingFinished, this, &ViewEntityGrid::sourceChanged);
+    sourceLayout->addWidget(mUIDsLineEdit);
+    mMainLayout->addLayout(sourceLayout);
+
+    // columns
+    auto columnsLayout = new QHBoxLayout();
+    columnsLayout->addWidget(new QLabel("Field of", this));
+    mEntityClassComboBox = new QComboBox(this);
+    mEntityClassComboBox->addItem("Entity");
+    std::vector<std::string> classNames;
+    for (const auto& [classType, parentClassType] : mToolbar->configuration()->entityClassHierarchy())
+    {
+        classNames.emplace_back(classType);
+    }
+    std::sort(classNames.begin(), classNames.end());
+    for (const auto& className : classNames)
+    {
+        mEntityClassComboBox->addItem(QString::fromStdString(className));
+    }
+    QObject::connect(mEntityClassComboBox, &QComboBox::currentTextChanged, this, &ViewEntityGrid::entityClassChanged);
+    columnsLayout->addWidget(mEntityClassComboBox);
+
+    mFieldComboBox = new QComboBox(this);
+    mFieldComboBox->setMinimumWidth(200);
+    columnsLayout->addWidget(mFieldComboBox);
+
+    auto addColumnButton = new QPushButton("Add column", this);
+    QObject::connect(addColumnButton, &QPushButton::clicked, this, &ViewEntityGrid::addColumn);
+    columnsLayout->addWidget(addColumnButton);
+
+    auto removeColumnButton = new QPushButton("Remove selected column", this);
+    QObject::connect(removeColumnButton, &QPushButton::clicked, this, &ViewEntityGrid::removeColumn);
+    columnsLayout->addWidget(removeColumnButton);
+    columnsLayout->addStretch();
+    mMainLayout->addLayout(columnsLayout);
+
+    // filter and refresh
+    auto refreshLayout = new QHBoxLayout();
+    mRefreshButton = new QPushButton("Refresh", this);
+    QObject::connect(mRefreshButton, &QPushButton::clicked, this, &ViewEntityGrid::refreshGrid);
+    refreshLayout->addWidget(mRefreshButton);
+
+    mAutoRefreshTimer = std::make_unique<QTimer>(this);
+    QObject::connect(mAutoRefreshTimer.get(), &QTimer::timeout, this, &ViewEntityGrid::refreshGrid);
+
+    mAutoRefreshCheckBox = new QCheckBox("Auto-refresh every", this);
+    mAutoRefreshCheckBox->setCheckState(Qt::Unchecked);
+    refreshLayout->addWidget(mAutoRefreshCheckBox);
+    QObject::connect(mAutoRefreshCheckBox, &QCheckBox::clicked, this, &ViewEntityGrid::toggleAutoRefresh);
+
+    mAutoRefreshIntervalLineEdit = new QLineEdit(this);
+    mAutoRefreshIntervalLineEdit->setFixedWidth(50);
+    mAutoRefreshIntervalLineEdit->setValidator(new QIntValidator(100, 5000, this));
+    mAutoRefreshIntervalLineEdit->setText("100");
+    refreshLayout->addWidget(mAutoRefreshIntervalLineEdit);
+    QObject::connect(mAutoRefreshIntervalLineEdit, &QLineEdit::textChanged, this, &ViewEntityGrid::autoRefreshIntervalChanged);
+    refreshLayout->addWidget(new QLabel("milliseconds", this));
+
+    refreshLayout->addStretch();
+    refreshLayout->addWidget(new QLabel("Filter", this));
+    mFilterColumnComboBox = new QComboBox(this);
+    QObject::connect(mFilterColumnComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewEntityGrid::filterChanged);
+    refreshLayout->addWidget(mFilterColumnComboBox);
+    mFilterLineEdit = new QLineEdit(this);
+    mFilterLineEdit->setPlaceholderText("e.g. < 3, != 0 or (part of) a name");
+    QObject::connect(mFilterLineEdit, &QLineEdit::textChanged, this, &ViewEntityGrid::filterChanged);
+    refreshLayout->addWidget(mFilterLineEdit);
+    mMainLayout->addLayout(refreshLayout);
+
+    mMainTableView = new QTableView(this);
+    mMainTableView->setAlternatingRowColors(true);
+    mMainTableView->verticalHeader()->setVisible(false);
+    mMainTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    mMainTableView->verticalHeader()->setDefaultSectionSize(20);
+    mMainTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mMainTableView->setSelectionBehavior(QAbstractItemView::SelectItems);
+    mMainTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    mMainTableView->setSortingEnabled(true);
+    QObject::connect(mMainTableView, &QTableView::doubleClicked, this, &ViewEntityGrid::cellClicked);
+    mMainLayout->addWidget(mMainTableView);
+
+    mModel = new ItemModelEntityGrid(mEntityGrid.get(), this);
+    mModelProxy = new SortFilterProxyModelEntityGrid(this);
+    mModelProxy->setSourceModel(mModel);
+    mMainTableView->setModel(mModelProxy);
+    mMainTableView->setColumnWidth(gsColEntityGridUID, 60);
+    mMainTableView->setColumnWidth(gsColEntityGridName, 200);
+
+    updateFilterColumns();
+}
+
+void S2Plugin::ViewEntityGrid::closeEvent(QCloseEvent* event)
+{
+    delete this;
+}
+
+QSize S2Plugin::ViewEntityGrid::sizeHint() const
+{
+    return QSize(950, 650);
+}
+
+QSize S2Plugin::ViewEntityGrid::minimumSizeHint() const
+{
+    return QSize(150, 150);
+}
+
+void S2Plugin::ViewEntityGrid::refreshGrid()
+{
+    StateRefreshPass pass(mToolbar->state());
+    auto sameRows = mEntityGrid->refresh();
+    mModel->refreshed(sameRows);
+    setWindowTitle(QString("Entity grid (%1 entities)").arg(mEntityGrid->rowCount()));
+}
+
+void S2Plugin::ViewEntityGrid::sourceChanged()
+{
+    std::vector<uint32_t> uids;
+    for (const auto& part : mUIDsLineEdit->text().split(',', QString::SkipEmptyParts))
+    {
+        bool ok = false;
+        auto uid = part.trimmed().toUInt(&ok, 0);
+        if (ok)
+        {
+            uids.emplace_back(uid);
+        }
+    }
+    auto layer = static_cast<EntityGridLayer>(mLayerComboBox->currentData().toInt());
+    mEntityGrid->setSource(layer, mMaskComboBox->currentData().toUInt(), uids);
+    refreshGrid();
+}
+
+void S2Plugin::ViewEntityGrid::entityClassChanged(const QString& text)
+{
+    mAvailableColumns = mEntityGrid->entityScalarFields(text.toStdString());
+    mFieldComboBox->clear();
+    for (const auto& column : mAvailableColumns)
+    {
+        mFieldComboBox->addItem(QString::fromStdString(column.name));
+    }
+}
+
+void S2Plugin::ViewEntityGrid::addColumn()
+{
+    auto index = mFieldComboBox->currentIndex();
+    if (index < 0 || index >= mAvailableColumns.size())
+    {
+        return;
+    }
+    mEntityGrid->addColumn(mAvailableColumns.at(index));
+    mModel->reset();
+    refreshGrid();
+    updateFilterColumns();
+}
+
+void S2Plugin::ViewEntityGrid::removeColumn()
+{
+    auto current = mModelProxy->mapToSource(mMainTableView->currentIndex());
+    if (!current.isValid() || current.column() < gsColEntityGridFirstField)
+    {
+        return;
+    }
+    mEntityGrid->removeColumn(current.column() - gsColEntityGridFirstField);
+    mModel->reset();
+    updateFilterColumns();
+}
+
+void S2Plugin::ViewEntityGrid::updateFilterColumns()
+{
+    auto previousColumn = mFilterColumnComboBox->currentIndex();
+    mFilterColumnComboBox->blockSignals(true);
+    mFilterColumnComboBox->clear();
+    for (auto x = 0; x < mModel->columnCount(); ++x)
+    {
+        mFilterColumnComboBox->addItem(mModel->headerData(x, Qt::Horizontal).toString());
+    }
+    mFilterColumnComboBox->setCurrentIndex(previousColumn >= 0 && previousColumn < mModel->columnCount() ? previousColumn : gsColEntityGridName);
+    mFilterColumnComboBox->blockSignals(false);
+    filterChanged();
+}
+
+void S2Plugin::ViewEntityGrid::filterChanged()
+{
+    mModelProxy->setFilter(mFilterColumnComboBox->currentIndex(), mFilterLineEdit->text());
+}
+
+void S2Plugin::ViewEntityGrid::cellClicked(const QModelIndex& index)
+{
+    auto entity = mModelProxy->data(index, gsRoleMemoryOffset).toULongLong();
+    if (entity != 0)
+    {
+        mToolbar->showEntity(entity);
+    }
+}
+
+void S2Plugin::ViewEntityGrid::toggleAutoRefresh(int newState)
+{
+    if (newState == Qt::Unchecked)
+    {
+        mAutoRefreshTimer->stop();
+        mRefreshButton->setEnabled(true);
+    }
+    else
+    {
+        mAutoRefreshTimer->setInterval(mAutoRefreshIntervalLineEdit->text().toUInt());
+        mAutoRefreshTimer->start();
+        mRefreshButton->setEnabled(false);
+    }
+}
+
+void S2Plugin::ViewEntityGrid::autoRefreshIntervalChanged(const QString& text)
+{
+    if (mAutoRefreshCheckBox->checkState() == Qt::Checked)
+    {
+        mAutoRefreshTimer->setInterval(mAutoRefreshIntervalLineEdit->text().toUInt());
+    }
+}
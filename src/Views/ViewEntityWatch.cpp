@@ -0,0 +1,270 @@
+#include "Views/ViewEntityWatch.h"
+#include "Configuration.h"
+#include "Data/EntityWatch.h"
+#include "Data/FrameClock.h"
+#include "Data/State.h"
+#include "QtHelpers/ItemModelEntityWatch.h"
+#include "QtHelpers/StyledItemDelegateSparkline.h"
+#include "Spelunky2.h"
+#include "Views/ViewToolbar.h"
+#include "pluginmain.h"
+#include <QCloseEvent>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <algorithm>
+
+S2Plugin::ViewEntityWatch::ViewEntityWatch(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
+{
+    mEntityWatch = std::make_unique<EntityWatch>(mToolbar->configuration(), mToolbar->state(), mToolbar->entityDB());
+
+    initializeUI();
+    setWindowIcon(QIcon(":/icons/caveman.png"));
+    setWindowTitle("Entity watch");
+
+    entityClassChanged(mEntityClassComboBox->currentText());
+}
+
+void S2Plugin::ViewEntityWatch::initializeUI()
+{
+    mMainLayout = new QVBoxLayout(this);
+    mMainLayout->setMargin(5);
+    setLayout(mMainLayout);
+
+    // fields
+    auto fieldsLayout = new QHBoxLayout();
+    fieldsLayout->addWidget(new QLabel("UIDs", this));
+    mUIDsLineEdit = new QLineEdit(this);
+    mUIDsLineEdit->setPlaceholderText("Comma separated, dec or hex starting with 0x");
+    fieldsLayout->addWidget(mUIDsLineEdit);
+
+    fieldsLayout->addWidget(new QLabel("Field of", this));
+    mEntityClassComboBox = new QComboBox(this);
+    mEntityClassComboBox->addItem("Entity");
+    std::vector<std::string> classNames;
+    for (const auto& [classType, parentClassType] : mToolbar->configuration()->entityClassHierarchy())
+    {
+        classNames.emplace_back(classType);
+    }
+    std::sort(classNames.begin(), classNames.end());
+    for (const auto& className : classNames)
+    {
+        mEntityClassComboBox->addItem(QString::fromStdString(className));
+    }
+    QObject::connect(mEntityClassComboBox, &QComboBox::currentTextChanged, this, &ViewEntityWatch::entityClassChanged);
+    fieldsLayout->addWidget(mEntityClassComboBox);
+
+    mFieldComboBox = new QComboBox(this);
+    mFieldComboBox->setMinimumWidth(200);
+    fieldsLayout->addWidget(mFieldComboBox);
+
+    auto addFieldButton = new QPushButton("Watch", this);
+    QObject::connect(addFieldButton, &QPushButton::clicked, this, &ViewEntityWatch::addField);
+    fieldsLayout->addWidget(addFieldButton);
+
+    auto removeFieldButton = new QPushButton("Remove selected", this);
+    QObject::connect(removeFieldButton, &QPushButton::clicked, this, &ViewEntityWatch::removeField);
+    fieldsLayout->addWidget(removeFieldButton);
+    mMainLayout->addLayout(fieldsLayout);
+
+    // refresh
+    auto refreshLayout = new QHBoxLayout();
+    mRefreshButton = new QPushButton("Refresh", this);
+    QObject::connect(mRefreshButton, &QPushButton::clicked, this, &ViewEntityWatch::refreshWatch);
+    refreshLayout->addWidget(mRefreshButton);
+
+    mPerFrameCheckBox = new QCheckBox("Every game frame", this);
+    mPerFrameCheckBox->setCheckState(Qt::Unchecked);
+    mPerFrameCheckBox->setToolTip("Refresh once per game frame, following the game's frame counter");
+    refreshLayout->addWidget(mPerFrameCheckBox);
+    QObject::connect(mPerFrameCheckBox, &QCheckBox::clicked, this, &ViewEntityWatch::togglePerFrameRefresh);
+
+    mAutoRefreshTimer = std::make_unique<QTimer>(this);
+    QObject::connect(mAutoRefreshTimer.get(), &QTimer::timeout, this, &ViewEntityWatch::refreshWatch);
+
+    mAutoRefreshCheckBox = new QCheckBox("Auto-refresh every", this);
+    mAutoRefreshCheckBox->setCheckState(Qt::Unchecked);
+    refreshLayout->addWidget(mAutoRefreshCheckBox);
+    QObject::connect(mAutoRefreshCheckBox, &QCheckBox::clicked, this, &ViewEntityWatch::toggleAutoRefresh);
+
+    mAutoRefreshIntervalLineEdit = new QLineEdit(this);
+    mAutoRefreshIntervalLineEdit->setFixedWidth(50);
+    mAutoRefreshIntervalLineEdit->setValidator(new QIntValidator(100, 5000, this));
+    mAutoRefreshIntervalLineEdit->setText("100");
+    refreshLayout->addWidget(mAutoRefreshIntervalLineEdit);
+    QObject::connect(mAutoRefreshIntervalLineEdit, &QLineEdit::textChanged, this, &ViewEntityWatch::autoRefreshIntervalChanged);
+    refreshLayout->addWidget(new QLabel("milliseconds, spending at most", this));
+
+    mRefreshBudgetLineEdit = new QLineEdit(this);
+    mRefreshBudgetLineEdit->setFixedWidth(50);
+    mRefreshBudgetLineEdit->setValidator(new QIntValidator(1, 1000, this));
+    mRefreshBudgetLineEdit->setText("5");
+    mRefreshBudgetLineEdit->setToolTip("Entities that don't fit in the budget are refreshed first on the next refresh");
+    refreshLayout->addWidget(mRefreshBudgetLineEdit);
+    refreshLayout->addWidget(new QLabel("milliseconds per refresh", this));
+
+    refreshLayout->addStretch();
+    mStatisticsLabel = new QLabel(this);
+    refreshLayout->addWidget(mStatisticsLabel);
+    mMainLayout->addLayout(refreshLayout);
+
+    mMainTableView = new QTableView(this);
+    mMainTableView->setAlternatingRowColors(true);
+    mMainTableView->verticalHeader()->setVisible(false);
+    mMainTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    mMainTableView->verticalHeader()->setDefaultSectionSize(24);
+    mMainTableView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mMainTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mMainTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    mMainTableView->horizontalHeader()->setStretchLastSection(true);
+    mSparklineDelegate = std::make_unique<StyledItemDelegateSparkline>();
+    mMainTableView->setItemDelegateForColumn(gsColEntityWatchHistory, mSparklineDelegate.get());
+    QObject::connect(mMainTableView, &QTableView::doubleClicked, this, &ViewEntityWatch::cellClicked);
+    mMainLayout->addWidget(mMainTableView);
+
+    mModel = new ItemModelEntityWatch(mEntityWatch.get(), this);
+    mMainTableView->setModel(mModel);
+    mMainTableView->setColumnWidth(gsColEntityWatchUID, 60);
+    mMainTableView->setColumnWidth(gsColEntityWatchName, 200);
+    mMainTableView->setColumnWidth(gsColEntityWatchField, 200);
+    mMainTableView->setColumnWidth(gsColEntityWatchValue, 100);
+}
+
+void S2Plugin::ViewEntityWatch::closeEvent(QCloseEvent* event)
+{
+    if (mPerFrameCheckBox->checkState() == Qt::Checked)
+    {
+        mToolbar->frameClock()->unsubscribe();
+    }
+    delete this;
+}
+
+QSize S2Plugin::ViewEntityWatch::sizeHint() const
+{
+    return QSize(950, 550);
+}
+
+QSize S2Plugin::ViewEntityWatch::minimumSizeHint() const
+{
+    return QSize(150, 150);
+}
+
+void S2Plugin::ViewEntityWatch::refreshWatch()
+{
+    StateRefreshPass pass(mToolbar->state());
+    auto budget = std::chrono::milliseconds(mRefreshBudgetLineEdit->text().toUInt());
+    mEntityWatch->refresh(budget);
+    mModel->refreshed();
+    mStatisticsLabel->setText(QString("Last refresh: %1 entities, %2 reads, %3 ms")
+                                  .arg(mEntityWatch->lastRefreshEntityCount())
+                                  .arg(mEntityWatch->lastRefreshReadCount())
+                                  .arg(mEntityWatch->lastRefreshDuration().count() / 1000.0, 0, 'f', 2));
+}
+
+void S2Plugin::ViewEntityWatch::entityClassChanged(const QString& text)
+{
+    mAvailableFields = mEntityWatch->entityScalarFields(text.toStdString());
+    mFieldComboBox->clear();
+    for (const auto& field : mAvailableFields)
+    {
+        mFieldComboBox->addItem(QString::fromStdString(field.name));
+    }
+}
+
+void S2Plugin::ViewEntityWatch::addField()
+{
+    auto index = mFieldComboBox->currentIndex();
+    if (index < 0 || static_cast<size_t>(index) >= mAvailableFields.size())
+    {
+        return;
+    }
+    QStringList rejected;
+    for (const auto& part : mUIDsLineEdit->text().split(',', QString::SkipEmptyParts))
+    {
+        bool ok = false;
+        auto uid = part.trimmed().toUInt(&ok, 0);
+        std::string error;
+        if (ok && !mEntityWatch->addField(uid, mAvailableFields.at(index), error))
+        {
+            rejected << QString::fromStdString(error);
+        }
+    }
+    mModel->reset();
+    refreshWatch();
+
+    if (!rejected.isEmpty())
+    {
+        QMessageBox msgBox;
+        msgBox.setIcon(QMessageBox::Warning);
+        msgBox.setWindowIcon(QIcon(":/icons/caveman.png"));
+        msgBox.setText("Not watched:\n" + rejected.join("\n"));
+        msgBox.setWindowTitle("Spelunky2");
+        msgBox.exec();
+    }
+}
+
+void S2Plugin::ViewEntityWatch::removeField()
+{
+    auto current = mMainTableView->currentIndex();
+    if (!current.isValid())
+    {
+        return;
+    }
+    mEntityWatch->removeField(current.row());
+    mModel->reset();
+}
+
+void S2Plugin::ViewEntityWatch::cellClicked(const QModelIndex& index)
+{
+    auto entity = mToolbar->state()->locateEntityByUID(mEntityWatch->fieldAt(index.row()).uid).entity;
+    if (entity != 0)
+    {
+        mToolbar->showEntity(entity);
+    }
+}
+
+void S2Plugin::ViewEntityWatch::toggleAutoRefresh(int newState)
+{
+    if (newState == Qt::Unchecked)
+    {
+        mAutoRefreshTimer->stop();
+        mRefreshButton->setEnabled(true);
+    }
+    else
+    {
+        mAutoRefreshTimer->setInterval(mAutoRefreshIntervalLineEdit->text().toUInt());
+        mAutoRefreshTimer->start();
+        mRefreshButton->setEnabled(false);
+    }
+}
+
+void S2Plugin::ViewEntityWatch::togglePerFrameRefresh(bool checked)
+{
+    auto frameClock = mToolbar->frameClock();
+    if (!checked)
+    {
+        QObject::disconnect(frameClock, &FrameClock::frameAdvanced, this, &ViewEntityWatch::refreshWatch);
+        frameClock->unsubscribe();
+        mAutoRefreshCheckBox->setEnabled(true);
+        mRefreshButton->setEnabled(mAutoRefreshCheckBox->checkState() == Qt::Unchecked);
+    }
+    else if (frameClock->subscribe())
+    {
+        mAutoRefreshCheckBox->setCheckState(Qt::Unchecked);
+        mAutoRefreshCheckBox->setEnabled(false);
+        mAutoRefreshTimer->stop();
+        mRefreshButton->setEnabled(false);
+        QObject::connect(frameClock, &FrameClock::frameAdvanced, this, &ViewEntityWatch::refreshWatch);
+    }
+    else
+    {
+        mPerFrameCheckBox->setCheckState(Qt::Unchecked);
+    }
+}
+
+void S2Plugin::ViewEntityWatch::autoRefreshIntervalChanged(const QString& text)
+{
+    if (mAutoRefreshCheckBox->checkState() == Qt::Checked)
+    {
+        mAutoRefreshTimer->setInterval(mAutoRefreshIntervalLineEdit->text().toUInt());
+    }
+}
@@ -83,10 +83,12 @@ void S2Plugin::ViewGameManager::refreshGameManager()
     mToolbar->gameManager()->refreshOffsets();
     auto& offsets = mToolbar->gameManager()->offsets();
     auto deltaReference = offsets.at("GameManager.backgroundmusic");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::GameManager))
     {
         mMainTreeView->updateValueForField(field, "GameManager." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewGameManager::toggleAutoRefresh(int newState)
@@ -110,10 +110,12 @@ void S2Plugin::ViewJournalPage::refreshJournalPage()
     mJournalPage->refreshOffsets();
     auto& offsets = mJournalPage->offsets();
     auto deltaReference = offsets.at(mPageType + ".__vftable");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFieldsOfInlineStruct(mPageType))
     {
         mMainTreeView->updateValueForField(field, mPageType + "." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewJournalPage::toggleAutoRefresh(int newState)
@@ -130,6 +130,7 @@ void S2Plugin::ViewLevelGen::refreshLevelGen()
     mToolbar->levelGen()->refreshOffsets();
     auto& offsets = mToolbar->levelGen()->offsets();
     auto deltaReference = offsets.at("LevelGen.data");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::LevelGen))
     {
         mMainTreeView->updateValueForField(field, "LevelGen." + field.name, offsets, deltaReference);
@@ -143,6 +144,7 @@ void S2Plugin::ViewLevelGen::refreshLevelGen()
             }
         }
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewLevelGen::toggleAutoRefresh(int newLevelGen)
@@ -1,19 +1,35 @@
 #include "Views/ViewLogger.h"
+#include "Data/FrameClock.h"
 #include "Data/Logger.h"
+#include "Data/LoggerComparison.h"
+#include "Data/LoggerFieldReader.h"
+#include "Data/LoggerSession.h"
+#include "QtHelpers/ItemModelLoggerComparison.h"
 #include "QtHelpers/ItemModelLoggerFields.h"
 #include "QtHelpers/ItemModelLoggerSamples.h"
+#include "QtHelpers/ItemModelLoggerStatistics.h"
 #include "QtHelpers/TableViewLogger.h"
+#include "QtHelpers/TableViewLoggerSamples.h"
+#include "QtHelpers/WidgetComparisonPlot.h"
 #include "QtHelpers/WidgetSamplesPlot.h"
 #include "QtHelpers/WidgetSampling.h"
+#include "Views/ViewToolbar.h"
 #include <QCloseEvent>
+#include <QDoubleValidator>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QHBoxLayout>
+#include <QHeaderView>
 #include <QIcon>
+#include <QInputDialog>
 #include <QLabel>
 #include <QMessageBox>
+#include <algorithm>
 
-S2Plugin::ViewLogger::ViewLogger(QWidget* parent) : QWidget(parent)
+S2Plugin::ViewLogger::ViewLogger(ViewToolbar* toolbar, QWidget* parent) : QWidget(parent), mToolbar(toolbar)
 {
-    mLogger = std::make_unique<Logger>();
+    mLogger = std::make_unique<Logger>(mToolbar->state(), mToolbar->frameClock());
+    mComparison = std::make_unique<LoggerComparison>();
 
     initializeUI();
     setWindowIcon(QIcon(":/icons/caveman.png"));
@@ -45,10 +61,16 @@ void S2Plugin::ViewLogger::initializeUI()
     mTopLayout->addWidget(new QLabel("Sample period:", this));
     mSamplePeriodLineEdit = new QLineEdit("8", this);
     mSamplePeriodLineEdit->setFixedWidth(50);
-    mSamplePeriodLineEdit->setValidator(new QIntValidator(5, 5000, this));
+    mSamplePeriodLineEdit->setValidator(new QIntValidator(1, 5000, this));
     mTopLayout->addWidget(mSamplePeriodLineEdit);
     mTopLayout->addWidget(new QLabel("milliseconds", this));
 
+    mPerFrameCheckBox = new QCheckBox("Every game frame", this);
+    mPerFrameCheckBox->setCheckState(Qt::Unchecked);
+    mPerFrameCheckBox->setToolTip("Take exactly one sample per game frame, following the game's frame counter, instead of sampling on a timer");
+    QObject::connect(mPerFrameCheckBox, &QCheckBox::stateChanged, this, &ViewLogger::perFrameToggled);
+    mTopLayout->addWidget(mPerFrameCheckBox);
+
     mTopLayout->addStretch();
 
     mTopLayout->addWidget(new QLabel("Duration:", this));
@@ -60,13 +82,74 @@ void S2Plugin::ViewLogger::initializeUI()
 
     mTopLayout->addStretch();
 
+    mTopLayout->addWidget(new QLabel("Read together within:", this));
+    mSpanGapLineEdit = new QLineEdit(QString::number(LoggerFieldReader::msDefaultSpanGap), this);
+    mSpanGapLineEdit->setFixedWidth(50);
+    mSpanGapLineEdit->setValidator(new QIntValidator(0, 0x10000, this));
+    mSpanGapLineEdit->setToolTip("Fields that are at most this many bytes apart are read from the game in one go");
+    mTopLayout->addWidget(mSpanGapLineEdit);
+    mTopLayout->addWidget(new QLabel("bytes", this));
+
+    mTopLayout->addStretch();
+
+    mSamplingStatsLabel = new QLabel(this);
+    mTopLayout->addWidget(mSamplingStatsLabel);
+
+    mRecordToFileCheckBox = new QCheckBox("Record to file", this);
+    mRecordToFileCheckBox->setCheckState(Qt::Unchecked);
+    mRecordToFileCheckBox->setToolTip("Write the samples to a recording file as they come in, only keeping a window of them in memory, for long captures");
+    mTopLayout->addWidget(mRecordToFileCheckBox);
+
     mStartButton = new QPushButton(this);
     mStartButton->setText("Start");
     mTopLayout->addWidget(mStartButton);
     QObject::connect(mStartButton, &QPushButton::clicked, this, &ViewLogger::startLogging);
 
+    mOpenRecordingButton = new QPushButton(this);
+    mOpenRecordingButton->setText("Open recording");
+    mTopLayout->addWidget(mOpenRecordingButton);
+    QObject::connect(mOpenRecordingButton, &QPushButton::clicked, this, &ViewLogger::openRecording);
+
     mMainLayout->addLayout(mTopLayout);
 
+    // TRIGGER
+    mTriggerWidget = new QWidget(this);
+    auto triggerLayout = new QHBoxLayout(mTriggerWidget);
+    triggerLayout->setMargin(0);
+    mTriggerCheckBox = new QCheckBox("Trigger when", mTriggerWidget);
+    mTriggerCheckBox->setCheckState(Qt::Unchecked);
+    mTriggerCheckBox->setToolTip("Start armed and only keep the samples around the moments the condition is met, for catching rare events");
+    triggerLayout->addWidget(mTriggerCheckBox);
+    mTriggerFieldComboBox = new QComboBox(mTriggerWidget);
+    mTriggerFieldComboBox->setMinimumWidth(150);
+    triggerLayout->addWidget(mTriggerFieldComboBox);
+    mTriggerConditionComboBox = new QComboBox(mTriggerWidget);
+    mTriggerConditionComboBox->addItem("rises above", static_cast<int>(LoggerTriggerCondition::RisesAbove));
+    mTriggerConditionComboBox->addItem("falls below", static_cast<int>(LoggerTriggerCondition::FallsBelow));
+    mTriggerConditionComboBox->addItem("changes", static_cast<int>(LoggerTriggerCondition::Changes));
+    mTriggerConditionComboBox->addItem("becomes", static_cast<int>(LoggerTriggerCondition::Equals));
+    triggerLayout->addWidget(mTriggerConditionComboBox);
+    mTriggerValueLineEdit = new QLineEdit("0", mTriggerWidget);
+    mTriggerValueLineEdit->setFixedWidth(80);
+    mTriggerValueLineEdit->setValidator(new QDoubleValidator(this));
+    triggerLayout->addWidget(mTriggerValueLineEdit);
+    triggerLayout->addWidget(new QLabel("keep", mTriggerWidget));
+    mPreTriggerLineEdit = new QLineEdit("100", mTriggerWidget);
+    mPreTriggerLineEdit->setFixedWidth(50);
+    mPreTriggerLineEdit->setValidator(new QIntValidator(0, 1000000, this));
+    triggerLayout->addWidget(mPreTriggerLineEdit);
+    triggerLayout->addWidget(new QLabel("samples before and", mTriggerWidget));
+    mPostTriggerLineEdit = new QLineEdit("1000", mTriggerWidget);
+    mPostTriggerLineEdit->setFixedWidth(50);
+    mPostTriggerLineEdit->setValidator(new QIntValidator(0, 500000, this));
+    triggerLayout->addWidget(mPostTriggerLineEdit);
+    triggerLayout->addWidget(new QLabel("milliseconds after", mTriggerWidget));
+    mRearmCheckBox = new QCheckBox("Re-arm", mTriggerWidget);
+    mRearmCheckBox->setToolTip("Capture every time the condition is met until the duration ends, instead of stopping after the first capture");
+    triggerLayout->addWidget(mRearmCheckBox);
+    triggerLayout->addStretch();
+    mMainLayout->addWidget(mTriggerWidget);
+
     // TABS
     mMainTabWidget = new QTabWidget(this);
     mMainTabWidget->setDocumentMode(false);
@@ -75,16 +158,24 @@ void S2Plugin::ViewLogger::initializeUI()
     mTabFields = new QWidget();
     mTabSamples = new QWidget();
     mTabPlot = new QWidget();
+    mTabStatistics = new QWidget();
+    mTabCompare = new QWidget();
     mTabFields->setLayout(new QVBoxLayout(mTabFields));
     mTabFields->layout()->setMargin(0);
     mTabSamples->setLayout(new QVBoxLayout(mTabSamples));
     mTabSamples->layout()->setMargin(0);
     mTabPlot->setLayout(new QVBoxLayout(mTabPlot));
     mTabPlot->layout()->setMargin(0);
+    mTabStatistics->setLayout(new QVBoxLayout(mTabStatistics));
+    mTabStatistics->layout()->setMargin(0);
+    mTabCompare->setLayout(new QVBoxLayout(mTabCompare));
+    mTabCompare->layout()->setMargin(0);
 
     mMainTabWidget->addTab(mTabFields, "Fields");
     mMainTabWidget->addTab(mTabSamples, "Samples");
     mMainTabWidget->addTab(mTabPlot, "Plot");
+    mMainTabWidget->addTab(mTabStatistics, "Statistics");
+    mMainTabWidget->addTab(mTabCompare, "Compare");
 
     // TAB Fields
     {
@@ -103,7 +194,25 @@ void S2Plugin::ViewLogger::initializeUI()
 
     // TAB Samples
     {
-        mSamplesTableView = new QTableView(this);
+        auto decimationLayout = new QHBoxLayout();
+        decimationLayout->addWidget(new QLabel("Show:", this));
+        mSamplesDecimationComboBox = new QComboBox(this);
+        mSamplesDecimationComboBox->addItem("All samples", static_cast<int>(LoggerSamplesDecimation::All));
+        mSamplesDecimationComboBox->addItem("Every Nth sample", static_cast<int>(LoggerSamplesDecimation::EveryNth));
+        mSamplesDecimationComboBox->addItem("Only changes", static_cast<int>(LoggerSamplesDecimation::Changes));
+        QObject::connect(mSamplesDecimationComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewLogger::samplesDecimationChanged);
+        decimationLayout->addWidget(mSamplesDecimationComboBox);
+        decimationLayout->addWidget(new QLabel("N:", this));
+        mSamplesStrideLineEdit = new QLineEdit("10", this);
+        mSamplesStrideLineEdit->setFixedWidth(50);
+        mSamplesStrideLineEdit->setValidator(new QIntValidator(1, 1000000, this));
+        mSamplesStrideLineEdit->setEnabled(false);
+        QObject::connect(mSamplesStrideLineEdit, &QLineEdit::editingFinished, this, &ViewLogger::samplesDecimationChanged);
+        decimationLayout->addWidget(mSamplesStrideLineEdit);
+        decimationLayout->addStretch();
+        dynamic_cast<QVBoxLayout*>(mTabSamples->layout())->addLayout(decimationLayout);
+
+        mSamplesTableView = new TableViewLoggerSamples(this);
         mTabSamples->layout()->addWidget(mSamplesTableView);
         mSamplesTableModel = new ItemModelLoggerSamples(mLogger.get(), mSamplesTableView);
         mSamplesTableView->setModel(mSamplesTableModel);
@@ -119,8 +228,65 @@ void S2Plugin::ViewLogger::initializeUI()
         mTabPlot->layout()->addWidget(mSamplesPlotScroll);
     }
 
+    // TAB Statistics
+    {
+        mStatisticsTableView = new QTableView(this);
+        mTabStatistics->layout()->addWidget(mStatisticsTableView);
+        mStatisticsTableModel = new ItemModelLoggerStatistics(mLogger.get(), mStatisticsTableView);
+        mStatisticsTableView->setModel(mStatisticsTableModel);
+        mStatisticsTableView->setColumnWidth(gsLogStatColField, 200);
+    }
+
+    // TAB Compare
+    {
+        auto compareLayout = new QHBoxLayout();
+        auto keepSessionButton = new QPushButton("Keep current session", this);
+        keepSessionButton->setToolTip("Keep the logged samples to compare with other sessions, logging can go on");
+        QObject::connect(keepSessionButton, &QPushButton::clicked, this, &ViewLogger::keepSession);
+        compareLayout->addWidget(keepSessionButton);
+        auto addRecordingButton = new QPushButton("Add recording", this);
+        QObject::connect(addRecordingButton, &QPushButton::clicked, this, &ViewLogger::addSessionFromRecording);
+        compareLayout->addWidget(addRecordingButton);
+        auto removeSessionButton = new QPushButton("Remove", this);
+        QObject::connect(removeSessionButton, &QPushButton::clicked, this, &ViewLogger::removeSession);
+        compareLayout->addWidget(removeSessionButton);
+        compareLayout->addStretch();
+
+        compareLayout->addWidget(new QLabel("Field:", this));
+        mCompareFieldComboBox = new QComboBox(this);
+        mCompareFieldComboBox->setMinimumWidth(150);
+        QObject::connect(mCompareFieldComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewLogger::updateComparison);
+        compareLayout->addWidget(mCompareFieldComboBox);
+        compareLayout->addWidget(new QLabel("Align on:", this));
+        mCompareAlignmentComboBox = new QComboBox(this);
+        mCompareAlignmentComboBox->addItem("Start of each session", static_cast<int>(LoggerAlignment::FirstSample));
+        mCompareAlignmentComboBox->addItem("Trigger condition", static_cast<int>(LoggerAlignment::Trigger));
+        mCompareAlignmentComboBox->setToolTip("With the trigger condition, each session is lined up on the first frame the condition set above is met in");
+        QObject::connect(mCompareAlignmentComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewLogger::updateComparison);
+        compareLayout->addWidget(mCompareAlignmentComboBox);
+        dynamic_cast<QVBoxLayout*>(mTabCompare->layout())->addLayout(compareLayout);
+
+        mComparisonPlotWidget = new WidgetComparisonPlot(mLogger.get(), mComparison.get(), this);
+        dynamic_cast<QVBoxLayout*>(mTabCompare->layout())->addWidget(mComparisonPlotWidget, 2);
+
+        mComparisonTableView = new QTableView(this);
+        mComparisonTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+        mComparisonTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+        mComparisonTableView->verticalHeader()->setVisible(false);
+        dynamic_cast<QVBoxLayout*>(mTabCompare->layout())->addWidget(mComparisonTableView, 1);
+        mComparisonTableModel = new ItemModelLoggerComparison(mLogger.get(), mComparison.get(), mComparisonTableView);
+        mComparisonTableView->setModel(mComparisonTableModel);
+        mComparisonTableView->setColumnWidth(gsLogCompColSession, 150);
+        mComparisonTableView->setColumnWidth(gsLogCompColAlignedAt, 150);
+    }
+
     QObject::connect(mLogger.get(), &Logger::samplingEnded, this, &ViewLogger::samplingEnded);
     QObject::connect(mLogger.get(), &Logger::fieldsChanged, this, &ViewLogger::fieldsChanged);
+    QObject::connect(mLogger.get(), &Logger::sessionsChanged, this, &ViewLogger::sessionsChanged);
+    // a different trigger lines the sessions up differently
+    QObject::connect(mTriggerFieldComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewLogger::updateComparison);
+    QObject::connect(mTriggerConditionComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ViewLogger::updateComparison);
+    QObject::connect(mTriggerValueLineEdit, &QLineEdit::editingFinished, this, &ViewLogger::updateComparison);
 
     mSamplingWidget = new WidgetSampling(this);
     mSamplingWidget->setHidden(true);
@@ -131,35 +297,214 @@ void S2Plugin::ViewLogger::startLogging()
 {
     if (mLogger->fieldCount() > 0)
     {
+        std::string recordingPath;
+        if (mRecordToFileCheckBox->checkState() == Qt::Checked)
+        {
+            auto fileName = QFileDialog::getSaveFileName(this, "Record to", "Spelunky2Recording.s2rec", "Logger recordings (*.s2rec)");
+            if (fileName.isEmpty())
+            {
+                return;
+            }
+            recordingPath = fileName.toStdString();
+        }
+        applyTrigger();
+        mLogger->setSpanGap(mSpanGapLineEdit->text().toULongLong());
+        auto started = false;
+        if (mPerFrameCheckBox->checkState() == Qt::Checked)
+        {
+            started = mLogger->startOnFrames(mDurationLineEdit->text().toULongLong(), recordingPath);
+        }
+        else
+        {
+            started = mLogger->start(mSamplePeriodLineEdit->text().toULongLong(), mDurationLineEdit->text().toULongLong(), recordingPath);
+        }
+        if (!started)
+        {
+            showError(QString::fromStdString(mLogger->error()));
+            return;
+        }
         mSamplePeriodLineEdit->setEnabled(false);
+        mPerFrameCheckBox->setEnabled(false);
         mDurationLineEdit->setEnabled(false);
+        mSpanGapLineEdit->setEnabled(false);
+        mRecordToFileCheckBox->setEnabled(false);
+        mTriggerWidget->setEnabled(false);
         mStartButton->setEnabled(false);
+        mOpenRecordingButton->setEnabled(false);
+        mSamplingStatsLabel->clear();
         mMainTabWidget->setHidden(true);
         mSamplingWidget->setHidden(false);
-        mLogger->start(mSamplePeriodLineEdit->text().toULongLong(), mDurationLineEdit->text().toULongLong());
     }
     else
     {
-        QMessageBox msgBox;
-        msgBox.setIcon(QMessageBox::Warning);
-        msgBox.setWindowIcon(QIcon(":/icons/caveman.png"));
-        msgBox.setText("Please specify one or more fields to log");
-        msgBox.setWindowTitle("Spelunky2");
-        msgBox.exec();
+        showError("Please specify one or more fields to log");
     }
 }
 
+void S2Plugin::ViewLogger::applyTrigger()
+{
+    if (mTriggerCheckBox->checkState() != Qt::Checked || mTriggerFieldComboBox->currentIndex() < 0)
+    {
+        mLogger->clearTrigger();
+        return;
+    }
+    mLogger->setTrigger(triggerFromUI());
+}
+
+S2Plugin::LoggerTrigger S2Plugin::ViewLogger::triggerFromUI() const
+{
+    LoggerTrigger trigger;
+    trigger.fieldIndex = (std::max)(0, mTriggerFieldComboBox->currentIndex());
+    trigger.condition = static_cast<LoggerTriggerCondition>(mTriggerConditionComboBox->currentData().toInt());
+    trigger.value = mTriggerValueLineEdit->text().toDouble();
+    trigger.preTriggerSamples = mPreTriggerLineEdit->text().toULongLong();
+    trigger.postTriggerDuration = mPostTriggerLineEdit->text().toUInt();
+    trigger.rearm = mRearmCheckBox->checkState() == Qt::Checked;
+    return trigger;
+}
+
+void S2Plugin::ViewLogger::openRecording()
+{
+    auto fileName = QFileDialog::getOpenFileName(this, "Open recording", QString(), "Logger recordings (*.s2rec)");
+    if (!fileName.isEmpty() && !mLogger->openRecording(fileName.toStdString()))
+    {
+        showError(QString::fromStdString(mLogger->error()));
+    }
+}
+
+void S2Plugin::ViewLogger::showError(const QString& message)
+{
+    QMessageBox msgBox;
+    msgBox.setIcon(QMessageBox::Warning);
+    msgBox.setWindowIcon(QIcon(":/icons/caveman.png"));
+    msgBox.setText(message);
+    msgBox.setWindowTitle("Spelunky2");
+    msgBox.exec();
+}
+
 void S2Plugin::ViewLogger::samplingEnded()
 {
-    mSamplePeriodLineEdit->setEnabled(true);
+    if (mPerFrameCheckBox->checkState() == Qt::Checked)
+    {
+        mSamplingStatsLabel->setText(QString("Missed frames: %1").arg(mLogger->missedFrameCount()));
+    }
+    else
+    {
+        mSamplingStatsLabel->setText(QString("Overruns: %1, dropped: %2").arg(mLogger->overrunCount()).arg(mLogger->droppedSampleCount()));
+    }
+    if (mTriggerCheckBox->checkState() == Qt::Checked)
+    {
+        mSamplingStatsLabel->setText(mSamplingStatsLabel->text() + QString(", captures: %1").arg(mLogger->triggerSamples().size()));
+    }
+    // a recording that was opened wasn't sampled, there are no reads to tell about
+    if (mLogger->readsPerSample() != 0)
+    {
+        mSamplingStatsLabel->setText(mSamplingStatsLabel->text() + QString(", reads per sample: %1").arg(mLogger->readsPerSample()));
+        if (mLogger->maxSampleRate() > 0)
+        {
+            mSamplingStatsLabel->setText(mSamplingStatsLabel->text() + QString(", reads allow %1 samples/s").arg(mLogger->maxSampleRate(), 0, 'f', 0));
+        }
+    }
+    if (!mLogger->error().empty())
+    {
+        // the recording file couldn't be written or read completely
+        mSamplingStatsLabel->setText(QString::fromStdString(mLogger->error()));
+    }
+    mSamplePeriodLineEdit->setEnabled(mPerFrameCheckBox->checkState() != Qt::Checked);
+    mPerFrameCheckBox->setEnabled(true);
     mDurationLineEdit->setEnabled(true);
+    mSpanGapLineEdit->setEnabled(true);
+    mRecordToFileCheckBox->setEnabled(true);
+    mTriggerWidget->setEnabled(true);
     mStartButton->setEnabled(true);
+    mOpenRecordingButton->setEnabled(true);
     mSamplingWidget->setHidden(true);
     mMainTabWidget->setHidden(false);
     mSamplesTableModel->reset();
+    mStatisticsTableModel->reset();
+    mSamplesPlotWidget->resetView();
 }
 
 void S2Plugin::ViewLogger::fieldsChanged()
 {
+    auto triggerField = mTriggerFieldComboBox->currentIndex();
+    mTriggerFieldComboBox->clear();
+    for (size_t x = 0; x < mLogger->fieldCount(); ++x)
+    {
+        mTriggerFieldComboBox->addItem(QString::fromStdString(mLogger->fieldAt(x).name));
+    }
+    mTriggerFieldComboBox->setCurrentIndex((std::max)(0, (std::min)(triggerField, mTriggerFieldComboBox->count() - 1)));
     mSamplesTableModel->reset();
+    mStatisticsTableModel->reset();
+}
+
+void S2Plugin::ViewLogger::samplesDecimationChanged()
+{
+    auto decimation = static_cast<LoggerSamplesDecimation>(mSamplesDecimationComboBox->currentData().toInt());
+    mSamplesStrideLineEdit->setEnabled(decimation == LoggerSamplesDecimation::EveryNth);
+    mSamplesTableModel->setDecimation(decimation, mSamplesStrideLineEdit->text().toULongLong());
+}
+
+void S2Plugin::ViewLogger::perFrameToggled(int newState)
+{
+    mSamplePeriodLineEdit->setEnabled(newState != Qt::Checked);
+}
+
+void S2Plugin::ViewLogger::keepSession()
+{
+    bool ok = false;
+    auto name = QInputDialog::getText(this, "Spelunky2", "Name of the session", QLineEdit::Normal, QString("Session %1").arg(mLogger->sessionCount() + 1), &ok);
+    if (ok && !mLogger->keepSession(name.toStdString()))
+    {
+        showError(QString::fromStdString(mLogger->error()));
+    }
+}
+
+void S2Plugin::ViewLogger::addSessionFromRecording()
+{
+    auto fileName = QFileDialog::getOpenFileName(this, "Add recording", QString(), "Logger recordings (*.s2rec)");
+    if (!fileName.isEmpty() && !mLogger->addSessionFromRecording(fileName.toStdString(), QFileInfo(fileName).completeBaseName().toStdString()))
+    {
+        showError(QString::fromStdString(mLogger->error()));
+    }
+}
+
+void S2Plugin::ViewLogger::removeSession()
+{
+    auto ix = mComparisonTableView->selectionModel()->selectedRows();
+    if (ix.count() > 0)
+    {
+        mLogger->removeSession(ix.at(0).row());
+    }
+}
+
+void S2Plugin::ViewLogger::sessionsChanged()
+{
+    // the fields of the reference session are the ones that can be compared
+    auto field = mCompareFieldComboBox->currentText();
+    mCompareFieldComboBox->blockSignals(true);
+    mCompareFieldComboBox->clear();
+    if (mLogger->sessionCount() > 0)
+    {
+        for (const auto& loggedField : mLogger->sessionAt(0).fields)
+        {
+            mCompareFieldComboBox->addItem(QString::fromStdString(loggedField.name));
+        }
+    }
+    mCompareFieldComboBox->setCurrentIndex((std::max)(0, mCompareFieldComboBox->findText(field)));
+    mCompareFieldComboBox->blockSignals(false);
+    updateComparison();
+}
+
+void S2Plugin::ViewLogger::updateComparison()
+{
+    std::vector<const LoggerSession*> sessions;
+    for (size_t x = 0; x < mLogger->sessionCount(); ++x)
+    {
+        sessions.emplace_back(&mLogger->sessionAt(x));
+    }
+    auto alignment = static_cast<LoggerAlignment>(mCompareAlignmentComboBox->currentData().toInt());
+    mComparison->update(sessions, mCompareFieldComboBox->currentText().toStdString(), alignment, triggerFromUI(), mTriggerFieldComboBox->currentText().toStdString());
+    mComparisonTableModel->reset();
+    mComparisonPlotWidget->comparisonChanged();
 }
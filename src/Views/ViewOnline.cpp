@@ -84,10 +84,12 @@ void S2Plugin::ViewOnline::refreshOnline()
     mToolbar->state()->refreshOffsets();
     auto& offsets = mToolbar->online()->offsets();
     auto deltaReference = offsets.at("Online.__vftable");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::Online))
     {
         mMainTreeView->updateValueForField(field, "Online." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewOnline::toggleAutoRefresh(int newState)
@@ -210,10 +210,12 @@ void S2Plugin::ViewParticleDB::showIndex(size_t index)
     mLookupIndex = index;
     auto& offsets = mToolbar->particleDB()->offsetsForIndex(mLookupIndex);
     auto deltaReference = offsets.at("ParticleDB.id");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::ParticleDB))
     {
         mMainTreeView->updateValueForField(field, "ParticleDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewParticleDB::label()
@@ -239,10 +241,12 @@ void S2Plugin::ViewParticleDB::updateFieldValues()
 {
     auto& offsets = mToolbar->particleDB()->offsetsForIndex(mLookupIndex);
     auto deltaReference = offsets.at("ParticleDB.id");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::ParticleDB))
     {
         mMainTreeView->updateValueForField(field, "ParticleDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewParticleDB::compareGroupByCheckBoxClicked(int state)
@@ -83,10 +83,12 @@ void S2Plugin::ViewSaveGame::refreshSaveGame()
     mToolbar->savegame()->refreshOffsets();
     auto& offsets = mToolbar->savegame()->offsets();
     auto deltaReference = offsets.at("SaveGame.places");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::SaveGame))
     {
         mMainTreeView->updateValueForField(field, "SaveGame." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewSaveGame::toggleAutoRefresh(int newState)
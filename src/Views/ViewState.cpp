@@ -85,10 +85,12 @@ void S2Plugin::ViewState::refreshState()
     mState->refreshOffsets();
     auto& offsets = mState->offsets();
     auto deltaReference = offsets.at("State.p00");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::State))
     {
         mMainTreeView->updateValueForField(field, "State." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewState::toggleAutoRefresh(int newState)
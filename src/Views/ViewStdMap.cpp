@@ -198,6 +198,7 @@ void S2Plugin::ViewStdMap::refreshData()
     std::unordered_map<std::string, size_t> offsets;
     auto m = MemoryMappedData(mToolbar->configuration());
 
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mMemoryFields)
     {
         const auto& mem_field = std::get<0>(field);
@@ -207,6 +208,7 @@ void S2Plugin::ViewStdMap::refreshData()
         m.setOffsetForField(mem_field, mem_field.name, mem_offset, offsets);
         mMainTreeView->updateValueForField(mem_field, mem_field.name, offsets, 0, parrent);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 QSize S2Plugin::ViewStdMap::sizeHint() const
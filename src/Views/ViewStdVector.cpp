@@ -10,9 +10,12 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QTimer>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
-S2Plugin::ViewStdVector::ViewStdVector(ViewToolbar* toolbar, const std::string& vectorType, size_t vectorOffset, QWidget* parent)
-    : mVectorType(vectorType), mVectorOffset(vectorOffset), QWidget(parent), mToolbar(toolbar)
+S2Plugin::ViewStdVector::ViewStdVector(ViewToolbar* toolbar, const std::string& vectorType, size_t vectorOffset, ContainerLayout layout, QWidget* parent)
+    : mVectorType(vectorType), mVectorOffset(vectorOffset), mContainerLayout(layout), QWidget(parent), mToolbar(toolbar)
 {
     mMainLayout = new QVBoxLayout(this);
 
@@ -20,13 +23,22 @@ S2Plugin::ViewStdVector::ViewStdVector(ViewToolbar* toolbar, const std::string&
     mVectorTypeSize = m.sizeOf(mVectorType);
 
     initializeRefreshLayout();
+    initializeNavigationLayout();
     initializeTreeView();
+    initializeFilterFields();
     setWindowIcon(QIcon(":/icons/caveman.png"));
 
     mMainLayout->setMargin(5);
     setLayout(mMainLayout);
 
-    setWindowTitle(QString("std::vector<%1>").arg(QString::fromStdString(vectorType)));
+    if (mContainerLayout == ContainerLayout::Vector)
+    {
+        setWindowTitle(QString("Vector<%1>").arg(QString::fromStdString(vectorType)));
+    }
+    else
+    {
+        setWindowTitle(QString("std::vector<%1>").arg(QString::fromStdString(vectorType)));
+    }
     mMainTreeView->setVisible(true);
 
     refreshVectorContents();
@@ -35,10 +47,94 @@ S2Plugin::ViewStdVector::ViewStdVector(ViewToolbar* toolbar, const std::string&
 
 void S2Plugin::ViewStdVector::initializeTreeView()
 {
+    auto treeLayout = new QHBoxLayout();
+
     mMainTreeView = new TreeViewMemoryFields(mToolbar, nullptr, this);
     mMainTreeView->setEnableChangeHighlighting(false);
+    treeLayout->addWidget(mMainTreeView);
+
+    mPageScrollBar = new QScrollBar(Qt::Vertical, this);
+    mPageScrollBar->setSingleStep(1);
+    mPageScrollBar->setPageStep(msPageSize);
+    mPageScrollBar->setMinimum(0);
+    mPageScrollBar->setMaximum(0);
+    QObject::connect(mPageScrollBar, &QScrollBar::valueChanged, this, &ViewStdVector::pageScrolled);
+    treeLayout->addWidget(mPageScrollBar);
+
+    mMainLayout->addLayout(treeLayout);
+}
+
+void S2Plugin::ViewStdVector::initializeNavigationLayout()
+{
+    auto navigationLayout = new QHBoxLayout();
+    mMainLayout->addLayout(navigationLayout);
+
+    navigationLayout->addWidget(new QLabel("Jump to index", this));
+    mJumpToIndexLineEdit = new QLineEdit(this);
+    mJumpToIndexLineEdit->setFixedWidth(75);
+    mJumpToIndexLineEdit->setValidator(new QIntValidator(0, (std::numeric_limits<int>::max)(), this));
+    navigationLayout->addWidget(mJumpToIndexLineEdit);
+    QObject::connect(mJumpToIndexLineEdit, &QLineEdit::returnPressed, this, &ViewStdVector::jumpToIndex);
 
-    mMainLayout->addWidget(mMainTreeView);
+    navigationLayout->addWidget(new QLabel("Filter", this));
+    mFilterFieldComboBox = new QComboBox(this);
+    navigationLayout->addWidget(mFilterFieldComboBox);
+    navigationLayout->addWidget(new QLabel("==", this));
+    mFilterValueLineEdit = new QLineEdit(this);
+    mFilterValueLineEdit->setFixedWidth(100);
+    navigationLayout->addWidget(mFilterValueLineEdit);
+    QObject::connect(mFilterValueLineEdit, &QLineEdit::returnPressed, this, &ViewStdVector::applyFilter);
+
+    auto applyFilterButton = new QPushButton("Apply filter", this);
+    QObject::connect(applyFilterButton, &QPushButton::clicked, this, &ViewStdVector::applyFilter);
+    navigationLayout->addWidget(applyFilterButton);
+
+    auto clearFilterButton = new QPushButton("Clear filter", this);
+    QObject::connect(clearFilterButton, &QPushButton::clicked, this, &ViewStdVector::clearFilter);
+    navigationLayout->addWidget(clearFilterButton);
+
+    navigationLayout->addStretch();
+    mPageLabel = new QLabel(this);
+    navigationLayout->addWidget(mPageLabel);
+}
+
+void S2Plugin::ViewStdVector::initializeFilterFields()
+{
+    auto config = mToolbar->configuration();
+    auto m = MemoryMappedData(config);
+
+    mFilterFields.clear();
+    if (config->isBuiltInType(mVectorType))
+    {
+        auto type = gsJSONStringToMemoryFieldTypeMapping.at(mVectorType);
+        if (MemoryMappedData::isScalarType(type))
+        {
+            mFilterFields.emplace_back(FilterField{"value", type, 0, mVectorTypeSize});
+        }
+    }
+    else if (config->isPointer(mVectorType) || config->isInlineStruct(mVectorType))
+    {
+        // offsets relative to the start of the struct, only the top level fields are offered
+        const auto& fields = config->isPointer(mVectorType) ? config->typeFieldsOfPointer(mVectorType) : config->typeFieldsOfInlineStruct(mVectorType);
+        std::unordered_map<std::string, size_t> offsetsDummy;
+        size_t offset = 0;
+        for (const auto& field : fields)
+        {
+            auto nextOffset = m.setOffsetForField(field, field.name, offset, offsetsDummy);
+            if (MemoryMappedData::isScalarType(field.type) && nextOffset - offset <= sizeof(uint64_t))
+            {
+                mFilterFields.emplace_back(FilterField{field.name, field.type, offset, nextOffset - offset});
+            }
+            offset = nextOffset;
+        }
+    }
+
+    for (const auto& filterField : mFilterFields)
+    {
+        mFilterFieldComboBox->addItem(QString::fromStdString(filterField.name));
+    }
+    mFilterFieldComboBox->setEnabled(!mFilterFields.empty());
+    mFilterValueLineEdit->setEnabled(!mFilterFields.empty());
 }
 
 void S2Plugin::ViewStdVector::initializeRefreshLayout()
@@ -78,44 +174,110 @@ void S2Plugin::ViewStdVector::closeEvent(QCloseEvent* event)
     delete this;
 }
 
+void S2Plugin::ViewStdVector::readContainerBounds()
+{
+    if (mContainerLayout == ContainerLayout::Vector)
+    {
+        mVectorBegin = Script::Memory::ReadQword(mVectorOffset + 8);
+        mVectorCount = Script::Memory::ReadDword(mVectorOffset + 20);
+    }
+    else
+    {
+        mVectorBegin = Script::Memory::ReadQword(mVectorOffset);
+        auto vectorEnd = Script::Memory::ReadQword(mVectorOffset + sizeof(size_t));
+        mVectorCount = (mVectorTypeSize == 0 || vectorEnd < mVectorBegin) ? 0 : (vectorEnd - mVectorBegin) / mVectorTypeSize;
+    }
+}
+
 void S2Plugin::ViewStdVector::refreshVectorContents()
+{
+    readContainerBounds();
+    if (mFilterActive)
+    {
+        applyFilter();
+        return;
+    }
+    populatePage();
+}
+
+S2Plugin::MemoryField S2Plugin::ViewStdVector::elementField(size_t index) const
 {
     auto config = mToolbar->configuration();
+    MemoryField field;
+    field.name = "obj_" + std::to_string(index);
+    if (config->isPointer(mVectorType))
+    {
+        field.type = MemoryFieldType::PointerType;
+        field.jsonName = mVectorType;
+    }
+    else if (config->isInlineStruct(mVectorType))
+    {
+        field.type = MemoryFieldType::InlineStructType;
+        field.jsonName = mVectorType;
+    }
+    else if (config->isBuiltInType(mVectorType))
+    {
+        field.type = gsJSONStringToMemoryFieldTypeMapping.at(mVectorType);
+    }
+    else
+    {
+        dprintf("%s is UNKNOWN\n", mVectorType.c_str());
+        field.type = MemoryFieldType::Skip;
+    }
+    return field;
+}
+
+size_t S2Plugin::ViewStdVector::visibleCount() const noexcept
+{
+    return mFilterActive ? mFilteredIndices.size() : mVectorCount;
+}
+
+size_t S2Plugin::ViewStdVector::indexAtPosition(size_t position) const
+{
+    return mFilterActive ? mFilteredIndices.at(position) : position;
+}
+
+void S2Plugin::ViewStdVector::populatePage()
+{
+    auto count = visibleCount();
+    auto maxPageStart = count > msPageSize ? count - msPageSize : 0;
+    mPageStart = (std::min)(mPageStart, maxPageStart);
+
+    mPageScrollBar->blockSignals(true);
+    mPageScrollBar->setMaximum(static_cast<int>(maxPageStart));
+    mPageScrollBar->setValue(static_cast<int>(mPageStart));
+    mPageScrollBar->blockSignals(false);
+
     mMainTreeView->clear();
     mMemoryFields.clear();
+    mMemoryFieldIndices.clear();
 
-    mVectorBegin = Script::Memory::ReadQword(mVectorOffset);
-    auto vectorEnd = Script::Memory::ReadQword(mVectorOffset + sizeof(size_t));
-    auto vectorItemCount = (vectorEnd - mVectorBegin) / mVectorTypeSize;
-
-    for (auto x = 0; x < vectorItemCount; ++x)
+    auto pageEnd = (std::min)(mPageStart + msPageSize, count);
+    mMainTreeView->beginBatchUpdate();
+    for (auto position = mPageStart; position < pageEnd; ++position)
     {
-        MemoryField field;
-        field.name = "obj_" + std::to_string(x);
-        if (config->isPointer(mVectorType))
-        {
-            field.type = MemoryFieldType::PointerType;
-            field.jsonName = mVectorType;
-        }
-        else if (config->isInlineStruct(mVectorType))
-        {
-            field.type = MemoryFieldType::InlineStructType;
-            field.jsonName = mVectorType;
-        }
-        else if (config->isBuiltInType(mVectorType))
-        {
-            field.type = gsJSONStringToMemoryFieldTypeMapping.at(mVectorType);
-        }
-        else
-        {
-            dprintf("%s is UNKNOWN\n", mVectorType.c_str());
-            // not implemented
-        }
+        auto index = indexAtPosition(position);
+        auto field = elementField(index);
         mMemoryFields.emplace_back(field);
+        mMemoryFieldIndices.emplace_back(index);
         mMainTreeView->addMemoryField(field, field.name);
     }
+    mMainTreeView->endBatchUpdate();
     refreshData();
 
+    if (count == 0)
+    {
+        mPageLabel->setText(mFilterActive ? QString("No matches (%1 elements)").arg(mVectorCount) : QString("Empty"));
+    }
+    else if (mFilterActive)
+    {
+        mPageLabel->setText(QString("Showing matches %1-%2 of %3 (%4 elements)").arg(mPageStart).arg(pageEnd - 1).arg(count).arg(mVectorCount));
+    }
+    else
+    {
+        mPageLabel->setText(QString("Showing %1-%2 of %3").arg(mPageStart).arg(pageEnd - 1).arg(count));
+    }
+
     mMainTreeView->updateTableHeader();
     mMainTreeView->setColumnHidden(gsColComparisonValue, true);
     mMainTreeView->setColumnHidden(gsColComparisonValueHex, true);
@@ -129,16 +291,131 @@ void S2Plugin::ViewStdVector::refreshVectorContents()
 
 void S2Plugin::ViewStdVector::refreshData()
 {
-    size_t counter = 0;
     std::unordered_map<std::string, size_t> offsets;
     auto m = MemoryMappedData(mToolbar->configuration());
 
-    for (const auto& field : mMemoryFields)
+    mMainTreeView->beginBatchUpdate();
+    for (auto x = 0; x < mMemoryFields.size(); ++x)
     {
-        m.setOffsetForField(field, field.name, mVectorBegin + (counter++ * mVectorTypeSize), offsets);
+        const auto& field = mMemoryFields.at(x);
+        m.setOffsetForField(field, field.name, mVectorBegin + (mMemoryFieldIndices.at(x) * mVectorTypeSize), offsets);
 
         mMainTreeView->updateValueForField(field, field.name, offsets);
     }
+    mMainTreeView->endBatchUpdate();
+}
+
+void S2Plugin::ViewStdVector::pageScrolled(int position)
+{
+    mPageStart = static_cast<size_t>(position);
+    populatePage();
+}
+
+void S2Plugin::ViewStdVector::jumpToIndex()
+{
+    bool ok = false;
+    auto index = mJumpToIndexLineEdit->text().toULongLong(&ok);
+    if (!ok)
+    {
+        return;
+    }
+
+    if (mFilterActive)
+    {
+        // first match at or after the requested index
+        auto it = std::lower_bound(mFilteredIndices.begin(), mFilteredIndices.end(), index);
+        mPageStart = std::distance(mFilteredIndices.begin(), it);
+    }
+    else
+    {
+        mPageStart = index;
+    }
+    populatePage();
+}
+
+void S2Plugin::ViewStdVector::applyFilter()
+{
+    auto filterFieldIndex = mFilterFieldComboBox->currentIndex();
+    if (filterFieldIndex < 0 || filterFieldIndex >= mFilterFields.size() || mFilterValueLineEdit->text().isEmpty())
+    {
+        return;
+    }
+    const auto& filterField = mFilterFields.at(filterFieldIndex);
+
+    // the filter value is compared bytewise against the field, so convert it to the in-memory representation
+    uint64_t needle = 0;
+    bool ok = false;
+    if (filterField.type == MemoryFieldType::Float)
+    {
+        auto f = mFilterValueLineEdit->text().toFloat(&ok);
+        std::memcpy(&needle, &f, sizeof(float));
+    }
+    else
+    {
+        needle = static_cast<uint64_t>(mFilterValueLineEdit->text().toLongLong(&ok, 0));
+        if (!ok)
+        {
+            needle = mFilterValueLineEdit->text().toULongLong(&ok, 0);
+        }
+    }
+    if (!ok)
+    {
+        mPageLabel->setText("Invalid filter value");
+        return;
+    }
+
+    readContainerBounds();
+    mFilteredIndices.clear();
+
+    // read the element array in chunks instead of one read per element
+    auto isPointerElement = mToolbar->configuration()->isPointer(mVectorType);
+    const size_t chunkElementCount = 4096;
+    std::vector<uint8_t> chunk;
+    for (size_t chunkStart = 0; chunkStart < mVectorCount; chunkStart += chunkElementCount)
+    {
+        auto elementsInChunk = (std::min)(chunkElementCount, mVectorCount - chunkStart);
+        chunk.resize(elementsInChunk * mVectorTypeSize);
+        if (!Script::Memory::Read(mVectorBegin + chunkStart * mVectorTypeSize, chunk.data(), chunk.size(), nullptr))
+        {
+            break;
+        }
+        for (size_t x = 0; x < elementsInChunk; ++x)
+        {
+            uint64_t value = 0;
+            auto element = chunk.data() + x * mVectorTypeSize;
+            if (isPointerElement)
+            {
+                size_t pointer = 0;
+                std::memcpy(&pointer, element, sizeof(size_t));
+                if (pointer == 0 || !Script::Memory::Read(pointer + filterField.offset, &value, filterField.size, nullptr))
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                std::memcpy(&value, element + filterField.offset, filterField.size);
+            }
+            if (std::memcmp(&value, &needle, filterField.size) == 0)
+            {
+                mFilteredIndices.emplace_back(chunkStart + x);
+            }
+        }
+    }
+
+    mFilterActive = true;
+    mPageStart = 0;
+    populatePage();
+}
+
+void S2Plugin::ViewStdVector::clearFilter()
+{
+    auto firstVisibleIndex = (mFilterActive && mPageStart < mFilteredIndices.size()) ? mFilteredIndices.at(mPageStart) : mPageStart;
+    mFilterActive = false;
+    mFilteredIndices.clear();
+    mPageStart = firstVisibleIndex;
+    readContainerBounds();
+    populatePage();
 }
 
 QSize S2Plugin::ViewStdVector::sizeHint() const
@@ -211,10 +211,12 @@ void S2Plugin::ViewTextureDB::showID(size_t id)
     mLookupID = id;
     auto& offsets = mToolbar->textureDB()->offsetsForTextureID(mLookupID);
     auto deltaReference = offsets.at("TextureDB.id");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::TextureDB))
     {
         mMainTreeView->updateValueForField(field, "TextureDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewTextureDB::label()
@@ -240,10 +242,12 @@ void S2Plugin::ViewTextureDB::updateFieldValues()
 {
     auto& offsets = mToolbar->textureDB()->offsetsForTextureID(mLookupID);
     auto deltaReference = offsets.at("TextureDB.id");
+    mMainTreeView->beginBatchUpdate();
     for (const auto& field : mToolbar->configuration()->typeFields(MemoryFieldType::TextureDB))
     {
         mMainTreeView->updateValueForField(field, "TextureDB." + field.name, offsets, deltaReference);
     }
+    mMainTreeView->endBatchUpdate();
 }
 
 void S2Plugin::ViewTextureDB::compareGroupByCheckBoxClicked(int state)
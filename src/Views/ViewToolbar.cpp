@@ -2,6 +2,7 @@
 #include "Configuration.h"
 #include "Data/CharacterDB.h"
 #include "Data/EntityDB.h"
+#include "Data/FrameClock.h"
 #include "Data/GameManager.h"
 #include "Data/LevelGen.h"
 #include "Data/Online.h"
@@ -12,10 +13,14 @@
 #include "Data/TextureDB.h"
 #include "Data/VirtualTableLookup.h"
 #include "Spelunky2.h"
+#include "Views/ViewBreakpointCapture.h"
 #include "Views/ViewCharacterDB.h"
+#include "Views/ViewDatabaseExport.h"
 #include "Views/ViewEntities.h"
 #include "Views/ViewEntity.h"
 #include "Views/ViewEntityDB.h"
+#include "Views/ViewEntityGrid.h"
+#include "Views/ViewEntityWatch.h"
 #include "Views/ViewGameManager.h"
 #include "Views/ViewJournalPage.h"
 #include "Views/ViewLevelGen.h"
@@ -41,6 +46,7 @@ S2Plugin::ViewToolbar::ViewToolbar(EntityDB* entityDB, ParticleDB* particleDB, T
       mLevelGen(levelGen), mVirtualTableLookup(vtl), mStringsTable(stbl), mOnline(online), mConfiguration(config), mMDIArea(mdiArea)
 {
     setFeatures(QDockWidget::NoDockWidgetFeatures);
+    mFrameClock = new FrameClock(mState, this);
 
     mMainLayout = new QVBoxLayout(this);
     auto container = new QWidget(this);
@@ -74,6 +80,11 @@ S2Plugin::ViewToolbar::ViewToolbar(EntityDB* entityDB, ParticleDB* particleDB, T
     mMainLayout->addWidget(btnCharacterDB);
     QObject::connect(btnCharacterDB, &QPushButton::clicked, this, &ViewToolbar::showCharacterDB);
 
+    auto btnDatabaseExport = new QPushButton(this);
+    btnDatabaseExport->setText("Export DBs");
+    mMainLayout->addWidget(btnDatabaseExport);
+    QObject::connect(btnDatabaseExport, &QPushButton::clicked, this, &ViewToolbar::showDatabaseExport);
+
     auto divider = new QFrame(this);
     divider->setFrameShape(QFrame::HLine);
     divider->setFrameShadow(QFrame::Sunken);
@@ -89,6 +100,21 @@ S2Plugin::ViewToolbar::ViewToolbar(EntityDB* entityDB, ParticleDB* particleDB, T
     mMainLayout->addWidget(btnEntities);
     QObject::connect(btnEntities, &QPushButton::clicked, this, &ViewToolbar::showEntities);
 
+    auto btnEntityGrid = new QPushButton(this);
+    btnEntityGrid->setText("Entity grid");
+    mMainLayout->addWidget(btnEntityGrid);
+    QObject::connect(btnEntityGrid, &QPushButton::clicked, this, &ViewToolbar::showEntityGrid);
+
+    auto btnEntityWatch = new QPushButton(this);
+    btnEntityWatch->setText("Entity watch");
+    mMainLayout->addWidget(btnEntityWatch);
+    QObject::connect(btnEntityWatch, &QPushButton::clicked, this, &ViewToolbar::showEntityWatch);
+
+    auto btnBreakpointCapture = new QPushButton(this);
+    btnBreakpointCapture->setText("Breakpoint capture");
+    mMainLayout->addWidget(btnBreakpointCapture);
+    QObject::connect(btnBreakpointCapture, &QPushButton::clicked, this, &ViewToolbar::showBreakpointCapture);
+
     auto btnLevelGen = new QPushButton(this);
     btnLevelGen->setText("LevelGen");
     mMainLayout->addWidget(btnLevelGen);
@@ -274,6 +300,44 @@ void S2Plugin::ViewToolbar::showEntities()
     }
 }
 
+void S2Plugin::ViewToolbar::showEntityGrid()
+{
+    if (mState->loadState() && mEntityDB->loadEntityDB())
+    {
+        auto w = new ViewEntityGrid(this);
+        mMDIArea->addSubWindow(w);
+        w->setVisible(true);
+    }
+}
+
+void S2Plugin::ViewToolbar::showEntityWatch()
+{
+    if (mState->loadState() && mEntityDB->loadEntityDB())
+    {
+        auto w = new ViewEntityWatch(this);
+        mMDIArea->addSubWindow(w);
+        w->setVisible(true);
+    }
+}
+
+void S2Plugin::ViewToolbar::showDatabaseExport()
+{
+    // the databases are loaded when exporting
+    auto w = new ViewDatabaseExport(this);
+    mMDIArea->addSubWindow(w);
+    w->setVisible(true);
+}
+
+void S2Plugin::ViewToolbar::showBreakpointCapture()
+{
+    if (mState->loadState() && mEntityDB->loadEntityDB())
+    {
+        auto w = new ViewBreakpointCapture(this);
+        mMDIArea->addSubWindow(w);
+        w->setVisible(true);
+    }
+}
+
 void S2Plugin::ViewToolbar::showSaveGame()
 {
     if (mSaveGame->loadSaveGame())
@@ -300,7 +364,14 @@ void S2Plugin::ViewToolbar::showVirtualFunctions(size_t offset, const std::strin
 
 void S2Plugin::ViewToolbar::showStdVector(size_t offset, const std::string& typeName)
 {
-    auto w = new ViewStdVector(this, typeName, offset, this);
+    auto w = new ViewStdVector(this, typeName, offset, ViewStdVector::ContainerLayout::StdVector, this);
+    mMDIArea->addSubWindow(w);
+    w->setVisible(true);
+}
+
+void S2Plugin::ViewToolbar::showVector(size_t offset)
+{
+    auto w = new ViewStdVector(this, "EntityUID", offset, ViewStdVector::ContainerLayout::Vector, this);
     mMDIArea->addSubWindow(w);
     w->setVisible(true);
 }
@@ -416,6 +487,11 @@ S2Plugin::Configuration* S2Plugin::ViewToolbar::configuration() const noexcept
     return mConfiguration;
 }
 
+S2Plugin::FrameClock* S2Plugin::ViewToolbar::frameClock() const noexcept
+{
+    return mFrameClock;
+}
+
 void S2Plugin::ViewToolbar::reloadConfig()
 {
     auto windows = mMDIArea->subWindowList();
@@ -426,6 +502,7 @@ void S2Plugin::ViewToolbar::reloadConfig()
             window->close();
         }
     }
+    mFrameClock->reset();
     mConfiguration->load();
     if (!mConfiguration->isValid())
     {
@@ -445,6 +522,7 @@ void S2Plugin::ViewToolbar::reloadConfig()
 void S2Plugin::ViewToolbar::resetSpelunky2Data()
 {
     mMDIArea->closeAllSubWindows();
+    mFrameClock->reset();
     mState->reset();
     mGameManager->reset();
     mSaveGame->reset();
@@ -1,5 +1,6 @@
 #include "pluginmain.h"
 #include "QtPlugin.h"
+#include "Data/BreakpointCapture.h"
 
 int S2Plugin::handle;
 HWND S2Plugin::hwndDlg;
@@ -15,11 +16,14 @@ PLUG_EXPORT bool pluginit(PLUG_INITSTRUCT* initStruct)
     strncpy_s(initStruct->pluginName, PLUGIN_NAME, _TRUNCATE);
     S2Plugin::handle = initStruct->pluginHandle;
     QtPlugin::Init();
+    // run by the breakpoints of a breakpoint capture, see BreakpointCapture
+    _plugin_registercommand(S2Plugin::handle, S2Plugin::BreakpointCapture::msCommandName, S2Plugin::BreakpointCapture::captureCommand, true);
     return true;
 }
 
 PLUG_EXPORT bool plugstop()
 {
+    _plugin_unregistercommand(S2Plugin::handle, S2Plugin::BreakpointCapture::msCommandName);
     GuiExecuteOnGuiThread(QtPlugin::Stop);
     QtPlugin::WaitForStop();
     return true;
@@ -0,0 +1,30 @@
+// Compares two database exports made with the plugin, without needing x64dbg or the game:
+//   S2DBDiff before.s2db after.s2db [max changed entries]
+#include "Data/DatabaseExport.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s before.s2db after.s2db [max changed entries]\n", argv[0]);
+        return 2;
+    }
+    S2Plugin::DatabaseExport before;
+    S2Plugin::DatabaseExport after;
+    std::string error;
+    if (!before.load(argv[1], error) || !after.load(argv[2], error))
+    {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+    size_t maxChangedEntries = argc > 3 ? strtoull(argv[3], nullptr, 10) : 1000;
+    auto report = S2Plugin::diffDatabaseExports(before, after, maxChangedEntries);
+    for (const auto& line : report)
+    {
+        printf("%s\n", line.c_str());
+    }
+    // like diff: 0 if identical (the report is only the "0 of N entries changed" line), 1 if there are differences
+    return report.size() == 1 && report[0].rfind("0 of ", 0) == 0 ? 0 : 1;
+}